@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+//===================================================================//
+// Fence-recycled pool, backend-neutral (TEntry is whatever the backend
+// hands out: allocator/list pair, etc.).
+//  Acquire -> record -> Submitted(fence) -> [fence passes] -> reusable
+// Thread-safe: any recording thread may acquire; the submitting thread
+// tags entries with the fence value of their submission.
+//===================================================================//
+
+struct CommandPoolStats
+{
+	size_t created = 0;				// entries ever created (== live entries, never destroyed until Clear)
+	size_t free = 0;				// ready for reuse
+	size_t inFlight = 0;			// handed out: recording or executing
+	size_t inFlightHighWater = 0;
+	size_t createdHighWater = 0;	// allocator high-water mark (each keeps its memory until reset)
+};
+
+template<typename TEntry>
+class FencedCommandPool
+{
+public:
+	// Moves every submitted entry whose fence passed back to the free list.
+	void Retire(uint64_t completedValue)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		RetireLocked(completedValue);
+	}
+
+	// Pops a reusable entry. false -> caller creates a new one and calls OnCreated.
+	bool TryAcquire(uint64_t completedValue, TEntry& out)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		RetireLocked(completedValue);
+		if (m_Free.empty())
+		{
+			return false;
+		}
+
+		out = std::move(m_Free.back());
+		m_Free.pop_back();
+		MarkAcquiredLocked();
+		return true;
+	}
+
+	void OnCreated()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		++m_Stats.created;
+		if (m_Stats.created > m_Stats.createdHighWater)
+		{
+			m_Stats.createdHighWater = m_Stats.created;
+		}
+		MarkAcquiredLocked();
+	}
+
+	// Entry was executed; reusable once the fence reaches fenceValue.
+	void Submitted(TEntry entry, uint64_t fenceValue)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Pending.emplace_back(fenceValue, std::move(entry));
+	}
+
+	// Entry was never executed; reusable right away.
+	void Discard(TEntry entry)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Free.push_back(std::move(entry));
+		--m_Stats.inFlight;
+	}
+
+	// Only once the device is idle. Returns every entry so the caller can destroy them.
+	std::vector<TEntry> Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		std::vector<TEntry> all = std::move(m_Free);
+		for (auto& pending : m_Pending)
+		{
+			all.push_back(std::move(pending.second));
+		}
+		m_Free.clear();
+		m_Pending.clear();
+
+		const size_t highWater = m_Stats.createdHighWater;
+		const size_t inFlightHighWater = m_Stats.inFlightHighWater;
+		m_Stats = {};
+		m_Stats.createdHighWater = highWater;
+		m_Stats.inFlightHighWater = inFlightHighWater;
+		return all;
+	}
+
+	CommandPoolStats GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		CommandPoolStats stats = m_Stats;
+		stats.free = m_Free.size();
+		return stats;
+	}
+
+private:
+	void RetireLocked(uint64_t completedValue)
+	{
+		// Submissions are tagged in fence order, so the front retires first
+		while (!m_Pending.empty() && m_Pending.front().first <= completedValue)
+		{
+			m_Free.push_back(std::move(m_Pending.front().second));
+			m_Pending.pop_front();
+			--m_Stats.inFlight;
+		}
+	}
+
+	void MarkAcquiredLocked()
+	{
+		++m_Stats.inFlight;
+		if (m_Stats.inFlight > m_Stats.inFlightHighWater)
+		{
+			m_Stats.inFlightHighWater = m_Stats.inFlight;
+		}
+	}
+
+private:
+	mutable std::mutex m_Mutex;
+	std::vector<TEntry> m_Free;
+	std::deque<std::pair<uint64_t, TEntry>> m_Pending;
+	CommandPoolStats m_Stats;
+};
@@ -1,5 +1,27 @@
 #include "DXContext.h"
+#include "Support/Window.h"
+#include "d3dx12.h"
 #include <iostream>
+#include <functional>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+	constexpr UINT64 kFrameUploadBytes = 256 * 1024;
+	constexpr UINT64 kUploadRingBytes = 32 * 1024 * 1024;
+	constexpr UINT64 kUploadAlign = 16;
+
+	// FrameResourceRing fence adapter
+	struct FrameFence
+	{
+		ID3D12Fence* fence;
+		std::function<void(UINT64)> wait;
+
+		uint64_t GetCompletedValue() const { return fence->GetCompletedValue(); }
+		void WaitForValue(uint64_t value) { wait(value); }
+	};
+}
 
 bool DXContext::Init()
 {
@@ -48,35 +70,296 @@ bool DXContext::Init()
 		return false;
 	}
 
-	// 5. Create a command allocator
-	hr = m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_cmdAllocator));
+	// 5. Warm the command pool with one allocator/list pair
+	CommandContext* ctx = CreateCommandContext(D3D12_COMMAND_LIST_TYPE_DIRECT);
+	if (ctx == nullptr)
+	{
+		return false;
+	}
+	m_cmdPool.OnCreated();
+	m_cmdPool.Discard(ctx);
+
+	// 6. Per-frame upload space
+	if (InitFrameContexts() == false)
+	{
+		return false;
+	}
+
+	// 7. Copy queue + fence for asset uploads
+	if (InitCopyQueue() == false)
+	{
+		return false;
+	}
+
+	// 8. Upload ring for batched resource uploads
+	if (InitUploadRing() == false)
+	{
+		return false;
+	}
+
+	// 9. Compute queue + fence for inference
+	if (InitInferenceQueue() == false)
+	{
+		return false;
+	}
+
+	// 10. Compute queue + fence for pre/postprocess (async compute)
+	if (InitComputeQueue() == false)
+	{
+		return false;
+	}
+
+	// 11. Per-queue GPU timestamps (optional)
+	InitTimers();
+
+	return true;
+}
+
+bool DXContext::InitCopyQueue()
+{
+	D3D12_COMMAND_QUEUE_DESC desc = {};
+	desc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+	desc.NodeMask = 0;
+	desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+	HRESULT hr = m_device->CreateCommandQueue(&desc, IID_PPV_ARGS(&m_copyQueue));
 	if (FAILED(hr))
 	{
-		std::cerr << "Failed to create command allocator. " << hr << std::endl;
+		std::cerr << "Failed to create copy queue. " << hr << std::endl;
 		return false;
 	}
 
-	// 6. Create a command list
-	hr = m_device->CreateCommandList1(0, D3D12_COMMAND_LIST_TYPE_DIRECT, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&m_cmdList));
+	hr = m_device->CreateFence(m_copyFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_copyFence));
 	if (FAILED(hr))
 	{
-		std::cerr << "Failed to create command list. " << hr << std::endl;
+		std::cerr << "Failed to create copy fence. " << hr << std::endl;
+		return false;
+	}
+
+	m_copyFenceEvent = CreateEvent(nullptr, false, false, nullptr);
+	if (m_copyFenceEvent == nullptr)
+	{
+		std::cerr << "Failed to create copy fence event." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool DXContext::InitInferenceQueue()
+{
+	D3D12_COMMAND_QUEUE_DESC desc = {};
+	desc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+	desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+	desc.NodeMask = 0;
+	desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+	HRESULT hr = m_device->CreateCommandQueue(&desc, IID_PPV_ARGS(&m_inferQueue));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to create inference queue. " << hr << std::endl;
+		return false;
+	}
+
+	hr = m_device->CreateFence(m_inferFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_inferFence));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to create inference fence. " << hr << std::endl;
 		return false;
 	}
 
+	m_inferFenceEvent = CreateEvent(nullptr, false, false, nullptr);
+	if (m_inferFenceEvent == nullptr)
+	{
+		std::cerr << "Failed to create inference fence event." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool DXContext::InitComputeQueue()
+{
+	D3D12_COMMAND_QUEUE_DESC desc = {};
+	desc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+	desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+	desc.NodeMask = 0;
+	desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+
+	HRESULT hr = m_device->CreateCommandQueue(&desc, IID_PPV_ARGS(&m_computeQueue));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to create compute queue. " << hr << std::endl;
+		return false;
+	}
+
+	hr = m_device->CreateFence(m_computeFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_computeFence));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to create compute fence. " << hr << std::endl;
+		return false;
+	}
+
+	m_computeFenceEvent = CreateEvent(nullptr, false, false, nullptr);
+	if (m_computeFenceEvent == nullptr)
+	{
+		std::cerr << "Failed to create compute fence event." << std::endl;
+		return false;
+	}
+	return true;
+}
 
+void DXContext::InitTimers()
+{
+	// Timing is diagnostics only: a queue without timestamps just reports nothing
+	m_directTimer.Init(m_device, m_cmdQueue, D3D12_COMMAND_LIST_TYPE_DIRECT);
+	m_computeTimer.Init(m_device, m_computeQueue, D3D12_COMMAND_LIST_TYPE_COMPUTE);
+	m_inferTimer.Init(m_device, m_inferQueue, D3D12_COMMAND_LIST_TYPE_COMPUTE);
+}
+
+bool DXContext::InitUploadRing()
+{
+	CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(kUploadRingBytes);
+	HRESULT hr = m_device->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &desc,
+		D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&m_uploadBuffer));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to create upload ring. " << hr << std::endl;
+		return false;
+	}
 
+	D3D12_RANGE noRead{ 0, 0 };
+	hr = m_uploadBuffer->Map(0, &noRead, reinterpret_cast<void**>(&m_uploadBufferCPU));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to map upload ring. " << hr << std::endl;
+		return false;
+	}
+	m_uploadRing.Reset(kUploadRingBytes);
 	return true;
 }
 
+bool DXContext::InitFrameContexts()
+{
+	m_frames.Resize(DXWindow::GetFrameCount());
+	m_queuedFrames = (UINT)m_frames.GetCount();
+	m_frameSignals.clear();
+
+	bool ok = true;
+	m_frames.ForEach([&](FrameContext& frame)
+		{
+			if (ok == false)
+			{
+				return;
+			}
+
+			CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_UPLOAD);
+			CD3DX12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(kFrameUploadBytes);
+			HRESULT hr = m_device->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &desc,
+				D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&frame.upload));
+			if (FAILED(hr))
+			{
+				std::cerr << "Failed to create frame upload buffer. " << hr << std::endl;
+				ok = false;
+				return;
+			}
+
+			// Upload heap stays mapped for the lifetime of the buffer
+			D3D12_RANGE noRead{ 0, 0 };
+			hr = frame.upload->Map(0, &noRead, reinterpret_cast<void**>(&frame.uploadCPU));
+			if (FAILED(hr))
+			{
+				std::cerr << "Failed to map frame upload buffer. " << hr << std::endl;
+				ok = false;
+				return;
+			}
+			frame.uploadCursor.Reset(kFrameUploadBytes);
+		});
+
+	return ok;
+}
+
+DXContext::CommandContext* DXContext::CreateCommandContext(D3D12_COMMAND_LIST_TYPE type)
+{
+	auto ctx = std::make_unique<CommandContext>();
+	ctx->type = type;
+
+	HRESULT hr = m_device->CreateCommandAllocator(type, IID_PPV_ARGS(&ctx->allocator));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to create command allocator. " << hr << std::endl;
+		return nullptr;
+	}
+
+	// CreateCommandList1: created closed, no allocator bound yet
+	hr = m_device->CreateCommandList1(0, type, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&ctx->list));
+	if (FAILED(hr))
+	{
+		std::cerr << "Failed to create command list. " << hr << std::endl;
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(m_cmdContextMutex);
+	m_cmdContexts.push_back(std::move(ctx));
+	return m_cmdContexts.back().get();
+}
+
 
 void DXContext::Shutdown()
 {
-	m_cmdList.Release();
-	m_cmdList = nullptr;
+	if (m_copyQueue && m_copyFence)
+	{
+		if (m_uploadBatch != nullptr)
+		{
+			DiscardCommandContext(m_uploadBatch);
+			m_uploadBatch = nullptr;
+		}
+		m_uploadBatchOpen = false;
+		m_copyQueue->Signal(m_copyFence, ++m_copyFenceValue);
+		WaitForCopyFenceValue(m_copyFenceValue);
+	}
+	if (m_cmdQueue && m_fence)
+	{
+		SignalAndWait();
+	}
+	m_deferred.RetireAll();
+	m_copyDeferred.RetireAll();
 
-	m_cmdAllocator.Release();
-	m_cmdAllocator = nullptr;
+	m_directTimer.Shutdown();
+	m_computeTimer.Shutdown();
+	m_inferTimer.Shutdown();
+
+	m_uploadOversized.clear();
+	if (m_uploadBuffer && m_uploadBufferCPU != nullptr)
+	{
+		m_uploadBuffer->Unmap(0, nullptr);
+	}
+	m_uploadBufferCPU = nullptr;
+	m_uploadBuffer.Release();
+	m_uploadRing.Reset(0);
+
+	m_frames.ForEach([](FrameContext& frame)
+		{
+			if (frame.upload && frame.uploadCPU != nullptr)
+			{
+				frame.upload->Unmap(0, nullptr);
+			}
+			frame.uploadCPU = nullptr;
+			frame.upload.Release();
+		});
+	m_frames.Clear();
+	m_inFrame = false;
+	m_frameSignals.clear();
+
+	m_current = nullptr;
+	m_chained.clear();
+	m_cmdPool.Clear();
+	m_copyPool.Clear();
+	m_computePool.Clear();
+	{
+		std::lock_guard<std::mutex> lock(m_cmdContextMutex);
+		m_cmdContexts.clear();
+	}
 
 	if (m_fenceEvent != nullptr)
 	{
@@ -86,6 +369,36 @@ void DXContext::Shutdown()
 	m_fence.Release();
 	m_fence = nullptr;
 
+	if (m_copyFenceEvent != nullptr)
+	{
+		CloseHandle(m_copyFenceEvent);
+	}
+	m_copyFenceEvent = nullptr;
+	m_copyFence.Release();
+	m_copyQueue.Release();
+	m_copyWaitValue.store(0);
+	m_copyWaitIssued = 0;
+
+	if (m_inferFenceEvent != nullptr)
+	{
+		CloseHandle(m_inferFenceEvent);
+	}
+	m_inferFenceEvent = nullptr;
+	m_inferFence.Release();
+	m_inferQueue.Release();
+	m_inferFenceValue = 0;
+	m_inferWaitIssued = 0;
+
+	if (m_computeFenceEvent != nullptr)
+	{
+		CloseHandle(m_computeFenceEvent);
+	}
+	m_computeFenceEvent = nullptr;
+	m_computeFence.Release();
+	m_computeQueue.Release();
+	m_computeFenceValue = 0;
+	m_computeWaitIssued = 0;
+
 	m_cmdQueue.Release();
 	m_cmdQueue = nullptr;
 
@@ -98,39 +411,683 @@ void DXContext::Shutdown()
 
 void DXContext::SignalAndWait()
 {
+	// Submitted uploads, inference and compute work still queued (ahead of the frame that
+	// displays it) must finish as well
+	if (m_copyFence && m_copyFence->GetCompletedValue() < m_copyFenceValue)
+	{
+		WaitForFence(m_copyFence, m_copyFenceEvent, m_copyFenceValue);
+	}
+	if (m_inferFence && m_inferFence->GetCompletedValue() < m_inferFenceValue)
+	{
+		WaitForFence(m_inferFence, m_inferFenceEvent, m_inferFenceValue);
+	}
+	if (m_computeFence && m_computeFence->GetCompletedValue() < m_computeFenceValue)
+	{
+		WaitForFence(m_computeFence, m_computeFenceEvent, m_computeFenceValue);
+	}
+	WaitForFenceValue(Signal());
+}
+
+UINT64 DXContext::Signal()
+{
+	std::lock_guard<std::mutex> lock(m_submitMutex);
 	m_cmdQueue->Signal(m_fence, ++m_fenceValue);
-	if (SUCCEEDED(m_fence->SetEventOnCompletion(m_fenceValue, m_fenceEvent)))
+	return m_fenceValue;
+}
+
+void DXContext::WaitForFenceValue(UINT64 value)
+{
+	WaitForFence(m_fence, m_fenceEvent, value);
+	ProcessCompletions();
+}
+
+void DXContext::WaitForCopyFenceValue(UINT64 value)
+{
+	WaitForFence(m_copyFence, m_copyFenceEvent, value);
+	ProcessCompletions();
+}
+
+void DXContext::WaitForFence(ID3D12Fence* fence, HANDLE event, UINT64 value)
+{
+	if (fence->GetCompletedValue() < value)
 	{
-		if (WaitForSingleObject(m_fenceEvent, 20000) != WAIT_OBJECT_0)
+		if (FAILED(fence->SetEventOnCompletion(value, event)))
 		{
+			std::cerr << "SetEventOnCompletion failed." << std::endl;
 			std::exit(EXIT_FAILURE);
 		}
+
+		// A slow GPU is not an error; only bail out once the device is actually gone
+		while (WaitForSingleObject(event, 20000) != WAIT_OBJECT_0)
+		{
+			HRESULT reason = m_device->GetDeviceRemovedReason();
+			if (FAILED(reason))
+			{
+				std::cerr << "Device removed while waiting for fence. " << reason << std::endl;
+				std::exit(EXIT_FAILURE);
+			}
+			OutputDebugStringA("[DXContext] fence wait exceeded 20s, still waiting\n");
+		}
 	}
-	else
+}
+
+DXContext::CommandContext* DXContext::AcquireCommandContext()
+{
+	return AcquireFromPool(D3D12_COMMAND_LIST_TYPE_DIRECT);
+}
+
+FencedCommandPool<DXContext::CommandContext*>& DXContext::GetPool(D3D12_COMMAND_LIST_TYPE type)
+{
+	switch (type)
+	{
+	case D3D12_COMMAND_LIST_TYPE_COPY:		return m_copyPool;
+	case D3D12_COMMAND_LIST_TYPE_COMPUTE:	return m_computePool;
+	default:								return m_cmdPool;
+	}
+}
+
+DXContext::CommandContext* DXContext::AcquireFromPool(D3D12_COMMAND_LIST_TYPE type)
+{
+	ID3D12Fence* fence = m_fence.Get();
+	if (type == D3D12_COMMAND_LIST_TYPE_COPY)
+	{
+		fence = m_copyFence.Get();
+	}
+	else if (type == D3D12_COMMAND_LIST_TYPE_COMPUTE)
+	{
+		fence = m_computeFence.Get();
+	}
+	FencedCommandPool<CommandContext*>& pool = GetPool(type);
+
+	CommandContext* ctx = nullptr;
+	if (pool.TryAcquire(fence->GetCompletedValue(), ctx) == false)
+	{
+		ctx = CreateCommandContext(type);
+		if (ctx == nullptr)
+		{
+			return nullptr;
+		}
+		pool.OnCreated();
+	}
+
+	// The fence of this pair's last submission has passed, so the allocator can be reset
+	ctx->allocator->Reset();
+	ctx->list->Reset(ctx->allocator, nullptr);
+	return ctx;
+}
+
+void DXContext::DiscardCommandContext(CommandContext* ctx)
+{
+	if (ctx == nullptr)
+	{
+		return;
+	}
+	ctx->list->Close();
+	GetPool(ctx->type).Discard(ctx);
+}
+
+FenceTicket DXContext::Submit(CommandContext* ctx)
+{
+	return Submit(&ctx, 1);
+}
+
+FenceTicket DXContext::Submit(CommandContext* const* ctxs, UINT count)
+{
+	std::vector<CommandContext*> closed;
+	std::vector<ID3D12CommandList*> lists;
+	closed.reserve(count);
+	lists.reserve(count);
+
+	for (UINT i = 0; i < count; ++i)
+	{
+		CommandContext* ctx = ctxs[i];
+		if (ctx == nullptr)
+		{
+			continue;
+		}
+
+		if (FAILED(ctx->list->Close()))
+		{
+			OutputDebugStringA("[DXContext] command list close failed, dropped\n");
+			GetPool(ctx->type).Discard(ctx);
+			continue;
+		}
+		closed.push_back(ctx);
+		lists.push_back(ctx->list);
+	}
+
+	if (lists.empty())
+	{
+		return {};
+	}
+
+	// Resources uploaded on the copy queue are first used here: make sure their copy list has
+	// been submitted, then let the direct queue wait on the GPU (never for a value nobody signals)
+	UINT64 copyWait = m_copyWaitValue.load(std::memory_order_acquire);
+	if (copyWait > m_copyFenceValue)
 	{
-		std::exit(EXIT_FAILURE);
+		SubmitUploadList();
+		copyWait = std::min<UINT64>(copyWait, m_copyFenceValue);
 	}
 
+	std::lock_guard<std::mutex> lock(m_submitMutex);
+	if (copyWait > m_copyWaitIssued)
+	{
+		if (m_copyFence->GetCompletedValue() < copyWait)
+		{
+			m_cmdQueue->Wait(m_copyFence, copyWait);
+		}
+		m_copyWaitIssued = copyWait;
+	}
+	m_cmdQueue->ExecuteCommandLists((UINT)lists.size(), lists.data());
+	m_cmdQueue->Signal(m_fence, ++m_fenceValue);
+
+	FenceTicket ticket{ m_fenceValue };
+	for (CommandContext* ctx : closed)
+	{
+		m_cmdPool.Submitted(ctx, ticket.value);
+	}
+	m_directTimer.Submitted(ticket.value);
+	return ticket;
 }
 
 ID3D12GraphicsCommandList7* DXContext::InitCommandList()
 {
-	m_cmdAllocator->Reset();
-	m_cmdList->Reset(m_cmdAllocator, nullptr);
+	// Recorded but never submitted: give it back untouched
+	for (CommandContext* ctx : m_chained)
+	{
+		DiscardCommandContext(ctx);
+	}
+	m_chained.clear();
+	if (m_current != nullptr)
+	{
+		DiscardCommandContext(m_current);
+		m_current = nullptr;
+	}
 
-	return m_cmdList;
+	m_current = AcquireCommandContext();
+	return m_current ? m_current->list.Get() : nullptr;
 }
 
 void DXContext::ExecuteCommandList()
 {
-	HRESULT hr = m_cmdList->Close();
-	if (FAILED(hr))
+	WaitFor(Submit());
+}
+
+ID3D12GraphicsCommandList7* DXContext::ChainCommandLists(CommandContext* const* ctxs, UINT count)
+{
+	if (m_current != nullptr)
+	{
+		m_chained.push_back(m_current);
+		m_current = nullptr;
+	}
+	for (UINT i = 0; i < count; ++i)
+	{
+		if (ctxs[i] != nullptr)
+		{
+			m_chained.push_back(ctxs[i]);
+		}
+	}
+
+	m_current = AcquireCommandContext();
+	return m_current ? m_current->list.Get() : nullptr;
+}
+
+FenceTicket DXContext::Submit()
+{
+	std::vector<CommandContext*> ctxs = std::move(m_chained);
+	m_chained.clear();
+	if (m_current != nullptr)
+	{
+		ctxs.push_back(m_current);
+		m_current = nullptr;
+	}
+	return Submit(ctxs.data(), (UINT)ctxs.size());
+}
+
+bool DXContext::IsComplete(FenceTicket ticket)
+{
+	return ticket.IsCompleteAt(m_fence->GetCompletedValue());
+}
+
+void DXContext::WaitFor(FenceTicket ticket)
+{
+	if (ticket.IsValid() == false)
+	{
+		return;
+	}
+	WaitForFenceValue(ticket.value);
+}
+
+void DXContext::OnComplete(FenceTicket ticket, DeferredReleaseQueue::Callback callback)
+{
+	if (ticket.IsValid() == false || IsComplete(ticket))
+	{
+		if (callback)
+		{
+			callback();
+		}
+		return;
+	}
+	m_deferred.Enqueue(ticket, std::move(callback));
+}
+
+void DXContext::DeferRelease(FenceTicket ticket, ComPointer<ID3D12Resource> resource)
+{
+	if (!resource)
+	{
+		return;
+	}
+	// The lambda owns a reference; it drops when the callback is retired
+	OnComplete(ticket, [keepAlive = std::move(resource)]() {});
+}
+
+void DXContext::ProcessCompletions()
+{
+	if (m_deferred.GetPendingCount() != 0)
+	{
+		m_deferred.Retire(m_fence->GetCompletedValue());
+	}
+	if (m_copyDeferred.GetPendingCount() != 0)
+	{
+		m_copyDeferred.Retire(m_copyFence->GetCompletedValue());
+	}
+
+	m_directTimer.Collect(m_fence->GetCompletedValue());
+	if (m_computeFence)
+	{
+		m_computeTimer.Collect(m_computeFence->GetCompletedValue());
+	}
+	if (m_inferFence)
+	{
+		m_inferTimer.Collect(m_inferFence->GetCompletedValue());
+	}
+}
+
+bool DXContext::BeginFrame()
+{
+	if (m_inFrame || m_frames.GetCount() == 0)
+	{
+		return false;
+	}
+
+	ProcessCompletions();
+
+	FrameFence fence{ m_fence, [this](UINT64 v) { WaitForFenceValue(v); } };
+	FrameContext& frame = m_frames.Acquire(fence);
+	// Fewer queued frames than slots: also wait for the frame m_queuedFrames back
+	if (m_queuedFrames > 0 && m_queuedFrames <= m_frameSignals.size())
+	{
+		const UINT64 value = m_frameSignals[m_frameSignals.size() - m_queuedFrames];
+		if (m_fence->GetCompletedValue() < value)
+		{
+			WaitForFenceValue(value);
+		}
+	}
+	// Compute-queue dispatches may still read constants of this slot
+	if (frame.computeFenceValue > m_computeFence->GetCompletedValue())
+	{
+		WaitForFence(m_computeFence, m_computeFenceEvent, frame.computeFenceValue);
+	}
+	frame.uploadCursor.Rewind();
+
+	m_inFrame = true;
+	return true;
+}
+
+void DXContext::EndFrame()
+{
+	if (m_inFrame == false)
 	{
 		return;
 	}
 
-	ID3D12CommandList* lists[] = { m_cmdList };
-	m_cmdQueue->ExecuteCommandLists(1, lists);
+	m_frames.Current().computeFenceValue = m_computeFenceValue;
+	const UINT64 signaled = Signal();
+	m_frames.Retire(signaled);
+	m_inFrame = false;
+
+	m_frameSignals.push_back(signaled);
+	while (m_frameSignals.size() > m_frames.GetCount())
+	{
+		m_frameSignals.pop_front();
+	}
+
+	m_lastFrameUploadBytes = m_frameUploadBytes;
+	m_frameUploadBytes = 0;
+}
+
+void DXContext::SetQueuedFrames(UINT count)
+{
+	m_queuedFrames = std::clamp<UINT>(count, 1, (UINT)std::max<size_t>(m_frames.GetCount(), 1));
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS DXContext::PushFrameConstants(const void* data, UINT size)
+{
+	if (m_inFrame == false)
+	{
+		return 0;
+	}
+
+	FrameContext& frame = m_frames.Current();
+	const UINT64 offset = frame.uploadCursor.Allocate(size, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+	if (offset == FrameLinearAllocator::InvalidOffset)
+	{
+		OutputDebugStringA("[DXContext] frame upload space exhausted\n");
+		return 0;
+	}
+
+	std::memcpy(frame.uploadCPU + offset, data, size);
+	return frame.upload->GetGPUVirtualAddress() + offset;
+}
+
+void DXContext::BeginUploadBatch()
+{
+	m_uploadBatchOpen = true;
+}
+
+FenceTicket DXContext::EndUploadBatch()
+{
+	m_uploadBatchOpen = false;
+	return SubmitUploadList();
+}
+
+FenceTicket DXContext::UploadBuffer(ID3D12Resource* dst, const void* data, UINT64 size)
+{
+	if (dst == nullptr || data == nullptr || size == 0)
+	{
+		return {};
+	}
+
+	// May submit what the batch staged so far when the ring is full
+	UINT64 srcOffset = AllocateUploadSpace(size);
+	ID3D12Resource* src = m_uploadBuffer;
+
+	ID3D12GraphicsCommandList7* list = GetUploadList();
+	if (list == nullptr)
+	{
+		return {};
+	}
+
+	if (srcOffset == UploadRingAllocator::InvalidOffset)
+	{
+		// Larger than the whole ring: one-off upload buffer that lives until the copy completes
+		ComPointer<ID3D12Resource> oversized;
+		CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_UPLOAD);
+		CD3DX12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(size);
+		void* p = nullptr;
+		if (FAILED(m_device->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &desc,
+			D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&oversized))) ||
+			FAILED(oversized->Map(0, nullptr, &p)) || p == nullptr)
+		{
+			OutputDebugStringA("[DXContext] oversized upload buffer failed\n");
+			if (m_uploadBatchOpen == false)
+			{
+				SubmitUploadList();
+			}
+			return {};
+		}
+		std::memcpy(p, data, (size_t)size);
+		oversized->Unmap(0, nullptr);
+
+		src = oversized;
+		srcOffset = 0;
+		m_uploadOversized.push_back(std::move(oversized));
+		++m_uploadOversizedCount;
+	}
+	else
+	{
+		std::memcpy(m_uploadBufferCPU + srcOffset, data, (size_t)size);
+	}
+
+	list->CopyBufferRegion(dst, 0, src, srcOffset, size);
+	CountUploadBytes(size);
+
+	// The open list is signaled with the next copy fence value
+	FenceTicket ticket{ m_copyFenceValue + 1 };
+	if (m_uploadBatchOpen == false)
+	{
+		ticket = SubmitUploadList();
+	}
+	return ticket;
+}
+
+FenceTicket DXContext::RecordUploadCopies(const std::function<void(ID3D12GraphicsCommandList7*)>& record, UINT64 bytes)
+{
+	ID3D12GraphicsCommandList7* list = GetUploadList();
+	if (list == nullptr || !record)
+	{
+		return {};
+	}
+
+	record(list);
+	CountUploadBytes(bytes);
 
-	SignalAndWait();
+	FenceTicket ticket{ m_copyFenceValue + 1 };
+	if (m_uploadBatchOpen == false)
+	{
+		ticket = SubmitUploadList();
+	}
+	return ticket;
+}
+
+void DXContext::WaitForCopy(FenceTicket copyTicket)
+{
+	if (copyTicket.IsValid() == false)
+	{
+		return;
+	}
+
+	UINT64 current = m_copyWaitValue.load(std::memory_order_relaxed);
+	while (current < copyTicket.value &&
+		m_copyWaitValue.compare_exchange_weak(current, copyTicket.value, std::memory_order_release, std::memory_order_relaxed) == false)
+	{
+	}
+}
+
+bool DXContext::IsCopyComplete(FenceTicket copyTicket)
+{
+	return copyTicket.IsCompleteAt(m_copyFence->GetCompletedValue());
+}
+
+ID3D12GraphicsCommandList7* DXContext::GetUploadList()
+{
+	if (m_uploadBatch == nullptr)
+	{
+		m_uploadBatch = AcquireFromPool(D3D12_COMMAND_LIST_TYPE_COPY);
+	}
+	return m_uploadBatch ? m_uploadBatch->list.Get() : nullptr;
+}
+
+void DXContext::CountUploadBytes(UINT64 bytes)
+{
+	m_frameUploadBytes += bytes;
+	m_totalUploadBytes += bytes;
+}
+
+DXContext::UploadStats DXContext::GetUploadStats()
+{
+	UploadStats stats;
+	stats.frameBytes = m_lastFrameUploadBytes;
+	stats.totalBytes = m_totalUploadBytes;
+	stats.submits = m_uploadSubmits;
+	if (m_copyFence)
+	{
+		const UINT64 completed = m_copyFence->GetCompletedValue();
+		stats.copiesInFlight = m_copyFenceValue > completed ? m_copyFenceValue - completed : 0;
+	}
+	stats.ringCapacity = m_uploadRing.GetCapacity();
+	stats.ringHighWater = m_uploadRing.GetHighWater();
+	stats.ringStalls = m_uploadRingStalls;
+	stats.oversized = m_uploadOversizedCount;
+	return stats;
+}
+
+UINT64 DXContext::AllocateUploadSpace(UINT64 size)
+{
+	m_uploadRing.Retire(m_copyFence->GetCompletedValue());
+	UINT64 offset = m_uploadRing.Allocate(size, kUploadAlign);
+	if (offset != UploadRingAllocator::InvalidOffset || size > m_uploadRing.GetCapacity())
+	{
+		return offset;
+	}
+
+	// Ring full: send what this batch staged so far, then wait for the oldest copies to drain
+	if (m_uploadRing.GetOpenBytes() > 0)
+	{
+		SubmitUploadList();
+	}
+
+	while ((offset = m_uploadRing.Allocate(size, kUploadAlign)) == UploadRingAllocator::InvalidOffset)
+	{
+		const UINT64 oldest = m_uploadRing.GetOldestFence();
+		if (oldest == 0)
+		{
+			break;
+		}
+		WaitForCopyFenceValue(oldest);
+		++m_uploadRingStalls;
+		m_uploadRing.Retire(m_copyFence->GetCompletedValue());
+	}
+	return offset;
+}
+
+FenceTicket DXContext::SubmitUploadList()
+{
+	if (m_uploadBatch == nullptr)
+	{
+		return {};
+	}
+
+	CommandContext* ctx = m_uploadBatch;
+	m_uploadBatch = nullptr;
+
+	FenceTicket ticket;
+	if (FAILED(ctx->list->Close()))
+	{
+		OutputDebugStringA("[DXContext] copy list close failed, dropped\n");
+		m_copyPool.Discard(ctx);
+		// Nothing ran: staged ring space is free as soon as the last real copy is
+		ticket.value = m_copyFenceValue;
+	}
+	else
+	{
+		ID3D12CommandList* lists[] = { ctx->list };
+		m_copyQueue->ExecuteCommandLists(1, lists);
+		m_copyQueue->Signal(m_copyFence, ++m_copyFenceValue);
+		ticket.value = m_copyFenceValue;
+		m_copyPool.Submitted(ctx, ticket.value);
+		++m_uploadSubmits;
+	}
+
+	m_uploadRing.Close(ticket.value);
+	for (ComPointer<ID3D12Resource>& oversized : m_uploadOversized)
+	{
+		m_copyDeferred.Enqueue(ticket, [keepAlive = std::move(oversized)]() {});
+	}
+	m_uploadOversized.clear();
+	return ticket;
+}
+
+void DXContext::InferenceWaitFor(FenceTicket directTicket)
+{
+	if (directTicket.IsValid() == false || IsComplete(directTicket))
+	{
+		return;
+	}
+	m_inferQueue->Wait(m_fence, directTicket.value);
+}
+
+FenceTicket DXContext::SignalInference()
+{
+	m_inferQueue->Signal(m_inferFence, ++m_inferFenceValue);
+	m_inferTimer.Submitted(m_inferFenceValue);
+	return FenceTicket{ m_inferFenceValue };
+}
+
+void DXContext::WaitForInference(FenceTicket inferenceTicket)
+{
+	if (inferenceTicket.IsValid() == false || inferenceTicket.value <= m_inferWaitIssued)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_submitMutex);
+	if (IsInferenceComplete(inferenceTicket) == false)
+	{
+		m_cmdQueue->Wait(m_inferFence, inferenceTicket.value);
+	}
+	m_inferWaitIssued = inferenceTicket.value;
+}
+
+bool DXContext::IsInferenceComplete(FenceTicket inferenceTicket)
+{
+	return inferenceTicket.IsCompleteAt(m_inferFence->GetCompletedValue());
+}
+
+DXContext::CommandContext* DXContext::AcquireComputeContext()
+{
+	return AcquireFromPool(D3D12_COMMAND_LIST_TYPE_COMPUTE);
+}
+
+FenceTicket DXContext::SubmitCompute(CommandContext* ctx, FenceTicket directWait, FenceTicket inferenceWait)
+{
+	if (ctx == nullptr)
+	{
+		return {};
+	}
+
+	if (FAILED(ctx->list->Close()))
+	{
+		OutputDebugStringA("[DXContext] compute list close failed, dropped\n");
+		m_computePool.Discard(ctx);
+		return {};
+	}
+
+	if (directWait.IsValid() && IsComplete(directWait) == false)
+	{
+		m_computeQueue->Wait(m_fence, directWait.value);
+	}
+	if (inferenceWait.IsValid() && IsInferenceComplete(inferenceWait) == false)
+	{
+		m_computeQueue->Wait(m_inferFence, inferenceWait.value);
+	}
+
+	ID3D12CommandList* lists[] = { ctx->list };
+	m_computeQueue->ExecuteCommandLists(1, lists);
+	m_computeQueue->Signal(m_computeFence, ++m_computeFenceValue);
+
+	FenceTicket ticket{ m_computeFenceValue };
+	m_computePool.Submitted(ctx, ticket.value);
+	m_computeTimer.Submitted(ticket.value);
+	return ticket;
+}
+
+void DXContext::InferenceWaitForCompute(FenceTicket computeTicket)
+{
+	if (computeTicket.IsValid() == false || IsComputeComplete(computeTicket))
+	{
+		return;
+	}
+	m_inferQueue->Wait(m_computeFence, computeTicket.value);
+}
+
+void DXContext::WaitForCompute(FenceTicket computeTicket)
+{
+	if (computeTicket.IsValid() == false || computeTicket.value <= m_computeWaitIssued)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_submitMutex);
+	if (IsComputeComplete(computeTicket) == false)
+	{
+		m_cmdQueue->Wait(m_computeFence, computeTicket.value);
+	}
+	m_computeWaitIssued = computeTicket.value;
+}
+
+bool DXContext::IsComputeComplete(FenceTicket computeTicket)
+{
+	return computeTicket.IsCompleteAt(m_computeFence->GetCompletedValue());
 }
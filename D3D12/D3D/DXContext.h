@@ -3,6 +3,18 @@
 #include "Support/WinInclude.h"
 #include "Support/ComPointer.h"
 #include "Util/Util.h"
+#include "D3D/FrameResourceRing.h"
+#include "D3D/FenceTicket.h"
+#include "D3D/CommandPool.h"
+#include "D3D/UploadRing.h"
+#include "D3D/GpuTimer.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #define DX_CONTEXT DXContext::Get()
 
@@ -26,10 +38,107 @@ public:
 	bool Init();
 	void Shutdown();
 
+	// Allocator/list pair from the pool. Any thread may acquire one and record into it;
+	// the pair is recycled only after the fence of its submission has passed.
+	struct CommandContext
+	{
+		ComPointer<ID3D12CommandAllocator> allocator;
+		ComPointer<ID3D12GraphicsCommandList7> list;
+		D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+	};
+
+	CommandContext* AcquireCommandContext();
+	FenceTicket Submit(CommandContext* ctx);
+	FenceTicket Submit(CommandContext* const* ctxs, UINT count);	// one ExecuteCommandLists, one ticket
+	void DiscardCommandContext(CommandContext* ctx);				// acquired but never submitted
+	inline CommandPoolStats GetCommandPoolStats() const { return m_cmdPool.GetStats(); }
+
 	void SignalAndWait();
+	// Main-thread shorthand over the pool: InitCommandList -> record -> Submit/ExecuteCommandList
 	ID3D12GraphicsCommandList7* InitCommandList();
-	ID3D12GraphicsCommandList7* GetCommandList() { return m_cmdList; }
+	ID3D12GraphicsCommandList7* GetCommandList() { return m_current ? m_current->list.Get() : nullptr; }
 	void ExecuteCommandList();
+	// Queues the open list followed by ctxs (recorded elsewhere, e.g. on job threads) and
+	// continues on a fresh list. Submit() executes all of them in that order, in one call.
+	ID3D12GraphicsCommandList7* ChainCommandLists(CommandContext* const* ctxs, UINT count);
+
+	// Non-blocking submit: closes/executes the InitCommandList list and returns its fence ticket
+	FenceTicket Submit();
+	bool IsComplete(FenceTicket ticket);
+	void WaitFor(FenceTicket ticket);
+	// Runs callback once the ticket has passed (immediately if it already has)
+	void OnComplete(FenceTicket ticket, DeferredReleaseQueue::Callback callback);
+	// Keeps resource alive until the GPU is done with the ticket
+	void DeferRelease(FenceTicket ticket, ComPointer<ID3D12Resource> resource);
+	void ProcessCompletions();
+
+	// Frames in flight: BeginFrame waits only for the frame slot being reused
+	bool BeginFrame();
+	void EndFrame();
+	// Frames the GPU may still be working on when BeginFrame returns, counting the new one
+	// (1 = CPU and GPU take turns). Clamped to the frame context count, which is the default.
+	void SetQueuedFrames(UINT count);
+	inline UINT GetQueuedFrames() const { return m_queuedFrames; }
+
+	// Per-frame upload space (CB data etc.). Returns 0 outside BeginFrame/EndFrame or when full.
+	D3D12_GPU_VIRTUAL_ADDRESS PushFrameConstants(const void* data, UINT size);
+
+	// Asset uploads (main thread only) run on a dedicated COPY queue with its own fence, so the
+	// tickets below are copy-fence tickets. Everything recorded between Begin/EndUploadBatch shares
+	// one copy list and one signal; outside a batch every call submits on its own.
+	// Copy-queue access leaves resources in COMMON.
+	void BeginUploadBatch();
+	FenceTicket EndUploadBatch();
+	inline bool IsInUploadBatch() const { return m_uploadBatchOpen; }
+	// Staged through the upload ring; buffers are promoted from COMMON implicitly on first use
+	FenceTicket UploadBuffer(ID3D12Resource* dst, const void* data, UINT64 size);
+	// Caller-recorded copies (e.g. texture mips from its own upload buffer) into the batch's copy list
+	FenceTicket RecordUploadCopies(const std::function<void(ID3D12GraphicsCommandList7*)>& record, UINT64 bytes);
+	// First use of an uploaded resource: the next direct-queue submission waits on the GPU for the
+	// copy; the CPU never blocks. Any thread (recording jobs call it).
+	void WaitForCopy(FenceTicket copyTicket);
+	bool IsCopyComplete(FenceTicket copyTicket);
+
+	// Inference (ORT/DirectML) runs on its own COMPUTE queue so the direct queue can render the
+	// next scene meanwhile. Tickets below are inference-fence tickets; main thread only.
+	// Direct -> inference: the inference queue waits on the GPU for a direct-queue ticket
+	void InferenceWaitFor(FenceTicket directTicket);
+	// Signals after everything queued on the inference queue so far (e.g. one ORT Run)
+	FenceTicket SignalInference();
+	// Inference -> direct: direct-queue submissions from now on wait on the GPU for the ticket
+	void WaitForInference(FenceTicket inferenceTicket);
+	bool IsInferenceComplete(FenceTicket inferenceTicket);
+
+	// Async compute: pre/postprocess dispatches on a second COMPUTE queue, apart from the
+	// inference queue so ORT never sits behind them. Tickets below are compute-fence tickets;
+	// main thread only. Compute lists cannot touch graphics-only states (PSR, RTV, ...).
+	CommandContext* AcquireComputeContext();
+	// Executes ctx after the GPU has passed both tickets (either may be invalid)
+	FenceTicket SubmitCompute(CommandContext* ctx, FenceTicket directWait, FenceTicket inferenceWait);
+	// Compute -> inference: the inference queue waits on the GPU for a compute ticket
+	void InferenceWaitForCompute(FenceTicket computeTicket);
+	// Compute -> direct: direct-queue submissions from now on wait on the GPU for the ticket
+	void WaitForCompute(FenceTicket computeTicket);
+	bool IsComputeComplete(FenceTicket computeTicket);
+
+	// GPU timestamps per queue; spans are collected in ProcessCompletions
+	inline GpuTimer& GetDirectTimer() { return m_directTimer; }
+	inline GpuTimer& GetComputeTimer() { return m_computeTimer; }
+	inline GpuTimer& GetInferenceTimer() { return m_inferTimer; }
+
+	// Copy-queue upload telemetry
+	struct UploadStats
+	{
+		UINT64 frameBytes = 0;			// handed to the copy queue during the last finished frame
+		UINT64 totalBytes = 0;			// since Init
+		UINT64 submits = 0;				// copy lists executed
+		UINT64 copiesInFlight = 0;		// submitted copy fence values the GPU has not passed yet
+		UINT64 ringCapacity = 0;
+		UINT64 ringHighWater = 0;
+		UINT64 ringStalls = 0;			// CPU waits on the copy fence for ring space
+		UINT64 oversized = 0;			// uploads larger than the ring (one-off upload buffers)
+	};
+	UploadStats GetUploadStats();
 
 	inline void Flush(size_t count)
 	{
@@ -41,6 +150,42 @@ public:
 	inline ComPointer<IDXGIFactory7>& GetFactory() { return m_dxgiFactory; }
 	inline ComPointer<ID3D12Device12>& GetDevice() { return m_device; }
 	inline ComPointer<ID3D12CommandQueue>& GetCommandQueue() { return m_cmdQueue; }
+	inline ComPointer<ID3D12CommandQueue>& GetCopyQueue() { return m_copyQueue; }
+	inline ComPointer<ID3D12CommandQueue>& GetInferenceQueue() { return m_inferQueue; }
+	inline ComPointer<ID3D12CommandQueue>& GetComputeQueue() { return m_computeQueue; }
+
+	inline bool IsInFrame() const { return m_inFrame; }
+	inline size_t GetFrameIndex() const { return m_frames.GetIndex(); }
+	inline UINT64 GetFrameStallCount() const { return m_frames.GetStallCount(); }
+	inline size_t GetPendingCompletionCount() const { return m_deferred.GetPendingCount(); }
+
+private:
+	struct FrameContext
+	{
+		ComPointer<ID3D12Resource> upload;
+		UINT8* uploadCPU = nullptr;
+		FrameLinearAllocator uploadCursor;
+		UINT64 computeFenceValue = 0;	// compute work recorded with this frame's constants
+	};
+
+	bool InitFrameContexts();
+	bool InitCopyQueue();
+	bool InitUploadRing();
+	bool InitInferenceQueue();
+	bool InitComputeQueue();
+	void InitTimers();
+	CommandContext* CreateCommandContext(D3D12_COMMAND_LIST_TYPE type);
+	CommandContext* AcquireFromPool(D3D12_COMMAND_LIST_TYPE type);
+	FencedCommandPool<CommandContext*>& GetPool(D3D12_COMMAND_LIST_TYPE type);
+	UINT64 Signal();
+	void WaitForFence(ID3D12Fence* fence, HANDLE event, UINT64 value);
+	void WaitForFenceValue(UINT64 value);
+	void WaitForCopyFenceValue(UINT64 value);
+
+	ID3D12GraphicsCommandList7* GetUploadList();	// opens the batch's copy list on first use
+	UINT64 AllocateUploadSpace(UINT64 size);
+	FenceTicket SubmitUploadList();				// the batch itself stays open
+	void CountUploadBytes(UINT64 bytes);
 
 private:
 	ComPointer<IDXGIFactory7> m_dxgiFactory;
@@ -48,12 +193,65 @@ private:
 	ComPointer<ID3D12Device12> m_device; 
 	ComPointer<ID3D12CommandQueue> m_cmdQueue;
 
-	ComPointer <ID3D12CommandAllocator> m_cmdAllocator;
-	ComPointer<ID3D12GraphicsCommandList7> m_cmdList;
+	// Owns every pooled pair; the pool only moves pointers around
+	std::vector<std::unique_ptr<CommandContext>> m_cmdContexts;
+	std::mutex m_cmdContextMutex;
+	FencedCommandPool<CommandContext*> m_cmdPool;
+	CommandContext* m_current = nullptr;
+	std::vector<CommandContext*> m_chained;	// recorded ahead of m_current, not yet submitted
+
+	std::mutex m_submitMutex;
 
 	ComPointer<ID3D12Fence> m_fence;
 	UINT64 m_fenceValue = 0;
 	HANDLE m_fenceEvent = nullptr;
 
+	FrameResourceRing<FrameContext> m_frames;
+	bool m_inFrame = false;
+	UINT m_queuedFrames = 0;
+	std::deque<UINT64> m_frameSignals;	// EndFrame fence values, newest last
+
+	DeferredReleaseQueue m_deferred;
+
+	ComPointer<ID3D12CommandQueue> m_copyQueue;
+	ComPointer<ID3D12Fence> m_copyFence;
+	UINT64 m_copyFenceValue = 0;
+	HANDLE m_copyFenceEvent = nullptr;
+	FencedCommandPool<CommandContext*> m_copyPool;
+	DeferredReleaseQueue m_copyDeferred;
+	std::atomic<UINT64> m_copyWaitValue{ 0 };	// highest copy ticket the direct queue must wait for
+	UINT64 m_copyWaitIssued = 0;				// already waited on by the direct queue
+
+	ComPointer<ID3D12Resource> m_uploadBuffer;
+	UINT8* m_uploadBufferCPU = nullptr;
+	UploadRingAllocator m_uploadRing;
+	bool m_uploadBatchOpen = false;
+	CommandContext* m_uploadBatch = nullptr;					// copy list, opened lazily
+	std::vector<ComPointer<ID3D12Resource>> m_uploadOversized;	// larger than the ring, released with the list
+
+	ComPointer<ID3D12CommandQueue> m_inferQueue;
+	ComPointer<ID3D12Fence> m_inferFence;
+	UINT64 m_inferFenceValue = 0;
+	HANDLE m_inferFenceEvent = nullptr;
+	UINT64 m_inferWaitIssued = 0;				// already waited on by the direct queue
+
+	ComPointer<ID3D12CommandQueue> m_computeQueue;
+	ComPointer<ID3D12Fence> m_computeFence;
+	UINT64 m_computeFenceValue = 0;
+	HANDLE m_computeFenceEvent = nullptr;
+	FencedCommandPool<CommandContext*> m_computePool;
+	UINT64 m_computeWaitIssued = 0;				// already waited on by the direct queue
+
+	GpuTimer m_directTimer;
+	GpuTimer m_computeTimer;
+	GpuTimer m_inferTimer;
+
+	UINT64 m_frameUploadBytes = 0;
+	UINT64 m_lastFrameUploadBytes = 0;
+	UINT64 m_totalUploadBytes = 0;
+	UINT64 m_uploadSubmits = 0;
+	UINT64 m_uploadRingStalls = 0;
+	UINT64 m_uploadOversizedCount = 0;
+
 };
 
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <utility>
+
+//===================================================================//
+// Fence tickets + deferred work, backend-neutral.
+// A ticket is the fence value signaled right after a submission; the
+// submission is complete once the fence's completed value reaches it.
+//===================================================================//
+
+struct FenceTicket
+{
+	uint64_t value = 0;
+
+	bool IsValid() const { return value != 0; }
+	bool IsCompleteAt(uint64_t completedValue) const { return value <= completedValue; }
+};
+
+// Callbacks (resource releases, readback maps ...) waiting on a fence value.
+// Fence values only grow, so the queue stays sorted as long as callers
+// enqueue tickets in submission order; out-of-order entries are still
+// handled, they just run no earlier than their predecessors.
+class DeferredReleaseQueue
+{
+public:
+	using Callback = std::function<void()>;
+
+	void Enqueue(FenceTicket ticket, Callback fn)
+	{
+		m_Pending.emplace_back(ticket.value, std::move(fn));
+	}
+
+	// Runs every callback whose ticket is complete. Returns how many ran.
+	size_t Retire(uint64_t completedValue)
+	{
+		size_t count = 0;
+		while (!m_Pending.empty() && m_Pending.front().first <= completedValue)
+		{
+			// pop first: the callback may enqueue more work
+			Callback fn = std::move(m_Pending.front().second);
+			m_Pending.pop_front();
+			if (fn)
+			{
+				fn();
+			}
+			++count;
+		}
+		m_RetiredCount += count;
+		return count;
+	}
+
+	// Only valid once the device is idle (shutdown).
+	size_t RetireAll()
+	{
+		return Retire(~0ull);
+	}
+
+	void Clear()					{ m_Pending.clear(); }
+
+	size_t GetPendingCount() const	{ return m_Pending.size(); }
+	uint64_t GetRetiredCount() const { return m_RetiredCount; }
+
+private:
+	std::deque<std::pair<uint64_t, Callback>> m_Pending;
+	uint64_t m_RetiredCount = 0;
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//===================================================================//
+// Backend-neutral helpers for N frames in flight.
+// No D3D types in here on purpose: the fence is a template parameter
+// so the ring can be driven by a fake fence off-GPU.
+//===================================================================//
+
+// Linear sub-allocator over a fixed range (per-frame upload space).
+class FrameLinearAllocator
+{
+public:
+	static constexpr uint64_t InvalidOffset = ~0ull;
+
+	void Reset(uint64_t capacity)
+	{
+		m_Capacity = capacity;
+		m_Offset = 0;
+	}
+
+	void Rewind() { m_Offset = 0; }
+
+	// align must be a power of two. Returns InvalidOffset when out of space.
+	uint64_t Allocate(uint64_t size, uint64_t align)
+	{
+		const uint64_t begin = (m_Offset + (align - 1)) & ~(align - 1);
+		if (begin + size > m_Capacity)
+		{
+			return InvalidOffset;
+		}
+
+		m_Offset = begin + size;
+		if (m_Offset > m_HighWater)
+		{
+			m_HighWater = m_Offset;
+		}
+		return begin;
+	}
+
+	uint64_t GetUsed() const		{ return m_Offset; }
+	uint64_t GetCapacity() const	{ return m_Capacity; }
+	uint64_t GetHighWater() const	{ return m_HighWater; }
+
+private:
+	uint64_t m_Capacity = 0;
+	uint64_t m_Offset = 0;
+	uint64_t m_HighWater = 0;
+};
+
+// Ring of per-frame resources, each tagged with the fence value that retires it.
+//
+// TFence must provide:
+//   uint64_t GetCompletedValue() const;
+//   void     WaitForValue(uint64_t value);
+//
+// Usage per frame:  Acquire(fence) -> record/submit -> Retire(signaledValue)
+template<typename TFrame>
+class FrameResourceRing
+{
+public:
+	struct Slot
+	{
+		TFrame res{};
+		uint64_t fenceValue = 0;
+	};
+
+	void Resize(size_t count)
+	{
+		m_Slots.clear();
+		m_Slots.resize(count > 0 ? count : 1);
+		m_Index = 0;
+	}
+
+	void Clear()
+	{
+		m_Slots.clear();
+		m_Index = 0;
+	}
+
+	// Blocks only if the GPU is still using the slot we are about to reuse.
+	template<typename TFence>
+	TFrame& Acquire(TFence& fence)
+	{
+		Slot& slot = m_Slots[m_Index];
+		if (slot.fenceValue != 0 && fence.GetCompletedValue() < slot.fenceValue)
+		{
+			fence.WaitForValue(slot.fenceValue);
+			++m_StallCount;
+		}
+		slot.fenceValue = 0;
+		return slot.res;
+	}
+
+	// Tag the current slot with the last fence value signaled for it and move on.
+	void Retire(uint64_t fenceValue)
+	{
+		m_Slots[m_Index].fenceValue = fenceValue;
+		m_Index = (m_Index + 1) % m_Slots.size();
+		++m_FrameNumber;
+	}
+
+	TFrame& Current()				{ return m_Slots[m_Index].res; }
+	const TFrame& Current() const	{ return m_Slots[m_Index].res; }
+
+	template<typename Fn>
+	void ForEach(Fn&& fn)
+	{
+		for (Slot& slot : m_Slots)
+		{
+			fn(slot.res);
+		}
+	}
+
+	size_t GetCount() const			{ return m_Slots.size(); }
+	size_t GetIndex() const			{ return m_Index; }
+	uint64_t GetFrameNumber() const	{ return m_FrameNumber; }
+	uint64_t GetStallCount() const	{ return m_StallCount; }
+
+private:
+	std::vector<Slot> m_Slots;
+	size_t m_Index = 0;
+
+	uint64_t m_FrameNumber = 0;
+	uint64_t m_StallCount = 0;
+};
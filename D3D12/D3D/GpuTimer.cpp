@@ -0,0 +1,269 @@
+#include "GpuTimer.h"
+
+#include "d3dx12.h"
+#include <cstring>
+
+namespace
+{
+	constexpr float kAverageWeight = 0.1f;
+}
+
+bool GpuTimer::Init(ID3D12Device* device, ID3D12CommandQueue* queue, D3D12_COMMAND_LIST_TYPE type, UINT maxSpans)
+{
+	Shutdown();
+	if (device == nullptr || queue == nullptr || maxSpans == 0)
+	{
+		return false;
+	}
+
+	if (FAILED(queue->GetTimestampFrequency(&m_Frequency)) || m_Frequency == 0)
+	{
+		OutputDebugStringA("[GpuTimer] queue has no timestamp frequency, timing disabled\n");
+		return false;
+	}
+
+	D3D12_QUERY_HEAP_DESC qd{};
+	qd.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+	qd.Count = maxSpans * 2;
+	if (FAILED(device->CreateQueryHeap(&qd, IID_PPV_ARGS(&m_QueryHeap))))
+	{
+		OutputDebugStringA("[GpuTimer] CreateQueryHeap failed, timing disabled\n");
+		return false;
+	}
+
+	CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_READBACK);
+	CD3DX12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(uint64_t) * qd.Count);
+	if (FAILED(device->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &desc,
+		D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&m_Readback))))
+	{
+		OutputDebugStringA("[GpuTimer] readback buffer failed, timing disabled\n");
+		m_QueryHeap.Release();
+		return false;
+	}
+
+	// Readback heap stays mapped; a span is only read after its fence passed
+	void* mapped = nullptr;
+	if (FAILED(m_Readback->Map(0, nullptr, &mapped)) || mapped == nullptr)
+	{
+		m_Readback.Release();
+		m_QueryHeap.Release();
+		return false;
+	}
+
+	m_Device = device;
+	m_Queue = queue;
+	m_Type = type;
+	m_ReadbackCPU = static_cast<const uint64_t*>(mapped);
+	m_Spans.assign(maxSpans, Span{});
+	m_Markers.resize((size_t)maxSpans * 2);
+	m_Next = 0;
+	return true;
+}
+
+void GpuTimer::Shutdown()
+{
+	if (m_Readback && m_ReadbackCPU != nullptr)
+	{
+		m_Readback->Unmap(0, nullptr);
+	}
+	m_ReadbackCPU = nullptr;
+	m_Readback.Release();
+	m_QueryHeap.Release();
+	m_Markers.clear();
+	m_Spans.clear();
+	m_Stages.clear();
+	m_Queue.Release();
+	m_Device.Release();
+	m_Frequency = 0;
+	m_Next = 0;
+}
+
+UINT GpuTimer::AcquireSpan(const char* stage)
+{
+	if (IsActive() == false)
+	{
+		return InvalidSpan;
+	}
+
+	// Ring order; a span still waiting for its fence is skipped rather than waited on
+	const UINT count = (UINT)m_Spans.size();
+	for (UINT i = 0; i < count; ++i)
+	{
+		const UINT index = (m_Next + i) % count;
+		if (m_Spans[index].state == SpanState::Free)
+		{
+			m_Spans[index].stage = stage;
+			m_Spans[index].state = SpanState::Open;
+			m_Spans[index].fenceValue = 0;
+			m_Next = (index + 1) % count;
+			return index;
+		}
+	}
+	return InvalidSpan;
+}
+
+UINT GpuTimer::Begin(ID3D12GraphicsCommandList* cmd, const char* stage)
+{
+	if (cmd == nullptr)
+	{
+		return InvalidSpan;
+	}
+
+	const UINT span = AcquireSpan(stage);
+	if (span != InvalidSpan)
+	{
+		cmd->EndQuery(m_QueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, span * 2);
+	}
+	return span;
+}
+
+void GpuTimer::End(ID3D12GraphicsCommandList* cmd, UINT span)
+{
+	if (cmd == nullptr || span >= m_Spans.size() || m_Spans[span].state != SpanState::Open)
+	{
+		return;
+	}
+
+	cmd->EndQuery(m_QueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, span * 2 + 1);
+	cmd->ResolveQueryData(m_QueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, span * 2, 2,
+		m_Readback, sizeof(uint64_t) * span * 2);
+	m_Spans[span].state = SpanState::Ended;
+}
+
+ID3D12GraphicsCommandList* GpuTimer::OpenMarker(UINT index)
+{
+	Marker& marker = m_Markers[index];
+	if (!marker.allocator)
+	{
+		if (FAILED(m_Device->CreateCommandAllocator(m_Type, IID_PPV_ARGS(&marker.allocator))) ||
+			FAILED(m_Device->CreateCommandList(0, m_Type, marker.allocator, nullptr, IID_PPV_ARGS(&marker.list))))
+		{
+			marker = Marker{};
+			return nullptr;
+		}
+		return marker.list;
+	}
+
+	// The span owning this marker was collected, so its last execution is done
+	marker.allocator->Reset();
+	marker.list->Reset(marker.allocator, nullptr);
+	return marker.list;
+}
+
+void GpuTimer::SubmitMarker(UINT index)
+{
+	ID3D12GraphicsCommandList* list = m_Markers[index].list;
+	if (FAILED(list->Close()))
+	{
+		return;
+	}
+	ID3D12CommandList* lists[] = { list };
+	m_Queue->ExecuteCommandLists(1, lists);
+}
+
+UINT GpuTimer::BeginOnQueue(const char* stage)
+{
+	const UINT span = AcquireSpan(stage);
+	if (span == InvalidSpan)
+	{
+		return InvalidSpan;
+	}
+
+	ID3D12GraphicsCommandList* list = OpenMarker(span * 2);
+	if (list == nullptr)
+	{
+		m_Spans[span].state = SpanState::Free;
+		return InvalidSpan;
+	}
+	list->EndQuery(m_QueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, span * 2);
+	SubmitMarker(span * 2);
+	return span;
+}
+
+void GpuTimer::EndOnQueue(UINT span)
+{
+	if (span >= m_Spans.size() || m_Spans[span].state != SpanState::Open)
+	{
+		return;
+	}
+
+	ID3D12GraphicsCommandList* list = OpenMarker(span * 2 + 1);
+	if (list == nullptr)
+	{
+		// Begin already went to the queue: let it retire with the next submission unread
+		m_Spans[span].stage = nullptr;
+		m_Spans[span].state = SpanState::Ended;
+		return;
+	}
+	End(list, span);
+	SubmitMarker(span * 2 + 1);
+}
+
+void GpuTimer::Submitted(uint64_t fenceValue)
+{
+	for (Span& span : m_Spans)
+	{
+		if (span.state == SpanState::Ended)
+		{
+			span.state = SpanState::Submitted;
+			span.fenceValue = fenceValue;
+		}
+	}
+}
+
+void GpuTimer::Collect(uint64_t completedValue)
+{
+	if (IsActive() == false)
+	{
+		return;
+	}
+
+	for (UINT i = 0; i < (UINT)m_Spans.size(); ++i)
+	{
+		Span& span = m_Spans[i];
+		if (span.state != SpanState::Submitted || span.fenceValue > completedValue)
+		{
+			continue;
+		}
+
+		const uint64_t begin = m_ReadbackCPU[i * 2];
+		const uint64_t end = m_ReadbackCPU[i * 2 + 1];
+		if (span.stage != nullptr && end >= begin)
+		{
+			Record(span.stage, (float)((double)(end - begin) * 1000.0 / (double)m_Frequency));
+		}
+		span = Span{};
+	}
+}
+
+void GpuTimer::Record(const char* stage, float ms)
+{
+	StageStats* stats = nullptr;
+	for (StageStats& s : m_Stages)
+	{
+		if (std::strcmp(s.name, stage) == 0)
+		{
+			stats = &s;
+			break;
+		}
+	}
+	if (stats == nullptr)
+	{
+		m_Stages.push_back(StageStats{ stage, ms, ms, 0 });
+		stats = &m_Stages.back();
+	}
+
+	stats->lastMs = ms;
+	stats->avgMs = stats->samples == 0 ? ms : stats->avgMs + (ms - stats->avgMs) * kAverageWeight;
+	++stats->samples;
+}
+
+float GpuTimer::GetAverageTotalMs() const
+{
+	float total = 0.0f;
+	for (const StageStats& s : m_Stages)
+	{
+		total += s.avgMs;
+	}
+	return total;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Support/WinInclude.h"
+#include "Support/ComPointer.h"
+
+#include <cstdint>
+#include <vector>
+
+//===================================================================//
+// GPU timestamp spans on one queue, averaged per stage name.
+//  Begin -> End -> [list executed] Submitted(fence) -> [fence passes] Collect
+// Main thread only. A span belongs to the first submission on its queue
+// after End, so record and submit a list before starting the next one.
+// Timestamps of different queues are not compared, only durations.
+//===================================================================//
+class GpuTimer
+{
+public:
+	static constexpr UINT InvalidSpan = ~0u;
+
+	struct StageStats
+	{
+		const char* name = nullptr;	// compared by content
+		float lastMs = 0.0f;
+		float avgMs = 0.0f;			// exponential moving average
+		uint64_t samples = 0;
+	};
+
+	bool Init(ID3D12Device* device, ID3D12CommandQueue* queue, D3D12_COMMAND_LIST_TYPE type, UINT maxSpans = 64);
+	void Shutdown();
+
+	// Timestamps inside a list that executes on this timer's queue
+	UINT Begin(ID3D12GraphicsCommandList* cmd, const char* stage);
+	void End(ID3D12GraphicsCommandList* cmd, UINT span);
+
+	// Timestamps submitted straight to the queue, around work recorded elsewhere (ORT)
+	UINT BeginOnQueue(const char* stage);
+	void EndOnQueue(UINT span);
+
+	// Every ended span not submitted yet belongs to the submission signaled with fenceValue
+	void Submitted(uint64_t fenceValue);
+	// Reads back every span whose fence passed
+	void Collect(uint64_t completedValue);
+
+	inline bool IsActive() const { return m_ReadbackCPU != nullptr; }
+	inline const std::vector<StageStats>& GetStages() const { return m_Stages; }
+	// Sum of the stages' averages: busy time of this queue per frame
+	float GetAverageTotalMs() const;
+
+private:
+	enum class SpanState : uint8_t { Free, Open, Ended, Submitted };
+
+	struct Span
+	{
+		const char* stage = nullptr;
+		SpanState state = SpanState::Free;
+		uint64_t fenceValue = 0;
+	};
+
+	// Standalone one-query lists for *OnQueue, one pair per span
+	struct Marker
+	{
+		ComPointer<ID3D12CommandAllocator> allocator;
+		ComPointer<ID3D12GraphicsCommandList> list;
+	};
+
+	UINT AcquireSpan(const char* stage);
+	ID3D12GraphicsCommandList* OpenMarker(UINT index);
+	void SubmitMarker(UINT index);
+	void Record(const char* stage, float ms);
+
+private:
+	ComPointer<ID3D12Device> m_Device;
+	ComPointer<ID3D12CommandQueue> m_Queue;
+	D3D12_COMMAND_LIST_TYPE m_Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+
+	ComPointer<ID3D12QueryHeap> m_QueryHeap;
+	ComPointer<ID3D12Resource> m_Readback;
+	const uint64_t* m_ReadbackCPU = nullptr;
+	uint64_t m_Frequency = 0;
+
+	std::vector<Span> m_Spans;
+	std::vector<Marker> m_Markers;
+	UINT m_Next = 0;
+
+	std::vector<StageStats> m_Stages;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+//===================================================================//
+// Fence-retired ring sub-allocator for a persistent upload buffer.
+// Backend-neutral on purpose (offsets and fence values only), so the
+// wrap/retire logic can be exercised without a GPU.
+//
+//  Allocate ... Allocate -> Close(fence) -> [fence passes] -> Retire
+// Allocations between two Close calls form one batch; a batch's bytes
+// come back only once its fence value is reached. Batches retire in
+// the order they were closed, so the live range is always contiguous.
+//===================================================================//
+class UploadRingAllocator
+{
+public:
+	static constexpr uint64_t InvalidOffset = ~0ull;
+
+	void Reset(uint64_t capacity)
+	{
+		m_Capacity = capacity;
+		m_Head = 0;
+		m_Used = 0;
+		m_Open = 0;
+		m_Closed.clear();
+	}
+
+	// align must be a power of two. Returns InvalidOffset when the free space
+	// (after skipping the tail end on wrap) is too small; retire and retry.
+	uint64_t Allocate(uint64_t size, uint64_t align)
+	{
+		if (size > m_Capacity)
+		{
+			return InvalidOffset;
+		}
+
+		// Nothing live: restart at 0 so large requests see the whole ring
+		if (m_Used == 0)
+		{
+			m_Head = 0;
+		}
+
+		uint64_t begin = (m_Head + (align - 1)) & ~(align - 1);
+		uint64_t consumed = 0;
+		if (begin + size <= m_Capacity)
+		{
+			consumed = begin + size - m_Head;
+		}
+		else
+		{
+			// Does not fit before the end: burn the tail and wrap to 0
+			begin = 0;
+			consumed = (m_Capacity - m_Head) + size;
+		}
+
+		if (m_Used + consumed > m_Capacity)
+		{
+			return InvalidOffset;
+		}
+
+		m_Head = begin + size;
+		if (m_Head == m_Capacity)
+		{
+			m_Head = 0;
+		}
+		m_Used += consumed;
+		m_Open += consumed;
+		if (m_Used > m_HighWater)
+		{
+			m_HighWater = m_Used;
+		}
+		return begin;
+	}
+
+	// Tags everything allocated since the last Close with the fence value of its submission.
+	void Close(uint64_t fenceValue)
+	{
+		if (m_Open == 0)
+		{
+			return;
+		}
+		m_Closed.emplace_back(fenceValue, m_Open);
+		m_Open = 0;
+	}
+
+	// Frees every closed batch whose fence has passed. Returns the bytes freed.
+	uint64_t Retire(uint64_t completedValue)
+	{
+		uint64_t freed = 0;
+		while (!m_Closed.empty() && m_Closed.front().first <= completedValue)
+		{
+			freed += m_Closed.front().second;
+			m_Closed.pop_front();
+		}
+		m_Used -= freed;
+		return freed;
+	}
+
+	// Fence value that frees the oldest closed batch; 0 when nothing is waiting.
+	uint64_t GetOldestFence() const		{ return m_Closed.empty() ? 0 : m_Closed.front().first; }
+
+	uint64_t GetUsed() const			{ return m_Used; }
+	uint64_t GetOpenBytes() const		{ return m_Open; }
+	uint64_t GetCapacity() const		{ return m_Capacity; }
+	uint64_t GetHighWater() const		{ return m_HighWater; }
+
+private:
+	uint64_t m_Capacity = 0;
+	uint64_t m_Head = 0;		// next write position
+	uint64_t m_Used = 0;		// live bytes, including wrap padding
+	uint64_t m_Open = 0;		// bytes of the batch not closed yet
+	uint64_t m_HighWater = 0;
+
+	std::deque<std::pair<uint64_t, uint64_t>> m_Closed;	// (fence value, bytes)
+};
@@ -13,9 +13,12 @@
 
 #include "DebugD3D12/DebugLayer.h"
 #include "Util/Util.h"
+#include "Util/JobSystem.h"
+#include "Util/FramePacer.h"
 
 #include "D3D/DXContext.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 
@@ -40,7 +43,7 @@ constexpr OnnxType ONNX_TYPE = OnnxType::FastNeuralStyle;
 
 #if DEBUG_TIME
 #define DEBUG_TIME_EXPR(OUT_NAME)\
-    endSecStart = std::chrono::system_clock::now() - startTime;\
+    endSecStart = std::chrono::steady_clock::now() - startTime;\
     Util::Print((float)endSecStart.count(), OUT_NAME);
 #else
 #define DEBUG_TIME_EXPR(OUT_NAME)  ((void)0)
@@ -75,6 +78,108 @@ extern const int MAX_FRAME = 480;
 
 extern int FrameNum = 0;
 
+// SponzaModel::Render 병렬 기록 (청크당 최소 드로우 수)
+extern const bool PARALLEL_RECORD = true;
+extern const int PARALLEL_RECORD_MIN_DRAWS = 32;
+
+// 추론 지연 프레임 (0: 직렬, 1~2: 장면 N+1 렌더링과 추론 N을 겹침, 화면은 그만큼 늦게 표시)
+// 슬롯별 버퍼를 지원하는 러너(FastNeuralStyle/ReCoNet)만 적용, 나머지는 0
+extern const int INFERENCE_LATENCY_FRAMES = 1;
+
+// 전/후처리 디스패치를 별도 컴퓨트 큐에서 실행 (다음 프레임 그림자/장면 렌더링과 겹침)
+// false: 직접 큐에서 장면 뒤/블릿 앞에 기록 (기존 방식)
+// 겹쳐서 빨라지는지는 GPU마다 다르므로 기본은 끔. DEBUG_TIME의 큐별 GPU 시간을 보고 켤 것
+extern const bool ASYNC_COMPUTE_PREPOST = false;
+
+// 프레임 페이싱: 목표 프레임 시간(0이면 제한 없음), vsync, CPU가 앞서 큐에 넣을 최대 프레임 수
+// 큐 깊이와 다음 프레임 시작 시점은 FramePacer가 단계별 측정값으로 결정
+extern const double TARGET_FRAME_MS = 1000.0 / 60.0;
+extern const bool PRESENT_VSYNC = true;
+extern const int MAX_QUEUED_FRAMES = (int)DXWindow::FrameCount;
+
+// ONNX 러너 풀: 한 번 로드한 모델은 세션을 유지해서 모델 전환 시 IO/전후처리만 다시 묶음
+// 러너 수/추정 메모리(모델 파일 크기, MB, 0이면 무제한)를 넘으면 가장 오래 안 쓴 러너부터 해제
+// PRELOAD: 시작 시 나머지 모델도 한도 안에서 미리 로드 (시작은 느려지고 첫 전환도 즉시)
+extern const int ONNX_POOL_MAX_RUNNERS = 3;
+extern const int ONNX_POOL_MAX_MB = 1024;
+extern const bool ONNX_POOL_PRELOAD = false;
+
+// 최적화된 모델 캐시 (./Resources/Onnx/Cache): 모델 해시 + ORT 버전 + EP가 키
+// 첫 실행에 기본 그래프 최적화 결과를 저장하고 이후엔 그 그래프로 세션 생성 (cold/warm 시간 출력)
+extern const bool ONNX_MODEL_CACHE = true;
+
+// AdaIN/SANet 분할 그래프 (*_style_encoder_*.onnx + *_decoder_*.onnx가 end2end 모델 옆에 있을 때)
+// 스타일 인코더는 스타일이 바뀔 때만 실행하고 특징은 GPU에 캐시, 매 프레임은 콘텐츠 쪽만 실행
+extern const bool ADAIN_SPLIT_STYLE = true;
+
+// FP16 텐서 경로: 모델 옆에 <모델>_fp16.onnx가 있으면 그걸 로드 (Tools/onnx_fp16.py로 변환)
+// 전처리가 half로 쓰고 러너는 FLOAT16 텐서로 바인딩, 후처리가 half로 읽음 (텐서 메모리/대역폭 절반)
+extern const bool ONNX_FP16 = false;
+
+// INT8 (QDQ) 경로: FastNeuralStyle/ReCoNet은 <모델>_int8.onnx가 있으면 그걸 로드 (ONNX_FP16보다 우선)
+// Tools/onnx_int8.py가 Resources/*.png나 녹화한 카메라 워크 프레임으로 보정해서 생성, --report로 fp32 대비 PSNR/속도 비교
+extern const bool ONNX_INT8 = false;
+
+// 동적 추론 해상도: 추론 시간(ORT Run CPU와 추론 큐 GPU 중 큰 쪽)이 예산을 넘으면 모델 입력을 줄이고
+// 한참 남으면 키움 (8의 배수, 최소 배율까지). 후처리가 백버퍼 크기로 리샘플. 0이면 항상 백버퍼 크기
+// 입력 H/W가 정적인 모델은 적용 안 됨
+extern const double INFERENCE_BUDGET_MS = 0.0;
+extern const double INFERENCE_MIN_SCALE = 0.5;
+
+// 타일 추론: 추론 해상도가 타일(8의 배수)보다 크면 겹치는 타일로 나눠 같은 고정 크기 바인딩으로 차례로 실행
+// 후처리가 겹친 부분을 페더 가중치로 섞음. 모델 활성 메모리가 해상도와 상관없이 타일 크기로 묶임 (0이면 끔)
+// 겹침은 타일의 1/4까지. 타일 추론 중에는 INFERENCE_LATENCY_FRAMES를 쓰지 않음 (슬롯 1개), 입력 H/W가 정적인 모델은 적용 안 됨
+extern const int ONNX_TILE_SIZE = 0;
+extern const int ONNX_TILE_OVERLAP = 32;
+
+// 배치 추론: 연속 프레임 B개를 슬롯 입력 텐서의 N 축에 모아 Run 한 번으로 처리 (1이면 끔, 최대 ONNX_MAX_BATCH)
+// Run 호출당 오버헤드가 나뉘어 처리량은 늘지만 화면은 B 프레임 늦게 표시됨 -> DEBUG_PRINT_IMG 같은 오프라인 캡처용
+// N이 동적인 FastNeuralStyle/ReCoNet만 적용. 배치 중에는 타일 추론과 동적 추론 해상도를 쓰지 않음
+extern const int ONNX_BATCH_SIZE = 1;
+
+// 시간적 재사용: K 프레임마다 한 번만 추론하고 사이 프레임은 마지막 결과를 카메라 변화와 장면 깊이로 재투영 (1이면 끔)
+// 카메라가 키프레임 이후 MAX_MOVE(월드 단위)나 MAX_TURN_DEG 넘게 움직이면 K 전에 다시 추론 (0이면 그 조건 없음)
+// 재투영은 이번 프레임 카메라 기준이라 INFERENCE_LATENCY_FRAMES/ONNX_BATCH_SIZE는 쓰지 않음 (지연 0)
+extern const int ONNX_TEMPORAL_INTERVAL = 1;
+extern const double ONNX_TEMPORAL_MAX_MOVE = 0.5;
+extern const double ONNX_TEMPORAL_MAX_TURN_DEG = 6.0;
+
+// CPU EP 러너 (OnnxRunner_Cpu): 호스트 메모리 텐서로 ORT CPU 실행 공급자에서 추론
+// 추론 큐에서 입력을 읽어 와 CPU로 Run, 출력은 업로드해서 전처리/후처리는 DML 때와 같은 버퍼를 씀 (느림, 비교/대체용)
+// CPU_EP: 항상 CPU로, CPU_FALLBACK: DML 러너 생성이 실패한 모델만 CPU로
+// THREADS는 세션 자체 풀의 intra-op 스레드 수 (0이면 ORT 기본값). 전역 스레드 풀을 쓰면 무시하고 ONNX_INTRA_OP_THREADS
+extern const bool ONNX_CPU_EP = false;
+extern const bool ONNX_CPU_FALLBACK = true;
+extern const int ONNX_CPU_THREADS = 0;
+
+// ORT 환경 하나를 모든 러너가 공유. GLOBAL_THREAD_POOLS면 세션마다 스레드 풀을 만들지 않고 환경의 전역 풀 하나를 씀
+// (러너 풀/CPU 대체로 세션이 여럿이어도 코어 수 이상으로 스레드가 늘지 않음)
+// INTRA/INTER: 스레드 수 (0이면 물리 코어 수). 세션은 모두 순차 실행이라 inter-op 풀은 거의 쉼
+// SPIN: 일이 없을 때 풀 스레드가 돌며 기다릴지 (켜면 Run 지연은 약간 줄지만 렌더 스레드와 코어를 다툼)
+// AFFINITY: ORT 형식 ("1;2;3" = 호출 스레드를 뺀 intra 스레드마다 논리 프로세서 번호, ""이면 OS에 맡김)
+extern const bool ONNX_GLOBAL_THREAD_POOLS = true;
+extern const int ONNX_INTRA_OP_THREADS = 0;
+extern const int ONNX_INTER_OP_THREADS = 1;
+extern const bool ONNX_THREAD_SPIN = false;
+extern const char* ONNX_THREAD_AFFINITY = "";
+
+// 창 크기 조절: 테두리를 끄는 동안은 다시 만들지 않고 (스왑체인이 이전 백버퍼를 늘려 표시)
+// 놓은 뒤 또는 WM_SIZE가 DEBOUNCE_MS 동안 없을 때 한 번만 스왑체인/오프스크린/ONNX IO를 다시 만듦 (최대화 등)
+extern const double RESIZE_DEBOUNCE_MS = 150.0;
+
+// ONNX IO 버퍼 용량 단계: 입력/출력 버퍼를 H/W를 BUCKET_PX 배수(POW2면 2의 거듭제곱)로 올린 크기로 만들어
+// 그 안에 들어가는 크기로 바뀌면 (줄어들어도) 버퍼/DML 할당은 그대로 두고 텐서/바인딩만 다시 만듦 (0이면 정확한 크기)
+// 필요한 용량의 4배를 넘게 남으면 다시 할당
+extern const int ONNX_IO_BUCKET_PX = 64;
+extern const bool ONNX_IO_BUCKET_POW2 = false;
+
+// ORT 연산자별 프로파일링: 세션을 프로파일링 켠 채로 만들고, 워밍업 SKIP_RUNS번(shape 확인, DML 그래프 컴파일) 뒤
+// RUNS번의 Run을 모아 끔. ./Export/Profile에 ORT 트레이스와 op 종류별/노드별 시간 요약(_summary.csv/.json, 총 시간순)을 씀
+// DML은 노드를 기록하는 CPU 시간만 잡힘 (GPU 실행 시간은 트레이스에 없음). 비교는 fp16/해상도/모델 바꿔 가며 같은 창으로
+extern const bool ONNX_PROFILE = false;
+extern const int ONNX_PROFILE_SKIP_RUNS = 30;
+extern const int ONNX_PROFILE_RUNS = 100;
+
 struct ReadbackDump {
 	ComPointer<ID3D12Resource> readback;
 	D3D12_PLACED_SUBRESOURCE_FOOTPRINT fp{};
@@ -166,12 +271,16 @@ static void SaveReadbackPNG(ReadbackDump& dump, const std::string& outPath)
 
 void Shutdown()
 {
+	// in-flight 프레임 모두 완료 후 해제
+	DX_CONTEXT.Flush(DXWindow::GetFrameCount());
+
 	DX_MANAGER.Shutdown();
 	DX_IMAGE.Shutdown();
 	DX_ONNX.Shutdown();
 	DX_WINDOW.Shutdown();
 	DX_CONTEXT.Shutdown();
 	DX_INPUT.Shutdown();
+	DX_JOB.Shutdown();
 
 	DX_DEBUG_LAYER.Shutdown();
 }
@@ -184,6 +293,11 @@ int main()
 	FrameNum = 0;
 #endif // USE_KEYBOARD
 
+	if (DX_JOB.Init() == false)
+	{
+		return -1;
+	}
+
 	if (DX_INPUT.Init() == false)
 	{
 		return -1;
@@ -199,27 +313,36 @@ int main()
 		return -1;
 	}
 
-	if (DX_ONNX.Init(ONNX_TYPE, DX_CONTEXT.GetDevice(), DX_CONTEXT.GetCommandQueue()) == false)
+	if (DX_ONNX.Init(ONNX_TYPE, DX_CONTEXT.GetDevice(), DX_CONTEXT.GetInferenceQueue()) == false)
 	{
 		return -1;
 	}
 
-	std::chrono::system_clock::time_point preTick = std::chrono::system_clock::now();
-	std::chrono::system_clock::time_point tick = preTick;
+	FramePacer pacer;
+	{
+		FramePacer::Config config;
+		config.targetFrameMs = TARGET_FRAME_MS;
+		config.vsync = PRESENT_VSYNC;
+		config.maxQueuedFrames = (uint32_t)std::clamp<int>(MAX_QUEUED_FRAMES, 1, (int)DXWindow::FrameCount);
+		pacer.Reset(config);
+	}
+	DX_CONTEXT.SetQueuedFrames(pacer.GetQueuedFrames());
 
     DX_IMAGE.Init();
     DX_MANAGER.Init();
-    { auto* c = DX_CONTEXT.InitCommandList(); DX_MANAGER.UploadGPUResource(c); DX_CONTEXT.ExecuteCommandList(); }
+    { auto* c = DX_CONTEXT.InitCommandList(); DX_MANAGER.UploadGPUResource(c); DX_CONTEXT.Submit(); }
+
+	// 프레임 슬롯별 readback (슬롯이 재사용될 때까지 GPU가 쓰는 중일 수 있음)
+	ReadbackDump dumps[DXWindow::FrameCount]{};
 
     while (!DX_WINDOW.ShouldClose())
     {
-		preTick = tick;
-		tick = std::chrono::system_clock::now();
-		std::chrono::duration<float>sec = tick - preTick;
-		float deltaTime = sec.count();
+		// 목표 주기에 맞춰 시작 (입력을 늦게 읽고 CPU가 앞서 달리지 않게)
+		FramePacer::SleepUntil(pacer.GetNextStartMs());
+		float deltaTime = (float)pacer.BeginFrame(FramePacer::NowMs());
 
-		std::chrono::system_clock::time_point startTime = std::chrono::system_clock::now();
-		std::chrono::duration<float> endSecStart = std::chrono::system_clock::now() - startTime;
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		std::chrono::duration<float> endSecStart = std::chrono::steady_clock::now() - startTime;
 
 		bool updated = DX_WINDOW.MessageUpdate(deltaTime);
 
@@ -230,12 +353,35 @@ int main()
 #if DEBUG_PRINT_TIME
 		printf("%f, ", deltaTime);
 #endif
+		// 이 슬롯을 쓰던 GPU 작업 (큐 깊이가 얕으면 그만큼 최근 프레임)만 기다림
+		bool frameBegun = false;
+		{
+			ScopedFrameStage stage(pacer, FrameStage::Wait);
+			frameBegun = DX_CONTEXT.BeginFrame();
+		}
+		if (frameBegun == false)
+		{
+			break;
+		}
+
+		FenceTicket sceneTicket{};
 		{
 			ID3D12GraphicsCommandList7* cmd = DX_CONTEXT.InitCommandList();
 			 
+			double stageStart = FramePacer::NowMs();
+			GpuTimer& directTimer = DX_CONTEXT.GetDirectTimer();
+			const UINT sceneSpan = directTimer.Begin(cmd, "Scene");
 			DX_MANAGER.RenderOffscreen(cmd);
+			directTimer.End(cmd, sceneSpan);
+			pacer.AddStage(FrameStage::Render, FramePacer::NowMs() - stageStart);
+
+			// Render 구간은 여기서 닫고, 씬+전처리 리스트 제출은 전처리 구간에 한 번만 넣음
+			stageStart = FramePacer::NowMs();
 			DX_MANAGER.RecordPreprocess(cmd);      
-			DX_CONTEXT.ExecuteCommandList();        
+
+			// ORT(DML)는 추론 큐에서 이 티켓을 GPU에서 기다림 -> CPU 대기 없이 제출
+			sceneTicket = DX_CONTEXT.Submit();
+			pacer.AddStage(FrameStage::Preprocess, FramePacer::NowMs() - stageStart);
 
 			DEBUG_TIME_EXPR("ONNX START");
 
@@ -245,17 +391,23 @@ int main()
 #endif
 		}
 
-		DX_ONNX.Run();
+		{
+			ScopedFrameStage stage(pacer, FrameStage::Inference);
+			DX_MANAGER.RunInference(sceneTicket);
+		}
 		DEBUG_TIME_EXPR("ONNX RUNNING");
 
 		{
+			// 후처리는 지연 프레임 전 슬롯의 결과 (그 추론이 끝날 때까지 직접 큐만 GPU에서 대기)
+			const double postStart = FramePacer::NowMs();
 			ID3D12GraphicsCommandList7* cmd = DX_CONTEXT.InitCommandList();
 			DX_MANAGER.RecordPostprocess(cmd);
 			DEBUG_TIME_EXPR("RecordPostprocess");
 			DX_MANAGER.BlitToBackbuffer(cmd);
 
 			// === 여기서 백버퍼를 Readback으로 복사 '기록' ===
-			ReadbackDump dump{};
+			ReadbackDump& dump = dumps[DX_CONTEXT.GetFrameIndex()];
+			dump = ReadbackDump{};
 			if (FrameNum < MAX_FRAME) 
 			{
 				dump = EnqueueCopyToReadback(
@@ -268,7 +420,8 @@ int main()
 			}
 
 			DEBUG_TIME_EXPR("BlitToBackbuffer");
-			DX_CONTEXT.ExecuteCommandList();
+			FenceTicket frameTicket = DX_CONTEXT.Submit();
+			pacer.AddStage(FrameStage::Postprocess, FramePacer::NowMs() - postStart);
 
 #if DEBUG_PRINT_IMG
 			if (FrameNum < MAX_FRAME)
@@ -276,9 +429,11 @@ int main()
 				char buf[64];
 				sprintf_s(buf, "./Export/output%03d.png", FrameNum);  // buf에 결과 문자열 저장
 
+				// 대기 없이, 복사가 끝난 뒤 저장
 				if (dump.readback) {
-					DX_CONTEXT.SignalAndWait();
-					SaveReadbackPNG(dump, buf);
+					DX_CONTEXT.OnComplete(frameTicket, [dump, path = std::string(buf)]() mutable {
+						SaveReadbackPNG(dump, path);
+					});
 				}
 			}
 #endif
@@ -290,10 +445,135 @@ int main()
 
 			DEBUG_TIME_EXPR("ExecuteCommandList");
 
-            DX_CONTEXT.SignalAndWait();
-			DX_WINDOW.Present();
+			{
+				ScopedFrameStage stage(pacer, FrameStage::Present);
+				DX_WINDOW.Present(pacer.GetSyncInterval());
+			}
+			DX_MANAGER.AdvancePipeline(frameTicket);
+			DX_CONTEXT.EndFrame();
+
+			// GPU 쪽은 가장 바쁜 큐 기준 (큐끼리는 겹쳐 돌 수 있음)
+			pacer.SetGpuFrameMs(std::max<float>({
+				DX_CONTEXT.GetDirectTimer().GetAverageTotalMs(),
+				DX_CONTEXT.GetComputeTimer().GetAverageTotalMs(),
+				DX_CONTEXT.GetInferenceTimer().GetAverageTotalMs() }));
+			pacer.EndFrame(FramePacer::NowMs());
+			DX_CONTEXT.SetQueuedFrames(pacer.GetQueuedFrames());
+
+			// DML은 Run이 제출만 하고 돌아올 수 있어서 GPU 쪽 추론 시간도 같이 봄
+			// 재투영 프레임은 추론을 안 돌려서 값이 이전 키프레임 그대로이므로 키프레임만 샘플로 넣음
+			if (DX_MANAGER.GetTemporalReuse().IsKeyframe())
+			{
+				DX_MANAGER.UpdateInferenceScale(std::max<double>(
+					DX_ONNX.GetRunStats().lastTotalMs,
+					DX_CONTEXT.GetInferenceTimer().GetAverageTotalMs()));
+			}
 			DEBUG_TIME_EXPR("ONNX END");
 
+#if DEBUG_TIME
+			{
+				CommandPoolStats poolStats = DX_CONTEXT.GetCommandPoolStats();
+				Util::Print((float)poolStats.inFlight, (float)poolStats.createdHighWater, "CMD LISTS IN FLIGHT / ALLOC HWM");
+			}
+			{
+				const DXContext::UploadStats upload = DX_CONTEXT.GetUploadStats();
+				Util::Print((float)upload.frameBytes / 1024.0f, (float)upload.totalBytes / (1024.0f * 1024.0f), "UPLOAD KB (FRAME) / MB (TOTAL)");
+				Util::Print((float)upload.copiesInFlight, (float)upload.ringStalls, "UPLOAD COPIES IN FLIGHT / RING STALLS");
+			}
+			if (SponzaModel* sponza = DX_MANAGER.GetSponza())
+			{
+				const SponzaRecordStats& rec = sponza->GetRecordStats();
+				Util::Print(rec.totalMs, (float)rec.chunks.size(), "SPONZA RECORD MS / CHUNKS");
+				for (const SponzaRecordStats::Chunk& chunk : rec.chunks)
+				{
+					char buf[128];
+					sprintf_s(buf, "  thread %u: %u draws, %.3f ms\n", chunk.thread, chunk.draws, chunk.ms);
+					OutputDebugStringA(buf);
+				}
+			}
+			// 단계별 CPU 시간 (평균)과 페이싱 결정
+			{
+				char buf[128];
+				for (uint8_t i = 0; i < (uint8_t)FrameStage::Count; ++i)
+				{
+					const FramePacer::StageStats& stage = pacer.GetStage((FrameStage)i);
+					sprintf_s(buf, "  %s: %.3f ms (jitter %.3f)\n", FramePacer::GetStageName((FrameStage)i), stage.avgMs, stage.devMs);
+					OutputDebugStringA(buf);
+				}
+				Util::Print((float)pacer.GetFrame().avgMs, (float)pacer.GetQueuedFrames(), "FRAME MS / QUEUED FRAMES");
+			}
+			// ORT Run의 CPU 비용: Session::Run 밖(텐서/바인딩 준비)이 overhead
+			{
+				const OnnxRunnerInterface::RunStats runStats = DX_ONNX.GetRunStats();
+				char buf[192];
+				sprintf_s(buf, "ORT Run CPU (%s): %.3f ms (overhead %.3f ms, binding rebuilds %llu, IO buffers reused %llu / reallocated %llu)\n",
+					DX_ONNX.GetPrecisionName(), runStats.avgTotalMs, runStats.avgOverheadMs, (unsigned long long)runStats.bindingRebuilds,
+					(unsigned long long)runStats.bufferReuses, (unsigned long long)runStats.bufferReallocs);
+				OutputDebugStringA(buf);
+			}
+			// ORT 스레드 풀: Run 동안 프로세스 CPU 시간 / (Run 시간 x intra 스레드 수)
+			{
+				const OnnxEnvironment::Utilization util = OnnxEnvironment::GetUtilization();
+				char buf[192];
+				sprintf_s(buf, "ORT threads (%s): intra %d, inter %d, pool utilization %.0f%% (last %.0f%%), %u runners\n",
+					OnnxEnvironment::UsesGlobalPools() ? "global pools" : "per session",
+					OnnxEnvironment::GetIntraOpThreads(), OnnxEnvironment::GetInterOpThreads(),
+					util.avgUtil * 100.0, util.lastUtil * 100.0, DX_ONNX.GetLoadedRunnerCount());
+				OutputDebugStringA(buf);
+			}
+			// 동적 추론 해상도
+			if (DX_MANAGER.GetInferenceScale().IsEnabled())
+			{
+				const ResolutionController& scale = DX_MANAGER.GetInferenceScale();
+				const auto& ish = DX_ONNX.GetInputShapeContent();
+				const OnnxTileGrid& grid = DX_ONNX.GetTileGrid();
+				char buf[192];
+				if (grid.IsTiled())
+				{
+					// 타일 추론이면 입력 shape은 타일 하나
+					sprintf_s(buf, "Inference resolution: %ux%u in %ux%u tiles of %ux%u (scale %.2f, avg %.3f ms, changes %llu)\n",
+						grid.ImgW, grid.ImgH, grid.TilesX, grid.TilesY, grid.TileW, grid.TileH,
+						scale.GetScale(), scale.GetAverageMs(), (unsigned long long)scale.GetChangeCount());
+				}
+				else
+				{
+					sprintf_s(buf, "Inference resolution: %lldx%lld (scale %.2f, avg %.3f ms, changes %llu)\n",
+						ish.size() == 4 ? (long long)ish[3] : 0ll, ish.size() == 4 ? (long long)ish[2] : 0ll,
+						scale.GetScale(), scale.GetAverageMs(), (unsigned long long)scale.GetChangeCount());
+				}
+				OutputDebugStringA(buf);
+			}
+			// 시간적 재사용: 추론한 프레임 / 재투영한 프레임
+			if (DX_MANAGER.GetTemporalReuse().IsEnabled())
+			{
+				const TemporalReuse& temporal = DX_MANAGER.GetTemporalReuse();
+				char buf[160];
+				sprintf_s(buf, "Temporal reuse (K=%u): inferred %llu, reprojected %llu (camera keyframes %llu)\n",
+					temporal.GetConfig().interval, (unsigned long long)temporal.GetInferredCount(),
+					(unsigned long long)temporal.GetReusedCount(), (unsigned long long)temporal.GetMotionKeyCount());
+				OutputDebugStringA(buf);
+			}
+			// 큐별 GPU 시간 (평균). 컴퓨트 큐 합계가 직접 큐에서 빠진 만큼이 겹친 이득
+			{
+				const std::pair<const char*, GpuTimer*> timers[] = {
+					{ "DIRECT", &DX_CONTEXT.GetDirectTimer() },
+					{ "COMPUTE", &DX_CONTEXT.GetComputeTimer() },
+					{ "INFERENCE", &DX_CONTEXT.GetInferenceTimer() },
+				};
+				for (const auto& [queueName, timer] : timers)
+				{
+					char buf[128];
+					sprintf_s(buf, "GPU %s: %.3f ms\n", queueName, timer->GetAverageTotalMs());
+					OutputDebugStringA(buf);
+					for (const GpuTimer::StageStats& stage : timer->GetStages())
+					{
+						sprintf_s(buf, "  %s: %.3f ms (last %.3f)\n", stage.name, stage.avgMs, stage.lastMs);
+						OutputDebugStringA(buf);
+					}
+				}
+			}
+#endif
+
 
 		}
 	}
@@ -14,6 +14,7 @@
 #include <assert.h>
 #include <iostream>
 #include <numbers> 
+#include <algorithm>
 
 #define CAM_MOVE_SPEED 0.05f
 
@@ -23,6 +24,14 @@ extern const char* OBJ_RES_PTH;
 extern const char* OBJ_RES_NAME;
 extern const int OBJ_RES_NUM;
 extern const int MAX_FRAME;
+extern const int INFERENCE_LATENCY_FRAMES;
+extern const bool ASYNC_COMPUTE_PREPOST;
+extern const double INFERENCE_BUDGET_MS;
+extern const double INFERENCE_MIN_SCALE;
+extern const int ONNX_BATCH_SIZE;
+extern const int ONNX_TEMPORAL_INTERVAL;
+extern const double ONNX_TEMPORAL_MAX_MOVE;
+extern const double ONNX_TEMPORAL_MAX_TURN_DEG;
 
 Shader vertexShader("VertexShader.cso");
 Shader pixelShader("PixelShader.cso");
@@ -262,11 +271,12 @@ static void FillBufferWithFloat(
 	cmd->ResourceBarrier(1, &uav);
 }
 
-static bool SafeCopyBufferToReadback(
+// 񵿱 readback:  Ϸ(潺 )  onReady(bytes) ȣ
+static bool EnqueueBufferReadback(
 	ID3D12Resource* srcBuf,
 	D3D12_RESOURCE_STATES assumedState,          //  츮 ˰ ִ  ( UAV)
 	D3D12_RESOURCE_STATES restoreState,          //    ( UAV)
-	std::vector<uint8_t>& out)
+	std::function<void(const std::vector<uint8_t>&)> onReady)
 {
 	if (!srcBuf) return false;
 
@@ -301,19 +311,47 @@ static bool SafeCopyBufferToReadback(
 		cmd->ResourceBarrier(1, &barr2);
 	}
 
-	DX_CONTEXT.ExecuteCommandList();
-	DX_CONTEXT.SignalAndWait();
+	FenceTicket ticket = DX_CONTEXT.Submit();
+	if (!ticket.IsValid()) return false;
 
-	// 3) Read back
-	out.resize((size_t)d.Width);
-	void* p = nullptr;
-	D3D12_RANGE r{ 0, (SIZE_T)d.Width };
-	if (SUCCEEDED(rb->Map(0, &r, &p)) && p) {
-		memcpy(out.data(), p, (size_t)d.Width);
-		rb->Unmap(0, nullptr);
-		return true;
+	// 3) Read back (GPU Ϸ  ȣ, rb ݹ )
+	const UINT64 width = d.Width;
+	DX_CONTEXT.OnComplete(ticket, [rb, width, onReady]() mutable {
+		std::vector<uint8_t> out((size_t)width);
+		void* p = nullptr;
+		D3D12_RANGE r{ 0, (SIZE_T)width };
+		if (SUCCEEDED(rb->Map(0, &r, &p)) && p) {
+			memcpy(out.data(), p, (size_t)width);
+			rb->Unmap(0, nullptr);
+			onReady(out);
+		}
+	});
+	return true;
+}
+
+static void PrintFloatStats(const std::string& tag, const std::vector<uint8_t>& bytes)
+{
+	const float* f = reinterpret_cast<const float*>(bytes.data());
+	const size_t n = bytes.size() / sizeof(float);
+	if (!n) return;
+
+	float mn = +1e9f, mx = -1e9f;
+	for (size_t i = 0; i < n; ++i) { mn = (mn < f[i] ? mn : f[i]); mx = (mx > f[i] ? mx : f[i]); }
+
+	char buf[512];
+	char buf2[512];
+	int k = (int)std::min<size_t>(16, n);
+	std::string first;
+	for (int i = 0; i < k; ++i) 
+	{ 
+		char t[64]; 
+		sprintf_s(t, " %.5f", f[i]); 
+		first += t; 
 	}
-	return false;
+	sprintf_s(buf, "[%s] ", tag.c_str());
+	sprintf_s(buf2, "n=%llu  min=%.6f  max=%.6f  first16:%s\n", (unsigned long long)n, mn, mx, first.c_str());
+	OutputDebugStringA(buf);
+	OutputDebugStringA(buf2);
 }
 
 extern DirectX::XMMATRIX MakeLightViewProj(const ShadowCamera& L, const DirectX::XMFLOAT3& focusWorld)
@@ -569,6 +607,12 @@ bool DirectXManager::Init()
 		}
 	}
 
+	InitPipelineSlots();
+	InitInferenceScale();
+	InitTemporalReuse();
+	m_AsyncCompute = ASYNC_COMPUTE_PREPOST && DX_CONTEXT.GetComputeQueue();
+	ResetPipeline();
+
 	DX_INPUT.InitWalk(OBJ_RES_NUM);
 
 	m_Sponza = std::make_unique<SponzaModel>();
@@ -622,10 +666,15 @@ bool DirectXManager::Init()
 			m_CubePSO, m_CubeRootSig, Ooptions);
 	}
 
+	// ð    SRV Ƿ ONNX ҽ 
+	InitDepth(w, h);
 	CreateOnnxResources(w, h);
 
 	// ҽ  ʱȭ
-	m_SceneColorState = D3D12_RESOURCE_STATE_RENDER_TARGET;
+	for (UINT i = 0; i < m_PipelineSlots; ++i)
+	{
+		m_SceneColorState[i] = D3D12_RESOURCE_STATE_RENDER_TARGET;
+	}
 
 	m_Vbv1 = DirectXManager::GetVertexBufferView(
 		m_RenderingObject1->GetVertexBuffer(),
@@ -634,7 +683,6 @@ bool DirectXManager::Init()
 		m_RenderingObject2->GetVertexBuffer(),
 		m_RenderingObject2->GetVertexCount(), sizeof(Vertex));
 
-	InitDepth(w, h);
 	m_Aspect = (float)w / (float)h;
 
 	if (OBJ_RES_NUM == RES_SPONZA)
@@ -794,12 +842,17 @@ void DirectXManager::UploadGPUResource(ID3D12GraphicsCommandList7* cmdList)
 		return;
 	}
 
+	//  ؽó ε  ť ġ ϳ  (ε   ⵵ )
+	DX_CONTEXT.BeginUploadBatch();
+
 	m_Sponza->UploadGPUResource(cmdList);
 	m_RenderingObject1->UploadGPUResource(cmdList);
 	m_RenderingObject2->UploadGPUResource(cmdList);
 	m_StyleObject->UploadGPUResource(cmdList);
 	m_PlaneObject->UploadGPUResource(cmdList);
 	m_CubeObject->UploadGPUResource(cmdList);
+
+	DX_CONTEXT.EndUploadBatch();
 }
 
 
@@ -810,6 +863,9 @@ void DirectXManager::CreateOnnxResources(UINT W, UINT H)
 		return;
 	}
 
+	//  Է  ػ ũ, OnnxTex(ó ) W,H ״
+	GetInferenceSize(W, H, m_InferW, m_InferH);
+
 	switch (DX_ONNX.GetOnnxType())
 	{
 	case OnnxType::Sanet:
@@ -818,11 +874,12 @@ void DirectXManager::CreateOnnxResources(UINT W, UINT H)
 	{
 		OnnxService::CreateOnnxResources_AdaIN(
 			W, H,
+			m_InferW, m_InferH,
 			*m_StyleObject->GetImage().get(),
 			m_Onnx.get(),
 			m_OnnxGPU.get(),
 			mHeapCPU.Get(),
-			mSceneColor.Get(),
+			mSceneColor[0].Get(),
 			m_OnnxTexState,
 			m_OnnxInputState);
 	}
@@ -831,13 +888,21 @@ void DirectXManager::CreateOnnxResources(UINT W, UINT H)
 	case OnnxType::FastNeuralStyle:
 	case OnnxType::ReCoNet:
 	{
+		ID3D12Resource2* sceneColors[ONNX_MAX_PIPELINE_SLOTS] = {};
+		for (UINT i = 0; i < m_PipelineSlots; ++i)
+		{
+			sceneColors[i] = mSceneColor[i].Get();
+		}
+
 		OnnxService::CreateOnnxResources_FastNeuralStyle(
 			W, H, 
+			m_InferW, m_InferH,
 			*m_StyleObject->GetImage().get(),
 			m_Onnx.get(), 
 			m_OnnxGPU.get(), 
 			mHeapCPU.Get(), 
-			mSceneColor.Get(),
+			sceneColors,
+			m_PipelineSlots,
 			m_OnnxTexState,
 			m_OnnxInputState);
 	}
@@ -847,10 +912,43 @@ void DirectXManager::CreateOnnxResources(UINT W, UINT H)
 		break;
 	}
 
-	
+	// OnnxTex  Ƿ 丮  (  Ű)
+	if (m_Temporal.IsEnabled())
+	{
+		OnnxService::CreateTemporalResources(W, H, m_Depth.Get(), m_Onnx.get(), m_OnnxGPU.get());
+		m_Temporal.Invalidate();
+	}
 }
 
 void DirectXManager::RecordPreprocess(ID3D12GraphicsCommandList7* cmd)
+{
+	//   ߷ 
+	if (m_Temporal.IsKeyframe() == false)
+	{
+		return;
+	}
+
+	if (m_AsyncCompute)
+	{
+		// ó RunInference ǻƮ ť . ǻƮ Ʈ  ϴ ̸ ⼭
+		switch (DX_ONNX.GetOnnxType())
+		{
+			case OnnxType::Sanet:
+			case OnnxType::WCT2:
+			case OnnxType::AdaIN:
+				OnnxService::PrepareStyleForCompute_AdaIN(cmd, *m_StyleObject->GetImage().get());
+				break;
+		}
+		return;
+	}
+
+	GpuTimer& timer = DX_CONTEXT.GetDirectTimer();
+	const UINT span = timer.Begin(cmd, "Preprocess");
+	RecordPreprocessPass(cmd, GetSceneSlot(), GetSceneSlice());
+	timer.End(cmd, span);
+}
+
+void DirectXManager::RecordPreprocessPass(ID3D12GraphicsCommandList7* cmd, UINT slot, UINT slice)
 {
 	switch (DX_ONNX.GetOnnxType())
 	{
@@ -863,7 +961,7 @@ void DirectXManager::RecordPreprocess(ID3D12GraphicsCommandList7* cmd)
 				m_OnnxGPU->m_Heap.Get(),
 				m_Onnx.get(),
 				m_OnnxGPU.get(), 
-				mSceneColor.Get(),
+				mSceneColor[slot].Get(),
 				*m_StyleObject->GetImage().get());
 		}
 		break;
@@ -876,14 +974,64 @@ void DirectXManager::RecordPreprocess(ID3D12GraphicsCommandList7* cmd)
 				m_OnnxGPU->m_Heap.Get(),
 				m_Onnx.get(),
 				m_OnnxGPU.get(), 
-				mSceneColor.Get(),
-				*m_StyleObject->GetImage().get());
+				mSceneColor[slot].Get(),
+				*m_StyleObject->GetImage().get(),
+				slot,
+				slice);
 		}
 		break;
 	}
 }
 
 void DirectXManager::RecordPostprocess(ID3D12GraphicsCommandList7* cmd)
+{
+	UINT slot = 0, slice = 0;
+	if (GetPostSlot(slot, slice) == false)
+	{
+		// ä ߿ ó   ó  ٸ .
+		//    SceneColor   ǻƮ ť ó  ٸ
+		if (m_AsyncCompute && m_PreTicket.IsValid())
+		{
+			DX_CONTEXT.WaitForCompute(m_PreTicket);
+		}
+		return;
+	}
+
+	//  :  ť 丮 -> OnnxTex ( ó/ ̹  ť ʿ )
+	if (m_Temporal.IsKeyframe() == false)
+	{
+		RecordTemporalPass(cmd, false);
+		return;
+	}
+
+	if (m_AsyncCompute)
+	{
+		//  0̸ ߷  Ƿ ó  
+		if (m_PostSubmitted == false)
+		{
+			SubmitPostprocessCompute();
+		}
+		//  ǻƮ ť ó GPU 
+		DX_CONTEXT.WaitForCompute(m_PostTicket);
+	}
+	else
+	{
+		//   ߷    ť GPU  (CPU  )
+		DX_CONTEXT.WaitForInference(m_InferenceTickets[slot]);
+
+		GpuTimer& timer = DX_CONTEXT.GetDirectTimer();
+		const UINT span = timer.Begin(cmd, "Postprocess");
+		RecordPostprocessPass(cmd, slot, slice);
+		timer.End(cmd, span);
+	}
+
+	if (m_Temporal.IsEnabled())
+	{
+		RecordTemporalPass(cmd, true);
+	}
+}
+
+void DirectXManager::RecordPostprocessPass(ID3D12GraphicsCommandList7* cmd, UINT slot, UINT slice)
 {
 	switch (DX_ONNX.GetOnnxType())
 	{
@@ -898,13 +1046,171 @@ void DirectXManager::RecordPostprocess(ID3D12GraphicsCommandList7* cmd)
 		case OnnxType::FastNeuralStyle:
 		case OnnxType::ReCoNet:
 		{
-			OnnxService::RecordPostprocess_FastNeuralStyle(cmd, m_OnnxGPU->m_Heap.Get(), m_Onnx.get(), m_OnnxGPU.get(), m_OnnxTexState);
+			OnnxService::RecordPostprocess_FastNeuralStyle(cmd, m_OnnxGPU->m_Heap.Get(), m_Onnx.get(), m_OnnxGPU.get(), m_OnnxTexState, slot, slice);
 		}
 		break;
 
 	}
 }
 
+FenceTicket DirectXManager::SubmitPreprocessCompute(FenceTicket sceneTicket, UINT slot, UINT slice)
+{
+	DXContext::CommandContext* ctx = DX_CONTEXT.AcquireComputeContext();
+	if (ctx == nullptr)
+	{
+		return {};
+	}
+
+	GpuTimer& timer = DX_CONTEXT.GetComputeTimer();
+	const UINT span = timer.Begin(ctx->list, "Preprocess");
+	RecordPreprocessPass(ctx->list, slot, slice);
+	timer.End(ctx->list, span);
+
+	//  N SceneColor    
+	return DX_CONTEXT.SubmitCompute(ctx, sceneTicket, {});
+}
+
+void DirectXManager::SubmitPostprocessCompute()
+{
+	m_PostSubmitted = true;
+
+	UINT slot = 0, slice = 0;
+	if (GetPostSlot(slot, slice) == false)
+	{
+		return;
+	}
+
+	DXContext::CommandContext* ctx = DX_CONTEXT.AcquireComputeContext();
+	if (ctx == nullptr)
+	{
+		return;
+	}
+
+	GpuTimer& timer = DX_CONTEXT.GetComputeTimer();
+	const UINT span = timer.Begin(ctx->list, "Postprocess");
+	RecordPostprocessPass(ctx->list, slot, slice);
+	timer.End(ctx->list, span);
+
+	//    OnnxTex  а(UAV ǵ )   ߷   
+	m_PostTicket = DX_CONTEXT.SubmitCompute(ctx, m_BlitTicket, m_InferenceTickets[slot]);
+}
+
+void DirectXManager::RunInference(FenceTicket sceneTicket)
+{
+	if (m_Temporal.IsKeyframe() == false)
+	{
+		return;
+	}
+
+	const UINT slot = GetSceneSlot();
+	const UINT slice = GetSceneSlice();
+
+	FenceTicket preTicket{};
+	if (m_AsyncCompute)
+	{
+		//     ó ó N  ־   ٸ .
+		// ġ    SceneColor ׸Ƿ ó() ó ڿ ; 
+		if (GetInferenceLatency() > 0 && m_BatchSize == 1)
+		{
+			SubmitPostprocessCompute();
+		}
+		preTicket = SubmitPreprocessCompute(sceneTicket, slot, slice);
+		m_PreTicket = preTicket;
+	}
+
+	// ġ   ó     ߷
+	if (slice + 1 < m_BatchSize)
+	{
+		return;
+	}
+
+	// ߷ ť   ó( Ǵ ǻƮ ť) GPU ٸ  .
+	// DML EP Run    ۾ ť ϹǷ ٷ  Signal  Run 
+	if (preTicket.IsValid())
+	{
+		DX_CONTEXT.InferenceWaitForCompute(preTicket);
+	}
+	else
+	{
+		DX_CONTEXT.InferenceWaitFor(sceneTicket);
+	}
+
+	GpuTimer& timer = DX_CONTEXT.GetInferenceTimer();
+	const UINT span = timer.BeginOnQueue("Inference");
+	DX_ONNX.Run(slot);
+	timer.EndOnQueue(span);
+	m_InferenceTickets[slot] = DX_CONTEXT.SignalInference();
+}
+
+void DirectXManager::AdvancePipeline(FenceTicket blitTicket)
+{
+	m_BlitTicket = blitTicket;
+	m_PostSubmitted = false;
+	++m_PipelineFrame;
+}
+
+void DirectXManager::InitPipelineSlots()
+{
+	// ߷   (ʰ   1 =  )
+	m_PipelineSlots = 1;
+	m_BatchSize = 1;
+	if (DX_ONNX.IsInitialized() == false)
+	{
+		return;
+	}
+
+	// ð  ̹  ī޶ ϹǷ   ( 1, ġ )
+	if (ONNX_TEMPORAL_INTERVAL > 1)
+	{
+		m_BatchSize = DX_ONNX.SetBatchSize(1);
+		m_PipelineSlots = DX_ONNX.SetPipelineSlotCount(1);
+		return;
+	}
+
+	// ġ:  A B     B  ǥϹǷ  2 ʿ
+	// (N  ̸ ʰ   )
+	const int batch = std::clamp<int>(ONNX_BATCH_SIZE, 1, (int)ONNX_MAX_BATCH);
+	m_BatchSize = DX_ONNX.SetBatchSize((UINT)batch);
+	if (m_BatchSize > 1)
+	{
+		m_PipelineSlots = DX_ONNX.SetPipelineSlotCount(2);
+		if (m_PipelineSlots >= 2)
+		{
+			return;
+		}
+		m_BatchSize = DX_ONNX.SetBatchSize(1);
+	}
+
+	const int latency = std::clamp<int>(INFERENCE_LATENCY_FRAMES, 0, (int)ONNX_MAX_PIPELINE_SLOTS - 1);
+	m_PipelineSlots = DX_ONNX.SetPipelineSlotCount((UINT)latency + 1);
+}
+
+void DirectXManager::ResetPipeline()
+{
+	m_PipelineFrame = 0;
+	for (FenceTicket& ticket : m_InferenceTickets)
+	{
+		ticket = {};
+	}
+	m_PostSubmitted = false;
+	m_PostTicket = {};
+	m_PreTicket = {};
+	m_Temporal.Invalidate();
+}
+
+bool DirectXManager::GetPostSlot(UINT& slot, UINT& slice) const
+{
+	const UINT64 latency = GetInferenceLatency();
+	if (m_PipelineFrame < latency)
+	{
+		return false;
+	}
+	const UINT64 frame = m_PipelineFrame - latency;
+	slot = (UINT)((frame / m_BatchSize) % m_PipelineSlots);
+	slice = (UINT)(frame % m_BatchSize);
+	return true;
+}
+
 void DirectXManager::CreateFullscreenQuadVB(UINT w, UINT h)
 {
 	struct Vtx2 { float x, y, u, v; };
@@ -927,34 +1233,8 @@ void DirectXManager::CreateFullscreenQuadVB(UINT w, UINT h)
 		&hpDefault, D3D12_HEAP_FLAG_NONE, &desc,
 		D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&mFSQuadVB)));
 
-	// Upload
-	ComPointer<ID3D12Resource> upload;
-	CD3DX12_HEAP_PROPERTIES hpUpload(D3D12_HEAP_TYPE_UPLOAD);
-	(dev->CreateCommittedResource(
-		&hpUpload, D3D12_HEAP_FLAG_NONE, &desc,
-		D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&upload)));
-
-	// ε ۿ  ֱ
-	{
-		void* p = nullptr;
-		D3D12_RANGE r{ 0,0 };
-		(upload->Map(0, &r, &p));
-		std::memcpy(p, quad, vbSize);
-		upload->Unmap(0, nullptr);
-	}
-
-	// GPU  +  
-	ID3D12GraphicsCommandList7* cmd = DX_CONTEXT.InitCommandList();
-	cmd->CopyBufferRegion(mFSQuadVB.Get(), 0, upload.Get(), 0, vbSize);
-
-	auto toVB = CD3DX12_RESOURCE_BARRIER::Transition(
-		mFSQuadVB.Get(),
-		D3D12_RESOURCE_STATE_COPY_DEST,
-		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER
-	);
-	cmd->ResourceBarrier(1, &toVB);
-
-	DX_CONTEXT.ExecuteCommandList();  
+	//  ť ε (  ),  direct  GPU  ϷḦ ٸ
+	DX_CONTEXT.WaitForCopy(DX_CONTEXT.UploadBuffer(mFSQuadVB.Get(), quad, vbSize));
 
 	// VBV
 	m_FSQuadVBV.BufferLocation = mFSQuadVB->GetGPUVirtualAddress();
@@ -1016,62 +1296,24 @@ bool DirectXManager::CreateSimpleBlitPipeline()
 
 void DirectXManager::Debug_DumpOrtOutput(ID3D12GraphicsCommandList7* cmd)
 {
-	DX_CONTEXT.ExecuteCommandList();
-	DX_CONTEXT.SignalAndWait();
+	//   Ʈ  (ť  readback  )
+	DX_CONTEXT.Submit();
 
 	// ONNX Run() Ŀ  ۰  UAV ٰ 
-	std::vector<uint8_t> bytes;
-	if (!SafeCopyBufferToReadback(DX_ONNX.GetOutputBuffer().Get(),
+	EnqueueBufferReadback(DX_ONNX.GetOutputBuffer().Get(),
 		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
 		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-		bytes)) return;
-
-	const float* f = reinterpret_cast<const float*>(bytes.data());
-	const size_t n = bytes.size() / sizeof(float);
-	if (!n) return;
-
-	float mn = +1e9f, mx = -1e9f;
-	for (size_t i = 0; i < n; ++i) { mn = (mn < f[i] ? mn : f[i]); mx = (mx > f[i] ? mx : f[i]); }
-
-	char buf[512];
-	int k = (int)std::min<size_t>(16, n);
-	std::string first;
-	for (int i = 0; i < k; ++i) { char t[32]; sprintf_s(t, " %.5f", f[i]); first += t; }
-	sprintf_s(buf, "[ORT OUT SAFE] n=%llu  min=%.6f  max=%.6f  first16:%s\n",
-		(unsigned long long)n, mn, mx, first.c_str());
-	OutputDebugStringA(buf);
+		[](const std::vector<uint8_t>& bytes) { PrintFloatStats("ORT OUT SAFE", bytes); });
 }
 
 void DirectXManager::Debug_DumpBuffer(ID3D12Resource* src, const char* tag)
 {
 	if (!src) return;
-	std::vector<uint8_t> bytes;
-	if (!SafeCopyBufferToReadback(src,
+	std::string tagStr = tag ? tag : "";
+	EnqueueBufferReadback(src,
 		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
 		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-		bytes)) return;
-
-	const float* f = reinterpret_cast<const float*>(bytes.data());
-	const size_t n = bytes.size() / sizeof(float);
-	if (!n) return;
-
-	float mn = +1e9f, mx = -1e9f;
-	for (size_t i = 0; i < n; ++i) { mn = (mn < f[i] ? mn : f[i]); mx = (mx > f[i] ? mx : f[i]); }
-
-	char buf[512];
-	char buf2[512];
-	int k = (int)std::min<size_t>(16, n);
-	std::string first;
-	for (int i = 0; i < k; ++i) 
-	{ 
-		char t[64]; 
-		sprintf_s(t, " %.5f", f[i]); 
-		first += t; 
-	}
-	sprintf_s(buf, "[%s] ", tag);
-	sprintf_s(buf2, "n=%llu  min=%.6f  max=%.6f  first16:%s\n", (unsigned long long)n, mn, mx, first.c_str());
-	OutputDebugStringA(buf);
-	OutputDebugStringA(buf2);
+		[tagStr](const std::vector<uint8_t>& bytes) { PrintFloatStats(tagStr, bytes); });
 }
 
 bool DirectXManager::InitCubePipeline()
@@ -1134,7 +1376,7 @@ bool DirectXManager::InitCubePipeline()
 	pso.DepthStencilState.DepthEnable = TRUE;
 	pso.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
 	pso.NumRenderTargets = 1;
-	pso.RTVFormats[0] = mSceneColor ? mSceneColor->GetDesc().Format : DXGI_FORMAT_R8G8B8A8_UNORM; //  
+	pso.RTVFormats[0] = mSceneColor[0] ? mSceneColor[0]->GetDesc().Format : DXGI_FORMAT_R8G8B8A8_UNORM; //  
 	pso.DSVFormat = DXGI_FORMAT_D32_FLOAT;
 	pso.SampleDesc = { 1,0 };
 	pso.SampleMask = UINT_MAX;
@@ -1161,7 +1403,8 @@ bool DirectXManager::InitDepth(UINT w, UINT h)
 	optClear.Format = DXGI_FORMAT_D32_FLOAT;
 	optClear.DepthStencil = { 1.0f, 0 };
 
-	CD3DX12_RESOURCE_DESC rd = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_D32_FLOAT, w, h, 1, 1);
+	// ð  R32_FLOAT SRV Ƿ typeless (DSV D32_FLOAT)
+	CD3DX12_RESOURCE_DESC rd = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R32_TYPELESS, w, h, 1, 1);
 	rd.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
 
 	CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);
@@ -1391,7 +1634,16 @@ void DirectXManager::ResizeOnnxResources(UINT W, UINT H)
 {
 	if (m_Onnx != nullptr && m_OnnxGPU != nullptr)
 	{
-		if (W == m_Onnx->m_Width && H == m_Onnx->m_Height) return;
+		if (W == m_Onnx->m_Width && H == m_Onnx->m_Height)
+		{
+			// ũ Ƶ  ۴  Ƿ 丮   SRV ٽ 
+			if (m_Temporal.IsEnabled())
+			{
+				OnnxService::CreateTemporalResources(W, H, m_Depth.Get(), m_Onnx.get(), m_OnnxGPU.get());
+				m_Temporal.Invalidate();
+			}
+			return;
+		}
 		m_OnnxGPU->Reset();
 
 		ID3D12Resource* styleTex = m_StyleObject->GetImage()->GetTexture();
@@ -1399,7 +1651,9 @@ void DirectXManager::ResizeOnnxResources(UINT W, UINT H)
 		UINT styleW = (UINT)sDesc.Width;
 		UINT styleH = sDesc.Height;
 
-		DX_ONNX.ResizeIO(DX_CONTEXT.GetDevice(), W, H, styleW, styleH);
+		UINT inferW, inferH;
+		GetInferenceSize(W, H, inferW, inferH);
+		DX_ONNX.ResizeIO(DX_CONTEXT.GetDevice(), inferW, inferH, styleW, styleH);
 
 		CreateOnnxResources(W, H);
 		m_Onnx->m_Width = W; m_Onnx->m_Height = H;
@@ -1413,6 +1667,141 @@ void DirectXManager::ResizeOnnxResources(UINT W, UINT H)
 
 }
 
+void DirectXManager::RebindOnnx()
+{
+	if (DX_ONNX.IsInitialized() == false)
+	{
+		return;
+	}
+
+	//   IO Ű ũ/OnnxTex    (ȣ  Flush ʿ)
+	if (m_OnnxGPU != nullptr)
+	{
+		m_OnnxGPU->Reset();
+	}
+	m_Onnx = std::make_unique<OnnxPassResources>();
+	m_OnnxGPU = std::make_unique<OnnxGPUResources>();
+
+	UINT w, h;
+	DX_WINDOW.GetBackbufferSize(w, h);
+
+	// ʸ ϴ   ٸ: ٲ Ժ  Ÿ굵 ٽ 
+	const UINT prevSlots = m_PipelineSlots;
+	InitPipelineSlots();
+	if (m_PipelineSlots != prevSlots)
+	{
+		DestroyOffscreen();
+		CreateOffscreen(w, h);
+	}
+
+	// 𵨸  ޶  ػ󵵴 ó(ü ũ) ٽ 
+	InitInferenceScale();
+	InitTemporalReuse();
+	CreateOnnxResources(w, h);
+	ResetPipeline();
+}
+
+void DirectXManager::InitInferenceScale()
+{
+	ResolutionController::Config config;
+	// ġ ߰ ũ⸦ ٲٸ   Ƿ ġ 
+	config.budgetMs = DX_ONNX.IsInputResizable() && m_BatchSize == 1 ? INFERENCE_BUDGET_MS : 0.0;
+	config.minScale = INFERENCE_MIN_SCALE;
+	m_InferScale.Reset(config);
+}
+
+void DirectXManager::GetInferenceSize(UINT W, UINT H, UINT& outW, UINT& outH) const
+{
+	const double scale = m_InferScale.GetScale();
+	outW = (UINT)std::max<int>(OnnxRunnerInterface::AlignDown8((int)(W * scale)), 8);
+	outH = (UINT)std::max<int>(OnnxRunnerInterface::AlignDown8((int)(H * scale)), 8);
+}
+
+void DirectXManager::InitTemporalReuse()
+{
+	// ġ ̹   ʰ        
+	TemporalReuse::Config config;
+	config.interval = m_PipelineSlots == 1 && m_BatchSize == 1 ? (uint32_t)std::max<int>(ONNX_TEMPORAL_INTERVAL, 1) : 1;
+	config.maxMove = ONNX_TEMPORAL_MAX_MOVE;
+	config.maxTurnDeg = ONNX_TEMPORAL_MAX_TURN_DEG;
+	m_Temporal.Reset(config);
+}
+
+void DirectXManager::UpdateTemporalReuse()
+{
+	if (m_Temporal.IsEnabled() == false || m_OnnxGPU == nullptr || !m_OnnxGPU->m_HistoryTex)
+	{
+		return;
+	}
+
+	XMStoreFloat4x4(&m_FrameViewProj, MakeVP_Dir(m_Cam, m_Aspect));
+	if (m_Temporal.ShouldInfer(&m_Cam.pos.x, &m_Cam.dir.x))
+	{
+		m_KeyViewProj = m_FrameViewProj;
+	}
+}
+
+void DirectXManager::BuildTemporalConstants(TemporalCBData& out) const
+{
+	// ٸ ̴  Ģ: ġؼ ѱ  켱 cbuffer  ķ ,
+	// DirectXMath   Ģ ״ ̴ mul(v, M) 
+	const XMMATRIX vp = XMLoadFloat4x4(&m_FrameViewProj);
+	XMStoreFloat4x4((XMFLOAT4X4*)out.CurInvViewProj, XMMatrixTranspose(XMMatrixInverse(nullptr, vp)));
+	XMStoreFloat4x4((XMFLOAT4X4*)out.KeyViewProj, XMMatrixTranspose(XMLoadFloat4x4(&m_KeyViewProj)));
+
+	out.W = m_Onnx->m_Width;
+	out.H = m_Onnx->m_Height;
+	out.NearZ = m_Cam.nearZ;
+	out.FarZ = m_Cam.farZ;
+	out.DepthTolerance = 0.05f;		// þ  5%  ǥ
+	out.FillRadius = 8.0f;			//   ä  ã ݰ (ȼ)
+}
+
+void DirectXManager::RecordTemporalPass(ID3D12GraphicsCommandList7* cmd, bool keyframe)
+{
+	TemporalCBData cb{};
+	BuildTemporalConstants(cb);
+
+	GpuTimer& timer = DX_CONTEXT.GetDirectTimer();
+	const UINT span = timer.Begin(cmd, keyframe ? "TemporalHistory" : "TemporalReproject");
+	if (keyframe)
+	{
+		OnnxService::RecordHistory_Temporal(cmd, m_Onnx.get(), m_OnnxGPU.get(), m_Depth.Get(), m_OnnxTexState, cb);
+	}
+	else
+	{
+		OnnxService::RecordReproject_Temporal(cmd, m_Onnx.get(), m_OnnxGPU.get(), m_Depth.Get(), m_OnnxTexState, cb);
+	}
+	timer.End(cmd, span);
+}
+
+void DirectXManager::UpdateInferenceScale(double runMs)
+{
+	if (m_Onnx == nullptr || m_OnnxGPU == nullptr || m_InferScale.AddSample(runMs) == false)
+	{
+		return;
+	}
+
+	//  ũⰡ  Ҵ  
+	UINT inferW, inferH;
+	GetInferenceSize(m_Onnx->m_Width, m_Onnx->m_Height, inferW, inferH);
+	if (inferW == m_InferW && inferH == m_InferH)
+	{
+		return;
+	}
+
+	char buf[160];
+	sprintf_s(buf, "[DirectXManager] inference resolution %ux%u -> %ux%u (scale %.2f, avg %.2f ms)\n",
+		m_InferW, m_InferH, inferW, inferH, m_InferScale.GetScale(), m_InferScale.GetAverageMs());
+	OutputDebugStringA(buf);
+
+	// Ը   ó/߷/ó IO ۸    
+	DX_CONTEXT.Flush(DXWindow::GetFrameCount());
+	m_OnnxGPU->Reset();
+	CreateOnnxResources(m_Onnx->m_Width, m_Onnx->m_Height);
+	ResetPipeline();
+}
+
 bool DirectXManager::CreateOnnxComputePipeline()
 {
 	ID3D12Device* device = DX_CONTEXT.GetDevice();
@@ -1446,11 +1835,16 @@ bool DirectXManager::CreateOnnxComputePipeline()
 		IID_PPV_ARGS(&m_Onnx->m_PreRS));
 	if (FAILED(hr)) return false;
 
-	// CS compile
+	// CS compile (fp16 ̸ ټ ۸ half 2  uint а  )
+	const D3D_SHADER_MACRO tensorDefines[] =
+	{
+		{ "TENSOR_FP16", DX_ONNX.IsTensorFp16() ? "1" : "0" },
+		{ nullptr, nullptr }
+	};
 	ComPointer<ID3DBlob> csPre, csPost;
-	hr = D3DCompileFromFile(L"./Shaders/cs_preprocess.hlsl", nullptr, nullptr, "main", "cs_5_0", 0, 0, &csPre, &errBlob);
+	hr = D3DCompileFromFile(L"./Shaders/cs_preprocess.hlsl", tensorDefines, nullptr, "main", "cs_5_0", 0, 0, &csPre, &errBlob);
 	if (FAILED(hr) || !csPre)  return false;
-	hr = D3DCompileFromFile(L"./Shaders/cs_postprocess.hlsl", nullptr, nullptr, "main", "cs_5_0", 0, 0, &csPost, &errBlob);
+	hr = D3DCompileFromFile(L"./Shaders/cs_postprocess.hlsl", tensorDefines, nullptr, "main", "cs_5_0", 0, 0, &csPost, &errBlob);
 	if (FAILED(hr) || !csPost) return false;
 
 	// PSO(pre)
@@ -1480,29 +1874,37 @@ void DirectXManager::Resize()
 	DX_WINDOW.GetBackbufferSize(w, h);
 	CreateOffscreen(w, h);
 	CreateFullscreenQuadVB(w, h);
+	// ð    SRV     Ƿ  ۰ 
+	InitDepth(w, h);
 	ResizeOnnxResources(w, h);
+	ResetPipeline();
 
 	m_Aspect = (h == 0) ? m_Aspect : (float)w / (float)h;
-	InitDepth(w, h);
 }
 
-void DirectXManager::RenderOffscreen(ID3D12GraphicsCommandList7* cmd)
+void DirectXManager::RenderOffscreen(ID3D12GraphicsCommandList7*& cmd)
 {
+	// ̹  ߷ (ó/߷/ó   )
+	UpdateTemporalReuse();
+
 	 //  ȼ̴ SRV ·
 	TransitionShadowToDSV(cmd);
 	RenderShadowPass(cmd);
 	TransitionShadowToSRV(cmd);
 
+	// ̹   
+	const UINT slot = GetSceneSlot();
+
 	// SceneColor  RTV
-	if (m_SceneColorState != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-		auto b = CD3DX12_RESOURCE_BARRIER::Transition(mSceneColor.Get(), m_SceneColorState, D3D12_RESOURCE_STATE_RENDER_TARGET);
+	if (m_SceneColorState[slot] != D3D12_RESOURCE_STATE_RENDER_TARGET) {
+		auto b = CD3DX12_RESOURCE_BARRIER::Transition(mSceneColor[slot].Get(), m_SceneColorState[slot], D3D12_RESOURCE_STATE_RENDER_TARGET);
 		cmd->ResourceBarrier(1, &b);
-		m_SceneColorState = D3D12_RESOURCE_STATE_RENDER_TARGET;
+		m_SceneColorState[slot] = D3D12_RESOURCE_STATE_RENDER_TARGET;
 	}
 
 	const FLOAT clear[4] = { 0.6f ,0.65f, 0.9f, 1 };
-	cmd->OMSetRenderTargets(1, &m_RtvScene, FALSE, nullptr);
-	cmd->ClearRenderTargetView(m_RtvScene, clear, 0, nullptr);
+	cmd->OMSetRenderTargets(1, &m_RtvScene[slot], FALSE, nullptr);
+	cmd->ClearRenderTargetView(m_RtvScene[slot], clear, 0, nullptr);
 
 	auto vp = DX_WINDOW.CreateViewport();
 	auto sc = DX_WINDOW.CreateScissorRect();
@@ -1517,7 +1919,7 @@ void DirectXManager::RenderOffscreen(ID3D12GraphicsCommandList7* cmd)
 	const UINT inc = dev->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
 	if (m_Sponza) {
-		m_Sponza->Render(cmd, m_Cam, m_Aspect, m_RtvScene, m_DSV);
+		m_Sponza->Render(cmd, m_Cam, m_Aspect, m_RtvScene[slot], m_DSV);
 	}
 
 	{
@@ -1532,9 +1934,9 @@ void DirectXManager::RenderOffscreen(ID3D12GraphicsCommandList7* cmd)
 
 	{
 		auto b = CD3DX12_RESOURCE_BARRIER::Transition(
-			mSceneColor.Get(), m_SceneColorState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+			mSceneColor[slot].Get(), m_SceneColorState[slot], D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 		cmd->ResourceBarrier(1, &b);
-		m_SceneColorState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+		m_SceneColorState[slot] = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
 	}
 }
 
@@ -1542,6 +1944,9 @@ void DirectXManager::RenderOffscreen(ID3D12GraphicsCommandList7* cmd)
 
 void DirectXManager::BlitToBackbuffer(ID3D12GraphicsCommandList7* cmd)
 {
+	GpuTimer& timer = DX_CONTEXT.GetDirectTimer();
+	const UINT span = timer.Begin(cmd, "Blit");
+
 	if (m_OnnxTexState != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
 		auto b = CD3DX12_RESOURCE_BARRIER::Transition(
 			m_OnnxGPU->m_OnnxTex.Get(), m_OnnxTexState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
@@ -1568,6 +1973,17 @@ void DirectXManager::BlitToBackbuffer(ID3D12GraphicsCommandList7* cmd)
 
 	cmd->IASetVertexBuffers(0, 0, nullptr);
 	cmd->DrawInstanced(3, 1, 0, 0);
+
+	//  ó ǻƮ ť Ƿ (PSR ǻƮ Ʈ  Ұ) ⼭ UAV 
+	if (m_AsyncCompute)
+	{
+		auto b = CD3DX12_RESOURCE_BARRIER::Transition(
+			m_OnnxGPU->m_OnnxTex.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		cmd->ResourceBarrier(1, &b);
+		m_OnnxTexState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+	}
+
+	timer.End(cmd, span);
 }
 
 
@@ -1661,6 +2077,9 @@ void DirectXManager::InitUploadRenderingObject()
 
 void DirectXManager::InitGeometry()
 {
+	// ٴ + ť VB/IB   
+	DX_CONTEXT.BeginUploadBatch();
+
 	{
 		const float H = 50.0f;
 		const float tile = 10.0f;
@@ -1700,6 +2119,8 @@ void DirectXManager::InitGeometry()
 		};
 		m_CubeObject->InitGeometry(v, sizeof(v), idx, sizeof(idx), (UINT)_countof(idx));
 	}
+
+	DX_CONTEXT.EndUploadBatch();
 }
 
 void DirectXManager::InitShader()
@@ -1717,8 +2138,8 @@ void DirectXManager::InitPipelineSate(Shader& vertexShader, Shader& pixelShader)
 {
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC gfxPsod = GetPipelineState(m_RootSignature, GetVertexLayout(), GetVertexLayoutCount(), vertexShader, pixelShader);
 
-	if (mSceneColor) {
-		gfxPsod.RTVFormats[0] = mSceneColor->GetDesc().Format; // R16G16B16A16_FLOAT
+	if (mSceneColor[0]) {
+		gfxPsod.RTVFormats[0] = mSceneColor[0]->GetDesc().Format; // R16G16B16A16_FLOAT
 	}
 
 	DX_CONTEXT.GetDevice()->CreateGraphicsPipelineState(&gfxPsod, IID_PPV_ARGS(&m_PipelineStateObj));
@@ -1733,7 +2154,7 @@ bool DirectXManager::CreateOffscreen(uint32_t w, uint32_t h)
 	if (!mOffscreenRtvHeap) {
 		D3D12_DESCRIPTOR_HEAP_DESC d{};
 		d.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-		d.NumDescriptors = 1;
+		d.NumDescriptors = ONNX_MAX_PIPELINE_SLOTS;
 		d.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 		device->CreateDescriptorHeap(&d, IID_PPV_ARGS(&mOffscreenRtvHeap));
 	}
@@ -1750,33 +2171,40 @@ bool DirectXManager::CreateOffscreen(uint32_t w, uint32_t h)
 	D3D12_CLEAR_VALUE clear{}; clear.Format = td.Format; clear.Color[3] = 1.0f;
 	CD3DX12_HEAP_PROPERTIES heapDefault(D3D12_HEAP_TYPE_DEFAULT);
 
-	device->CreateCommittedResource(
-		&heapDefault, D3D12_HEAP_FLAG_NONE, &td,
-		D3D12_RESOURCE_STATE_RENDER_TARGET, &clear, IID_PPV_ARGS(&mSceneColor));
-
-	m_RtvScene = mOffscreenRtvHeap->GetCPUDescriptorHandleForHeapStart();
-	device->CreateRenderTargetView(mSceneColor.Get(), nullptr, m_RtvScene);
+	//  Ը   (߷      ʵ)
+	const UINT rtvInc = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+	for (UINT i = 0; i < m_PipelineSlots; ++i)
+	{
+		device->CreateCommittedResource(
+			&heapDefault, D3D12_HEAP_FLAG_NONE, &td,
+			D3D12_RESOURCE_STATE_RENDER_TARGET, &clear, IID_PPV_ARGS(&mSceneColor[i]));
+
+		m_RtvScene[i] = mOffscreenRtvHeap->GetCPUDescriptorHandleForHeapStart();
+		m_RtvScene[i].ptr += (SIZE_T)i * rtvInc;
+		device->CreateRenderTargetView(mSceneColor[i].Get(), nullptr, m_RtvScene[i]);
+		m_SceneColorState[i] = D3D12_RESOURCE_STATE_RENDER_TARGET;
+	}
 
 	// === (CPU ο) Resolved: UAV  + SRV ===
 	DXGI_FORMAT backFmt = DX_WINDOW.GetBackbuffer()->GetDesc().Format;
 	td.Format = backFmt;
 	td.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
 
-	m_SceneColorState = D3D12_RESOURCE_STATE_RENDER_TARGET;
-
 	return true;
 }
 
 void DirectXManager::DestroyOffscreen()
 {
-	mSceneColor.Release();
+	for (UINT i = 0; i < ONNX_MAX_PIPELINE_SLOTS; ++i)
+	{
+		mSceneColor[i].Release();
+		m_RtvScene[i] = {};
+		m_SceneColorState[i] = D3D12_RESOURCE_STATE_COMMON;
+	}
 	mOffscreenRtvHeap.Release();
 	m_BlitSrvHeap.Release();
 
-	m_RtvScene = {};
 	m_ResolvedSrvCPU = {};
 	m_ResolvedSrvGPU = {};
-
-	m_SceneColorState = D3D12_RESOURCE_STATE_COMMON;
 }
 
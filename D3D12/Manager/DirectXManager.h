@@ -6,6 +6,8 @@
 #include "Support/SponzaModel.h"
 #include "Util/Util.h"
 #include "Util/OnnxDefine.h"
+#include "Util/ResolutionController.h"
+#include "Util/TemporalReuse.h"
 
 #include "Object/RenderingObject3D.h"
 
@@ -24,6 +26,7 @@
 #define RES_ISCV2       5
 
 class Shader;
+struct TemporalCBData;
 using namespace DirectX;
 
 struct Camera {
@@ -91,17 +94,41 @@ public: // Functions
     void RenderImage(ID3D12GraphicsCommandList7* cmd); 
     void Resize();
 
-    void RenderOffscreen(ID3D12GraphicsCommandList7* cmd);
+    // Sponza  ϵǸ cmd ̾  Ʈ ü
+    void RenderOffscreen(ID3D12GraphicsCommandList7*& cmd);
     void BlitToBackbuffer(ID3D12GraphicsCommandList7* cmd);
 
     void UploadGPUResource(ID3D12GraphicsCommandList7* cmdList);
     void CreateOnnxResources(UINT W, UINT H);
     void ResizeOnnxResources(UINT W, UINT H);
+    // Ȱ ʰ ٲ  ȣ (DX_ONNX.SwitchTo). /޽/̴ ״ ΰ
+    // ʿ  ( , /ó PSO, IO , OnnxTex) ٽ 
+    void RebindOnnx();
 
     void InitBlitPipeline();
     void RecordPreprocess(ID3D12GraphicsCommandList7* cmd);
     void RecordPostprocess(ID3D12GraphicsCommandList7* cmd);
 
+    // ߷ :  N+1 ( ť) ߷ N(߷ ť) ħ
+    //  =   + 1. /ó  , ó     ( 0̸  )
+    // 񵿱 ǻƮ /ó ǻƮ ť ǰ RecordPre/Postprocess  ť  /⸸ 
+    void RunInference(FenceTicket sceneTicket);
+    // blitTicket: ̹     ť  ( ó OnnxTex   ٸ)
+    void AdvancePipeline(FenceTicket blitTicket);
+    void ResetPipeline();
+    // Ȱ ʰ ϴ   m_PipelineSlots 
+    // ġ(ONNX_BATCH_SIZE > 1)  ϳ   B    ߷ ( 2  )
+    void InitPipelineSlots();
+
+    //  ߷ ػ: Ӹ ߷ ð(ms)  꿡   Է ũ⸦ ٲ
+    // ũⰡ ٲ Flush  IO/ũ͸ ٽ  (׸ý )
+    void UpdateInferenceScale(double runMs);
+    void InitInferenceScale();
+
+    // ð : K Ӹ(Ǵ ī޶  ̸) ߷ϰ,   
+    //  Ű  ̹  ̷  (/߷/ó ǳʶ).  0 
+    void InitTemporalReuse();
+
     bool CreateOnnxComputePipeline();
 
     void Debug_DumpOrtOutput(ID3D12GraphicsCommandList7* cmd);
@@ -126,6 +153,13 @@ public: // Functions
     ID3D12Resource* GetShadowMap() { return m_ShadowMap.Get(); }
     UINT GetShadowSize() const { return m_ShadowSize; }
     D3D12_GPU_DESCRIPTOR_HANDLE GetObjSrvGPU() { return m_ObjSrvGPU; }
+    SponzaModel* GetSponza() { return m_Sponza.get(); }
+    UINT GetPipelineSlotCount() const { return m_PipelineSlots; }
+    UINT GetInferenceLatency() const { return m_BatchSize > 1 ? m_BatchSize : m_PipelineSlots - 1; }
+    UINT GetBatchSize() const { return m_BatchSize; }
+    const ResolutionController& GetInferenceScale() const { return m_InferScale; }
+    const TemporalReuse& GetTemporalReuse() const { return m_Temporal; }
+    bool IsAsyncCompute() const { return m_AsyncCompute; }
     //==================================//
 
     void SetObjSrvGPU(D3D12_GPU_DESCRIPTOR_HANDLE ObjSrvGPU) { m_ObjSrvGPU = ObjSrvGPU; }
@@ -143,6 +177,25 @@ private: // Functions
 
     void InitPipelineSate(Shader& vertexShader, Shader& pixelShader);
 
+    UINT GetSceneSlot() const { return (UINT)((m_PipelineFrame / m_BatchSize) % m_PipelineSlots); }
+    //  Է ټ ȿ ̹   ġ ε (N )
+    UINT GetSceneSlice() const { return (UINT)(m_PipelineFrame % m_BatchSize); }
+    bool GetPostSlot(UINT& slot, UINT& slice) const; // false:  ä  (ǥ  )
+    // ü ũ W,H    8  
+    void GetInferenceSize(UINT W, UINT H, UINT& outW, UINT& outH) const;
+
+    //  : ̹ ī޶ Ű  
+    void UpdateTemporalReuse();
+    // keyframe: ó  丮 , ƴϸ 丮 OnnxTex 
+    void RecordTemporalPass(ID3D12GraphicsCommandList7* cmd, bool keyframe);
+    void BuildTemporalConstants(TemporalCBData& out) const;
+
+    // /ǻƮ Ʈ  /ó 
+    void RecordPreprocessPass(ID3D12GraphicsCommandList7* cmd, UINT slot, UINT slice);
+    void RecordPostprocessPass(ID3D12GraphicsCommandList7* cmd, UINT slot, UINT slice);
+    FenceTicket SubmitPreprocessCompute(FenceTicket sceneTicket, UINT slot, UINT slice);
+    void SubmitPostprocessCompute();
+
     bool CreateOffscreen(uint32_t w, uint32_t h);
     void DestroyOffscreen();
 
@@ -183,7 +236,7 @@ private: // Variables
     ComPointer<ID3D12DescriptorHeap>    mOffscreenRtvHeap;
 
     ComPointer<ID3D12Resource2> mFSQuadVB;
-    ComPointer<ID3D12Resource2> mSceneColor; // R16G16B16A16_FLOAT
+    ComPointer<ID3D12Resource2> mSceneColor[ONNX_MAX_PIPELINE_SLOTS]; // R16G16B16A16_FLOAT,  Ժ
 
     // offscreen Ÿ & SRV/RTV
     uint32_t m_Width = 0, m_Height = 0;
@@ -204,7 +257,7 @@ private: // Variables
     D3D12_CPU_DESCRIPTOR_HANDLE m_DSV{};
     D3D12_CPU_DESCRIPTOR_HANDLE m_ShadowDSV{};
     D3D12_CPU_DESCRIPTOR_HANDLE m_ObjSrvCPU{};
-    D3D12_CPU_DESCRIPTOR_HANDLE m_RtvScene{};
+    D3D12_CPU_DESCRIPTOR_HANDLE m_RtvScene[ONNX_MAX_PIPELINE_SLOTS]{};
     D3D12_CPU_DESCRIPTOR_HANDLE m_RtvBackbuffer{};
     D3D12_CPU_DESCRIPTOR_HANDLE m_SrvScene{};
     D3D12_CPU_DESCRIPTOR_HANDLE m_ResolvedSrvCPU;
@@ -216,10 +269,32 @@ private: // Variables
     D3D12_VERTEX_BUFFER_VIEW m_FSQuadVBV;
 
     D3D12_RESOURCE_STATES m_ShadowState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-    D3D12_RESOURCE_STATES m_SceneColorState = D3D12_RESOURCE_STATE_COMMON;
+    D3D12_RESOURCE_STATES m_SceneColorState[ONNX_MAX_PIPELINE_SLOTS]{};
     D3D12_RESOURCE_STATES m_OnnxTexState = D3D12_RESOURCE_STATE_COMMON;
     D3D12_RESOURCE_STATES m_OnnxInputState = D3D12_RESOURCE_STATE_COMMON;
 
+    // ߷ 
+    UINT m_PipelineSlots = 1;
+    UINT m_BatchSize = 1;
+    UINT64 m_PipelineFrame = 0;
+    FenceTicket m_InferenceTickets[ONNX_MAX_PIPELINE_SLOTS]{};
+
+    //  ߷ ػ
+    ResolutionController m_InferScale;
+    UINT m_InferW = 0, m_InferH = 0;
+
+    // ð 
+    TemporalReuse m_Temporal;
+    XMFLOAT4X4 m_FrameViewProj{};   // ̹ 
+    XMFLOAT4X4 m_KeyViewProj{};     // 丮  Ű
+
+    // 񵿱 ǻƮ (/ó ǻƮ ť)
+    bool m_AsyncCompute = false;
+    bool m_PostSubmitted = false;   // ̹  ó ̹ ǻƮ ť 
+    FenceTicket m_PostTicket{};     // ǻƮ 潺
+    FenceTicket m_PreTicket{};      // ǻƮ 潺, ̹  ó
+    FenceTicket m_BlitTicket{};     //  潺,   
+
     float m_Angle = 0.f;
     float m_Aspect = 16.f / 9.f;
 
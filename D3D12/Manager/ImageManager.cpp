@@ -12,6 +12,7 @@ bool ImageManager::Init()
 
 void ImageManager::Shutdown()
 {
+	m_WhiteTex.Release();
 	m_Srvheap.Release();
 }
 
@@ -155,9 +156,13 @@ void ImageManager::CreateDefaultTextures()
 	auto toSRV = CD3DX12_RESOURCE_BARRIER::Transition(
 		whiteTex.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 	cmd->ResourceBarrier(1, &toSRV);
-	DX_CONTEXT.ExecuteCommandList();
 
-	// SRV   ε 
+	//   , ε ۴  Ϸ  
+	FenceTicket ticket = DX_CONTEXT.Submit();
+	DX_CONTEXT.DeferRelease(ticket, upload);
+
+	// SRV   ε  (SRV Ű ؽó  )
+	m_WhiteTex = whiteTex;
 	m_WhiteIndex = CreateSRVForTexture(whiteTex.Get(), DXGI_FORMAT_R8G8B8A8_UNORM);
 
 	// ҽ Image μ ĳÿ ְ  ʿ  ߰.
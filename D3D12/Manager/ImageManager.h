@@ -60,6 +60,7 @@ private: // Functions
 private: // Variables
 
     ComPointer<ID3D12DescriptorHeap> m_Srvheap;
+    ComPointer<ID3D12Resource> m_WhiteTex;
 
     std::unordered_map<std::string, std::weak_ptr<Image>> m_ImageMap;
     std::unordered_map<std::string, UINT64> m_PathToSrvIndex;
@@ -3,53 +3,309 @@
 #include "OnnxRunner/OnnxRunner_AdaIN.h"
 //#include "OnnxRunner/OnnxRunner_Udnie.h"
 #include "OnnxRunner/OnnxRunner_FastNeuralStyle.h"
+#include "OnnxRunner/OnnxRunner_Cpu.h"
+#include "Util/OnnxEnvironment.h"
 //#include "OnnxRunner/OnnxRunner_ReCoNet.h"
 //#include "OnnxRunner/OnnxRunner_BlindVideo.h"
 //#include "OnnxRunner/OnnxRunner_Sanet.h"
 
-bool OnnxManager::Init(const std::wstring& modelPath, ID3D12Device* dev, ID3D12CommandQueue* queue)
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+extern const int ONNX_POOL_MAX_RUNNERS;
+extern const int ONNX_POOL_MAX_MB;
+extern const bool ONNX_POOL_PRELOAD;
+extern const bool ONNX_FP16;
+extern const bool ONNX_INT8;
+extern const int ONNX_TILE_SIZE;
+extern const int ONNX_TILE_OVERLAP;
+extern const bool ONNX_CPU_EP;
+extern const bool ONNX_CPU_FALLBACK;
+
+bool OnnxManager::Init(OnnxType type, ID3D12Device* dev, ID3D12CommandQueue* queue)
 {
-	InitOnnxRunner(modelPath, dev, queue);
-    if (m_OnnxRunner == nullptr)
+    m_Dev = dev;
+    m_Queue = queue;
+
+    if (SwitchTo(type) == false)
     {
         return false;
     }
 
-    return m_OnnxRunner->Init(modelPath, dev, queue);
+    if (ONNX_POOL_PRELOAD)
+    {
+        // Pays every session creation up front; models that do not fit are left for later
+        const OnnxType preloadTypes[] = { OnnxType::AdaIN, OnnxType::FastNeuralStyle, OnnxType::ReCoNet, OnnxType::Sanet, OnnxType::WCT2 };
+        for (OnnxType preloadType : preloadTypes)
+        {
+            Preload(preloadType);
+        }
+    }
+
+    return true;
 }
 
-bool OnnxManager::Init(OnnxType type, ID3D12Device* dev, ID3D12CommandQueue* queue)
+const wchar_t* OnnxManager::GetModelPath(OnnxType type)
 {
     switch (type)
 	{
 	    case OnnxType::WCT2:
         {
-		    return Init(L"./Resources/Onnx/1x1_Conv.onnx", dev, queue);
+		    return L"./Resources/Onnx/1x1_Conv.onnx";
         }
 	    case OnnxType::AdaIN:
         {
-		    return Init(L"./Resources/Onnx/adain_end2end_2inputs_op17.onnx", dev, queue);
+		    return L"./Resources/Onnx/adain_end2end_2inputs_op17.onnx";
         }
 	    case OnnxType::FastNeuralStyle:
         {
-		    return Init(L"./Resources/Onnx/FHD/FST_dyn_TheStarryNight.onnx", dev, queue);
+		    return L"./Resources/Onnx/FHD/FST_dyn_TheStarryNight.onnx";
         }
 	    case OnnxType::ReCoNet:
         {
-		    return Init(L"./Resources/Onnx/FHD/ReCoNet_TheStarryNight.onnx", dev, queue);
+		    return L"./Resources/Onnx/FHD/ReCoNet_TheStarryNight.onnx";
         }
 	    case OnnxType::Sanet:
         {
-		    return Init(L"./Resources/Onnx/sanet_end2end_2inputs_op17.onnx", dev, queue);
+		    return L"./Resources/Onnx/sanet_end2end_2inputs_op17.onnx";
         }
 
 	    default:
-		    return false;
+		    return nullptr;
 	}
 
+    return nullptr;
+}
+
+std::wstring OnnxManager::ResolveModelVariant(OnnxType type, const wchar_t* modelPath, bool cpu)
+{
+    // <name>_<suffix>.onnx next to the fp32 model; the runner picks the tensor type up from the session
+    auto variant = [modelPath](const wchar_t* suffix, std::wstring& outPath) {
+        std::filesystem::path path(modelPath);
+        path.replace_filename(path.stem().wstring() + suffix + path.extension().wstring());
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec) == false)
+        {
+            char buf[512];
+            sprintf_s(buf, "[OnnxManager] no %ls model for %ls\n", suffix, modelPath);
+            OutputDebugStringA(buf);
+            return false;
+        }
+        outPath = path.wstring();
+        return true;
+        };
+
+    // INT8 (QDQ, Tools/onnx_int8.py) is calibrated for the feed-forward style models only
+    std::wstring path;
+    const bool int8Type = type == OnnxType::FastNeuralStyle || type == OnnxType::ReCoNet;
+    if (ONNX_INT8 && int8Type && variant(L"_int8", path))
+    {
+        return path;
+    }
+    // Most CPU kernels are float only, so the CPU EP would cast an fp16 graph back and forth
+    if (ONNX_FP16 && cpu == false && variant(L"_fp16", path))
+    {
+        return path;
+    }
+    return modelPath;
+}
+
+bool OnnxManager::SwitchTo(OnnxType type)
+{
+    // Tile copies point at the current runner's IO; RebindOnnx prepares the new one
+    ReleaseTiles();
+
+    RunnerEntry* entry = FindRunner(type);
+    if (entry == nullptr)
+    {
+        entry = LoadRunner(type, true);
+    }
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    entry->lastUsed = ++m_UseTick;
+    m_OnnxRunner = entry->runner.get();
+    m_OnnxType = entry->onnxType;
+    m_ChangeOnnxType = m_OnnxType;
+    m_Initialized = true;
+
+    // The previous runner may now be the one over the limit
+    EvictRunners(0, 0);
+    return true;
+}
+
+bool OnnxManager::Preload(OnnxType type)
+{
+    if (FindRunner(type) != nullptr)
+    {
+        return true;
+    }
+    return LoadRunner(type, false) != nullptr;
+}
+
+bool OnnxManager::IsLoaded(OnnxType type) const
+{
+    for (const RunnerEntry& entry : m_Runners)
+    {
+        if (entry.requestType == type)
+        {
+            return true;
+        }
+    }
     return false;
 }
 
+uint64_t OnnxManager::GetLoadedBytes() const
+{
+    uint64_t bytes = 0;
+    for (const RunnerEntry& entry : m_Runners)
+    {
+        bytes += entry.bytes;
+    }
+    return bytes;
+}
+
+OnnxManager::RunnerEntry* OnnxManager::FindRunner(OnnxType type)
+{
+    for (RunnerEntry& entry : m_Runners)
+    {
+        if (entry.requestType == type)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool OnnxManager::HasRoomFor(uint64_t extraBytes, UINT extraRunners) const
+{
+    const size_t maxRunners = (size_t)std::max<int>(ONNX_POOL_MAX_RUNNERS, 1);
+    const uint64_t maxBytes = (uint64_t)std::max<int>(ONNX_POOL_MAX_MB, 0) * 1024ull * 1024ull;
+
+    if (m_Runners.size() + extraRunners > maxRunners)
+    {
+        return false;
+    }
+    return maxBytes == 0 || GetLoadedBytes() + extraBytes <= maxBytes;
+}
+
+OnnxManager::RunnerEntry* OnnxManager::LoadRunner(OnnxType type, bool evict)
+{
+    if (GetModelPath(type) == nullptr || m_Dev == nullptr || m_Queue == nullptr)
+    {
+        return nullptr;
+    }
+    std::wstring modelPath = ResolveModelVariant(type, GetModelPath(type), ONNX_CPU_EP);
+
+    // DML keeps roughly the weights resident, so the file size stands in for the runner's footprint
+    std::error_code ec;
+    uint64_t bytes = (uint64_t)std::filesystem::file_size(modelPath, ec);
+    if (ec)
+    {
+        bytes = 0;
+    }
+
+    if (evict)
+    {
+        EvictRunners(bytes, 1);
+    }
+    else if (HasRoomFor(bytes, 1) == false)
+    {
+        return nullptr;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+
+    // The DML runners report device/EP failures by throwing
+    auto initRunner = [this](OnnxRunnerInterface* runner, const std::wstring& path) {
+        try
+        {
+            return runner != nullptr && runner->Init(path, m_Dev, m_Queue);
+        }
+        catch (const std::exception& e)
+        {
+            char buf[512];
+            sprintf_s(buf, "[OnnxManager] runner init failed: %s\n", e.what());
+            OutputDebugStringA(buf);
+            return false;
+        }
+        };
+
+    RunnerEntry entry;
+    entry.requestType = type;
+    entry.bytes = bytes;
+    entry.runner = CreateOnnxRunner(modelPath, ONNX_CPU_EP, entry.onnxType);
+    bool initialized = initRunner(entry.runner.get(), modelPath);
+    if (initialized == false && ONNX_CPU_FALLBACK && ONNX_CPU_EP == false && entry.runner != nullptr)
+    {
+        char buf[256];
+        sprintf_s(buf, "[OnnxManager] DML runner unavailable for type %d, falling back to the CPU EP\n", (int)type);
+        OutputDebugStringA(buf);
+
+        entry.runner->Shutdown();
+        modelPath = ResolveModelVariant(type, GetModelPath(type), true);
+        entry.runner = CreateOnnxRunner(modelPath, true, entry.onnxType);
+        initialized = initRunner(entry.runner.get(), modelPath);
+    }
+    if (initialized == false)
+    {
+        if (entry.runner != nullptr)
+        {
+            entry.runner->Shutdown();
+        }
+        char buf[256];
+        sprintf_s(buf, "[OnnxManager] failed to load runner for type %d\n", (int)type);
+        OutputDebugStringA(buf);
+        return nullptr;
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    char buf[256];
+    sprintf_s(buf, "[OnnxManager] loaded runner type %d in %.1f ms (%.1f MB, %s), pool %zu runners\n",
+        (int)type, ms, (double)entry.bytes / (1024.0 * 1024.0), entry.runner->GetPrecisionName().c_str(), m_Runners.size() + 1);
+    OutputDebugStringA(buf);
+
+    // Entries move on growth, but the runners themselves stay put, so m_OnnxRunner stays valid
+    m_Runners.push_back(std::move(entry));
+    return &m_Runners.back();
+}
+
+void OnnxManager::EvictRunners(uint64_t extraBytes, UINT extraRunners)
+{
+    // The active runner is never evicted, so the pool can briefly hold one runner over the limit
+    while (m_Runners.empty() == false && HasRoomFor(extraBytes, extraRunners) == false)
+    {
+
+        size_t victim = m_Runners.size();
+        for (size_t i = 0; i < m_Runners.size(); ++i)
+        {
+            if (m_Runners[i].runner.get() == m_OnnxRunner)
+            {
+                continue;
+            }
+            if (victim == m_Runners.size() || m_Runners[i].lastUsed < m_Runners[victim].lastUsed)
+            {
+                victim = i;
+            }
+        }
+        if (victim == m_Runners.size())
+        {
+            break;
+        }
+
+        char buf[256];
+        sprintf_s(buf, "[OnnxManager] evicting runner type %d (%.1f MB)\n",
+            (int)m_Runners[victim].requestType, (double)m_Runners[victim].bytes / (1024.0 * 1024.0));
+        OutputDebugStringA(buf);
+
+        m_Runners[victim].runner->Shutdown();
+        m_Runners.erase(m_Runners.begin() + victim);
+    }
+}
+
 bool OnnxManager::PrepareIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
 {
     if (m_OnnxRunner == nullptr)
@@ -57,6 +313,13 @@ bool OnnxManager::PrepareIO(ID3D12Device* dev, UINT contentW, UINT contentH, UIN
         return false;
     }
 
+    ReleaseTiles();
+    OnnxTileGrid grid;
+    if (ComputeTileGrid(contentW, contentH, grid))
+    {
+        return PrepareTiles(dev, grid, styleW, styleH);
+    }
+
     return m_OnnxRunner->PrepareIO(dev, contentW, contentH, styleW, styleH);
 }
 
@@ -66,10 +329,56 @@ bool OnnxManager::Run()
     {
         return false;
     }
+    OnnxEnvironment::RunScope scope;
+    if (m_TileGrid.IsTiled())
+    {
+        return RunTiles();
+    }
 
     return m_OnnxRunner->Run();
 }
 
+bool OnnxManager::Run(UINT slot)
+{
+    if (m_OnnxRunner == nullptr)
+    {
+        return false;
+    }
+    OnnxEnvironment::RunScope scope;
+    if (m_TileGrid.IsTiled())
+    {
+        return slot == 0 ? RunTiles() : false;
+    }
+
+    return m_OnnxRunner->RunSlot(slot);
+}
+
+UINT OnnxManager::SetPipelineSlotCount(UINT count)
+{
+    if (m_OnnxRunner == nullptr)
+    {
+        return 1;
+    }
+
+    // Tiles share one staging pair, so tiled inference runs without pipeline latency
+    if (ONNX_TILE_SIZE > 0 && m_OnnxRunner->IsInputResizable() && m_OnnxRunner->GetBatchSize() == 1)
+    {
+        count = 1;
+    }
+
+    return m_OnnxRunner->SetPipelineSlotCount(count);
+}
+
+UINT OnnxManager::SetBatchSize(UINT count)
+{
+    if (m_OnnxRunner == nullptr)
+    {
+        return 1;
+    }
+
+    return m_OnnxRunner->SetBatchSize(count);
+}
+
 void OnnxManager::ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
 {
     if (m_OnnxRunner == nullptr)
@@ -77,55 +386,298 @@ void OnnxManager::ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT
         return;
     }
 
+    ReleaseTiles();
+    OnnxTileGrid grid;
+    if (ComputeTileGrid(contentW, contentH, grid))
+    {
+        PrepareTiles(dev, grid, styleW, styleH);
+        return;
+    }
+
     m_OnnxRunner->ResizeIO(dev, contentW, contentH, styleW, styleH);
 }
 
+bool OnnxManager::ComputeTileGrid(UINT contentW, UINT contentH, OnnxTileGrid& outGrid) const
+{
+    outGrid = {};
 
-void OnnxManager::Shutdown()
+    // A static-shape model runs at its own size whatever the frame is; a batch already fills the binding
+    if (ONNX_TILE_SIZE <= 0 || m_OnnxRunner->IsInputResizable() == false || m_OnnxRunner->GetBatchSize() > 1)
+    {
+        return false;
+    }
+
+    const UINT tile = (UINT)std::max<int>(OnnxRunnerInterface::AlignDown8(ONNX_TILE_SIZE), 64);
+    if (contentW <= tile && contentH <= tile)
+    {
+        return false;
+    }
+
+    // Tiles are multiples of 8 like the inference size. The overlap is capped at a quarter tile;
+    // the shaders spread the tiles evenly, which can only make the actual overlap larger
+    auto axis = [tile](UINT img, UINT& outTile, UINT& outCount) {
+        outTile = std::min<UINT>(tile, (UINT)std::max<int>(OnnxRunnerInterface::AlignDown8((int)img), 8));
+        const UINT overlap = std::min<UINT>((UINT)std::max<int>(ONNX_TILE_OVERLAP, 0), outTile / 4);
+        const UINT step = outTile - overlap;
+        outCount = img <= outTile ? 1 : (img - overlap + step - 1) / step;
+        };
+
+    outGrid.ImgW = contentW;
+    outGrid.ImgH = contentH;
+    axis(contentW, outGrid.TileW, outGrid.TilesX);
+    axis(contentH, outGrid.TileH, outGrid.TilesY);
+    return true;
+}
+
+bool OnnxManager::PrepareTiles(ID3D12Device* dev, const OnnxTileGrid& grid, UINT styleW, UINT styleH)
 {
-    if (m_OnnxRunner == nullptr)
+    // The runner only ever sees one tile: a fixed binding, and activations sized by the tile
+    if (m_OnnxRunner->PrepareIO(dev, grid.TileW, grid.TileH, styleW, styleH) == false)
     {
-        return;
+        return false;
     }
 
-    m_OnnxRunner->Shutdown();
-    m_OnnxRunner.release();
+    const std::vector<int64_t>& inShape = m_OnnxRunner->GetInputShapeContent();
+    if (inShape.size() != 4 || inShape[2] != (int64_t)grid.TileH || inShape[3] != (int64_t)grid.TileW)
+    {
+        char buf[256];
+        sprintf_s(buf, "[OnnxManager] runner did not bind the %ux%u tile, running %ux%u untiled\n",
+            grid.TileW, grid.TileH, grid.ImgW, grid.ImgH);
+        OutputDebugStringA(buf);
+        return m_OnnxRunner->PrepareIO(dev, grid.ImgW, grid.ImgH, styleW, styleH);
+    }
+
+    const UINT64 elemBytes = m_OnnxRunner->IsTensorFp16() ? sizeof(uint16_t) : sizeof(float);
+    const UINT64 plane = (UINT64)grid.TileW * grid.TileH;
+    m_TileInBytes = (UINT64)inShape[1] * plane * elemBytes;
+    // Style networks return RGB at the input size; RunTiles checks the runner against this
+    m_TileOutShape = { 1, 3, (int64_t)grid.TileH, (int64_t)grid.TileW };
+    m_TileOutBytes = 3 * plane * elemBytes;
+
+    auto createBuffer = [dev](UINT64 bytes, const wchar_t* name, ComPointer<ID3D12Resource>& outBuf) {
+        CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);
+        auto rd = CD3DX12_RESOURCE_DESC::Buffer(bytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+        if (FAILED(dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
+            D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&outBuf))))
+        {
+            return false;
+        }
+        outBuf->SetName(name);
+        return true;
+        };
+
+    const D3D12_COMMAND_LIST_TYPE listType = m_Queue->GetDesc().Type;
+    bool created = createBuffer(m_TileInBytes * grid.Count(), L"ORT_Tiles_Input", m_TileIn)
+        && createBuffer(m_TileOutBytes * grid.Count(), L"ORT_Tiles_Output", m_TileOut)
+        && SUCCEEDED(dev->CreateCommandAllocator(listType, IID_PPV_ARGS(&m_TileAllocators[0])))
+        && SUCCEEDED(dev->CreateCommandAllocator(listType, IID_PPV_ARGS(&m_TileAllocators[1])));
+    if (created && !m_TileFence)
+    {
+        created = SUCCEEDED(dev->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_TileFence)));
+    }
+    if (created == false)
+    {
+        OutputDebugStringA("[OnnxManager] tile buffers could not be created\n");
+        ReleaseTiles();
+        return false;
+    }
+
+    m_TileGrid = grid;
+
+    char buf[256];
+    sprintf_s(buf, "[OnnxManager] tiled inference %ux%u: %ux%u tiles of %ux%u (%.1f MB staging)\n",
+        grid.ImgW, grid.ImgH, grid.TilesX, grid.TilesY, grid.TileW, grid.TileH,
+        (double)((m_TileInBytes + m_TileOutBytes) * grid.Count()) / (1024.0 * 1024.0));
+    OutputDebugStringA(buf);
+    return true;
+}
+
+bool OnnxManager::RecordTileCopies(bool output)
+{
+    ComPointer<ID3D12Resource> runnerBuf = output ? m_OnnxRunner->GetOutputBuffer() : m_OnnxRunner->GetInputBufferContent();
+    ComPointer<ID3D12Resource>& recorded = output ? m_TileCopyOutSource : m_TileCopyInTarget;
+    if (!runnerBuf)
+    {
+        return false;
+    }
+    if (recorded.Get() == runnerBuf.Get())
+    {
+        return true;
+    }
+
+    // Lists submitted by earlier frames may still be executing
+    WaitForTiles();
+
+    ComPointer<ID3D12CommandAllocator>& allocator = m_TileAllocators[output ? 1 : 0];
+    std::vector<ComPointer<ID3D12GraphicsCommandList>>& lists = output ? m_TileCopyOut : m_TileCopyIn;
+    if (FAILED(allocator->Reset()))
+    {
+        return false;
+    }
+
+    // Staging tile i -> runner input, or runner output -> staging tile i
+    const UINT64 bytes = output ? m_TileOutBytes : m_TileInBytes;
+    ID3D12Resource* staging = output ? m_TileOut.Get() : m_TileIn.Get();
+    ID3D12Resource* src = output ? runnerBuf.Get() : staging;
+    ID3D12Resource* dst = output ? staging : runnerBuf.Get();
+
+    lists.resize(m_TileGrid.Count());
+    for (UINT i = 0; i < m_TileGrid.Count(); ++i)
+    {
+        ComPointer<ID3D12GraphicsCommandList>& list = lists[i];
+        const HRESULT hr = list
+            ? list->Reset(allocator, nullptr)
+            : m_Dev->CreateCommandList(0, m_Queue->GetDesc().Type, allocator, nullptr, IID_PPV_ARGS(&list));
+        if (FAILED(hr))
+        {
+            return false;
+        }
+
+        // Every tensor buffer stays in UAV state between passes (DML binds them as UAVs)
+        D3D12_RESOURCE_BARRIER toCopy[2] = {
+            CD3DX12_RESOURCE_BARRIER::Transition(src, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE),
+            CD3DX12_RESOURCE_BARRIER::Transition(dst, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST) };
+        list->ResourceBarrier(2, toCopy);
+        list->CopyBufferRegion(dst, output ? i * bytes : 0, src, output ? 0 : i * bytes, bytes);
+        D3D12_RESOURCE_BARRIER toUav[2] = {
+            CD3DX12_RESOURCE_BARRIER::Transition(src, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+            CD3DX12_RESOURCE_BARRIER::Transition(dst, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_UNORDERED_ACCESS) };
+        list->ResourceBarrier(2, toUav);
+        if (FAILED(list->Close()))
+        {
+            return false;
+        }
+    }
+
+    recorded = runnerBuf;
+    return true;
+}
+
+bool OnnxManager::RunTiles()
+{
+    if (RecordTileCopies(false) == false)
+    {
+        return false;
+    }
+
+    // The DML EP submits each Run on this same queue, so copy -> Run -> copy execute in order
+    for (UINT i = 0; i < m_TileGrid.Count(); ++i)
+    {
+        ID3D12CommandList* copyIn[] = { m_TileCopyIn[i].Get() };
+        m_Queue->ExecuteCommandLists(1, copyIn);
+        if (m_OnnxRunner->RunSlot(0) == false)
+        {
+            return false;
+        }
+
+        if (i == 0)
+        {
+            // The first Run after PrepareIO may have allocated the output (shape discovery)
+            if (m_OnnxRunner->GetOutputShape() != m_TileOutShape)
+            {
+                static bool sReported = false;
+                if (sReported == false)
+                {
+                    OutputDebugStringA("[OnnxManager] tiled inference needs an RGB output the size of the input tile\n");
+                    sReported = true;
+                }
+                return false;
+            }
+            if (RecordTileCopies(true) == false)
+            {
+                return false;
+            }
+        }
+
+        ID3D12CommandList* copyOut[] = { m_TileCopyOut[i].Get() };
+        m_Queue->ExecuteCommandLists(1, copyOut);
+    }
+
+    m_Queue->Signal(m_TileFence, ++m_TileFenceValue);
+    return true;
+}
+
+void OnnxManager::WaitForTiles()
+{
+    if (m_TileFence && m_TileFence->GetCompletedValue() < m_TileFenceValue)
+    {
+        // No event: blocks until the fence reaches the value
+        m_TileFence->SetEventOnCompletion(m_TileFenceValue, nullptr);
+    }
+}
+
+void OnnxManager::ReleaseTiles()
+{
+    WaitForTiles();
+
+    m_TileCopyIn.clear();
+    m_TileCopyOut.clear();
+    m_TileCopyInTarget.Release();
+    m_TileCopyOutSource.Release();
+    m_TileAllocators[0].Release();
+    m_TileAllocators[1].Release();
+    m_TileIn.Release();
+    m_TileOut.Release();
+    m_TileOutShape.clear();
+    m_TileInBytes = 0;
+    m_TileOutBytes = 0;
+    m_TileGrid = {};
+}
+
+void OnnxManager::Shutdown()
+{
+    ReleaseTiles();
+    m_TileFence.Release();
+
+    for (RunnerEntry& entry : m_Runners)
+    {
+        entry.runner->Shutdown();
+    }
+    m_Runners.clear();
     m_OnnxRunner = nullptr;
+
+    m_Initialized = false;
+    m_OnnxType = OnnxType::None;
 }
 
-void OnnxManager::InitOnnxRunner(const std::wstring& modelPath, ID3D12Device* dev, ID3D12CommandQueue* queue)
+std::unique_ptr<OnnxRunnerInterface> OnnxManager::CreateOnnxRunner(const std::wstring& modelPath, bool cpu, OnnxType& outType)
 {
+    std::unique_ptr<OnnxRunnerInterface> runner;
     if (modelPath.find(L"sanet") != std::wstring::npos)
     {
-        m_OnnxRunner = std::make_unique<OnnxRunner_AdaIN>();
-        m_OnnxType = OnnxType::Sanet;
+        outType = OnnxType::Sanet;
+        runner = std::make_unique<OnnxRunner_AdaIN>();
     }
     else if (modelPath.find(L"Conv") != std::wstring::npos)
     {
-        m_OnnxRunner = std::make_unique<OnnxRunner_AdaIN>();
-        m_OnnxType = OnnxType::WCT2;
+        outType = OnnxType::WCT2;
+        runner = std::make_unique<OnnxRunner_AdaIN>();
     }
     else if (modelPath.find(L"ReCoNet") != std::wstring::npos)
     {
-        m_OnnxRunner = std::make_unique<OnnxRunner_FastNeuralStyle>();
-        m_OnnxType = OnnxType::ReCoNet;
+        outType = OnnxType::ReCoNet;
+        runner = std::make_unique<OnnxRunner_FastNeuralStyle>();
     }
     else if (modelPath.find(L"dyn") != std::wstring::npos)
     {
-        m_OnnxRunner = std::make_unique<OnnxRunner_FastNeuralStyle>();
-        m_OnnxType = OnnxType::ReCoNet;
+        outType = OnnxType::ReCoNet;
+        runner = std::make_unique<OnnxRunner_FastNeuralStyle>();
     }
     else if (modelPath.find(L"adain") != std::wstring::npos)
     {
-        m_OnnxRunner = std::make_unique<OnnxRunner_AdaIN>();
-		m_OnnxType = OnnxType::AdaIN;
+		outType = OnnxType::AdaIN;
+        runner = std::make_unique<OnnxRunner_AdaIN>();
     }
     else
     {
-        m_OnnxRunner = std::make_unique<OnnxRunnerInterface>();
-		m_OnnxType = OnnxType::None;
-	}
+	    outType = OnnxType::None;
+        return std::make_unique<OnnxRunnerInterface>();
+    }
 
-    m_ChangeOnnxType = m_OnnxType;
-    m_Initialized = true;
+    // One CPU runner covers every model; the type above still picks the pre/post-process passes
+    if (cpu)
+    {
+        return std::make_unique<OnnxRunner_Cpu>();
+    }
+    return runner;
 }
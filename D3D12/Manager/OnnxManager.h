@@ -32,23 +32,51 @@ public:
     OnnxManager() = default;
 
 public: // Functions
+	//  Ǯ ʱȭ  type Ȱȭ (ONNX_POOL_PRELOAD  𵨵 뷮 ѵ ̸ ε)
 	bool Init(OnnxType type, ID3D12Device* dev, ID3D12CommandQueue* queue);
+	// Ȱ  ü. Ǯ  εϰ, ѵ      ʺ 
+	// GPU Ȱ  IO    (Flush ) ȣϰ, ̾ DX_MANAGER.RebindOnnx()
+	bool SwitchTo(OnnxType type);
+	// ڸ   ε (ٸ ʸ о )
+	bool Preload(OnnxType type);
+	bool IsLoaded(OnnxType type) const;
     bool PrepareIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH);
     bool PrepareIO(ID3D12Device* dev, UINT W, UINT H) { return PrepareIO(dev, W, H, W, H); }
     bool Run();
+    bool Run(UINT slot);
+    UINT SetPipelineSlotCount(UINT count);
+    // ġ ũ ( PrepareIO,   ȯ).  ʴ ʴ 1. ġ 2 ̸̻ Ÿ ߷  
+    UINT SetBatchSize(UINT count);
+    void InvalidateStyle() { if (m_OnnxRunner) m_OnnxRunner->InvalidateStyle(); }
     void ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH);
     void ResizeIO(ID3D12Device* dev, UINT W, UINT H) { ResizeIO(dev, W, H, W, H); }
     void Shutdown();
 
     //===========Getter=================//
     //  (): content/style Է ۿ shape
-    ComPointer<ID3D12Resource> GetOutputBuffer()        const { return m_OnnxRunner->GetOutputBuffer(); }
-    ComPointer<ID3D12Resource> GetInputBufferContent()  const { return m_OnnxRunner->GetInputBufferContent(); }
+    // Ÿ ߷ ̸ content Է/ Ÿ ̾  , shape Ÿ ϳ
+    ComPointer<ID3D12Resource> GetOutputBuffer()        const { return m_TileGrid.IsTiled() ? m_TileOut : m_OnnxRunner->GetOutputBuffer(); }
+    ComPointer<ID3D12Resource> GetInputBufferContent()  const { return m_TileGrid.IsTiled() ? m_TileIn : m_OnnxRunner->GetInputBufferContent(); }
     ComPointer<ID3D12Resource> GetInputBufferStyle()    const { return m_OnnxRunner->GetInputBufferStyle(); }
-    const std::vector<int64_t>& GetOutputShape()        const { return m_OnnxRunner->GetOutputShape(); }
+    //  Ժ  (Ÿ ߷  1)
+    ComPointer<ID3D12Resource> GetOutputBuffer(UINT slot)       const { return m_TileGrid.IsTiled() ? m_TileOut : m_OnnxRunner->GetSlotOutputBuffer(slot); }
+    ComPointer<ID3D12Resource> GetInputBufferContent(UINT slot) const { return m_TileGrid.IsTiled() ? m_TileIn : m_OnnxRunner->GetSlotInputBufferContent(slot); }
+    UINT GetPipelineSlotCount()                         const { return m_OnnxRunner ? m_OnnxRunner->GetPipelineSlotCount() : 1; }
+    UINT GetBatchSize()                                 const { return m_OnnxRunner ? m_OnnxRunner->GetBatchSize() : 1; }
+    const std::vector<int64_t>& GetOutputShape()        const { return m_TileGrid.IsTiled() ? m_TileOutShape : m_OnnxRunner->GetOutputShape(); }
     const std::vector<int64_t>& GetInputShapeContent()  const { return m_OnnxRunner->GetInputShapeContent(); }
     const std::vector<int64_t>& GetInputShapeStyle()    const { return m_OnnxRunner->GetInputShapeStyle(); }
 	bool IsInitialized()                                const { return m_Initialized; }
+	// Ȱ  Run CPU  (ʰ   )
+	OnnxRunnerInterface::RunStats GetRunStats()         const { return m_OnnxRunner ? m_OnnxRunner->GetRunStats() : OnnxRunnerInterface::RunStats{}; }
+	UINT GetLoadedRunnerCount()                         const { return (UINT)m_Runners.size(); }
+	uint64_t GetLoadedBytes()                           const;
+	// Ȱ ʰ FLOAT16 ټ  (ó/ó ̴ , ġ  ޶)
+	bool IsTensorFp16()                                 const { return m_OnnxRunner ? m_OnnxRunner->IsTensorFp16() : false; }
+	const char* GetPrecisionName()                      const { return m_OnnxRunner ? m_OnnxRunner->GetPrecisionName().c_str() : ""; }
+	bool IsInputResizable()                             const { return m_OnnxRunner ? m_OnnxRunner->IsInputResizable() : false; }
+	// Ÿ ߷  (TilesX == 0̸ Ÿ ). ó/ó CB ġ 
+	const OnnxTileGrid& GetTileGrid()                   const { return m_TileGrid; }
 	OnnxType GetOnnxType()                              const { return m_OnnxType; }
 	OnnxType GetChangeOnnxType()                        const { return m_ChangeOnnxType; }
     //==================================//
@@ -56,14 +84,63 @@ public: // Functions
 
 
 private:
-    bool Init(const std::wstring& modelPath, ID3D12Device* dev, ID3D12CommandQueue* queue);
-	void InitOnnxRunner(const std::wstring& modelPath, ID3D12Device* dev, ID3D12CommandQueue* queue);
+    // Ǯ ׸: û Ÿ( ) ϳ ʱȭ  ϳ
+    struct RunnerEntry
+    {
+        std::unique_ptr<OnnxRunnerInterface> runner;
+        OnnxType requestType = OnnxType::None;  // Ű (SwitchTo/Preload )
+        OnnxType onnxType = OnnxType::None;     //  η   Ÿ
+        uint64_t lastUsed = 0;
+        uint64_t bytes = 0;                     //  GPU ޸ (  ũ)
+    };
+
+    static const wchar_t* GetModelPath(OnnxType type);
+    //  ִ ȯ : ONNX_INT8̸ <>_int8.onnx (FastNeuralStyle/ReCoNet), ONNX_FP16̸ <>_fp16.onnx,  ״
+    // cpu: CPU EP̸ fp16  ǳʶ
+    static std::wstring ResolveModelVariant(OnnxType type, const wchar_t* modelPath, bool cpu);
+    // cpu:    OnnxRunner_Cpu (outType ״  η )
+    std::unique_ptr<OnnxRunnerInterface> CreateOnnxRunner(const std::wstring& modelPath, bool cpu, OnnxType& outType);
+
+    RunnerEntry* FindRunner(OnnxType type);
+    // evict: ڸ  LRU  (false ڸ   ε )
+    RunnerEntry* LoadRunner(OnnxType type, bool evict);
+    bool HasRoomFor(uint64_t extraBytes, UINT extraRunners) const;
+    // Ȱ ʸ  LRU  ؼ extraBytes ŭ   ڸ 
+    void EvictRunners(uint64_t extraBytes, UINT extraRunners);
+
+    // Ÿ ߷ (ONNX_TILE_SIZE): content ŸϺ ũ ʴ Ÿ ũθ ε (shape , Ȱ ޸𸮴 ػ󵵿 )
+    // ó/ó Ÿ ̾  ۸ , Run Ÿϸ  ->  Run -> 縦 ߷ ť  ִ´
+    bool ComputeTileGrid(UINT contentW, UINT contentH, OnnxTileGrid& outGrid) const;
+    bool PrepareTiles(ID3D12Device* dev, const OnnxTileGrid& grid, UINT styleW, UINT styleH);
+    // output:   -> ¡, ƴϸ ¡ ->  Է.  ۰ ٲ  (ù Run  Ҵ ) ٽ 
+    bool RecordTileCopies(bool output);
+    bool RunTiles();
+    //    Ʈ   CPU 
+    void WaitForTiles();
+    void ReleaseTiles();
 
 private:
-    std::unique_ptr<OnnxRunnerInterface> m_OnnxRunner = nullptr;
+    std::vector<RunnerEntry> m_Runners;
+    OnnxRunnerInterface* m_OnnxRunner = nullptr;    // Ȱ  (m_Runners )
+    uint64_t m_UseTick = 0;
+
+    ID3D12Device* m_Dev = nullptr;
+    ID3D12CommandQueue* m_Queue = nullptr;
 
 	bool m_Initialized = false;
 
+    // Ÿ ߷
+    OnnxTileGrid m_TileGrid;
+    ComPointer<ID3D12Resource> m_TileIn, m_TileOut;     // [N][C][TileH][TileW]
+    std::vector<int64_t> m_TileOutShape;                // Ÿ ϳ [1,3,TileH,TileW]
+    UINT64 m_TileInBytes = 0, m_TileOutBytes = 0;       // Ÿ ϳ
+    ComPointer<ID3D12CommandAllocator> m_TileAllocators[2];    // 0 = Է , 1 =  
+    std::vector<ComPointer<ID3D12GraphicsCommandList>> m_TileCopyIn, m_TileCopyOut;  // Ÿϸ ϳ,   ٽ 
+    ComPointer<ID3D12Resource> m_TileCopyInTarget;      //  Ʈ Ű  
+    ComPointer<ID3D12Resource> m_TileCopyOutSource;
+    ComPointer<ID3D12Fence> m_TileFence;
+    UINT64 m_TileFenceValue = 0;
+
 	OnnxType m_OnnxType = OnnxType::None;
     OnnxType m_ChangeOnnxType = OnnxType::AdaIN;
 };
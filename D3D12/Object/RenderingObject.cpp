@@ -1,6 +1,7 @@
 #include "RenderingObject.h"
 #include "Manager/DirectXManager.h"
 #include "Manager/ImageManager.h"
+#include "Util/JobSystem.h"
 
 RenderingObject::RenderingObject()
 {
@@ -27,6 +28,55 @@ void RenderingObject::UploadGPUResource(ID3D12GraphicsCommandList7* cmdList)
 {
 	if (!cmdList || !m_Image) return;
 
+	// =====  ε: COPY ť =====
+	//  Ķ  ƹ ť   ->  ť ä direct ť ù   
+	if (mCopyQueueUpload && mTexDirty) {
+		ID3D12Resource* tex = m_Image->GetTexture();
+		const bool copyVB = (m_VBSize > 0 && mVbDirty);
+
+		const FenceTicket ticket = DX_CONTEXT.RecordUploadCopies([&](ID3D12GraphicsCommandList7* copy) {
+			if (copyVB) {
+				copy->CopyBufferRegion(m_VertexBuffer, 0, m_UploadBuffer, m_GeomOffsetInUpload, m_VBSize);
+			}
+
+			D3D12_TEXTURE_COPY_LOCATION src{}, dst{};
+			src.pResource = m_UploadBuffer;
+			src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+			dst.pResource = tex;
+			dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+
+			const UINT copyMips = std::min<UINT>(tex->GetDesc().MipLevels, m_MipCount);
+			for (UINT level = 0; level < copyMips; ++level) {
+				src.PlacedFootprint = m_MipFootprints[level];
+				dst.SubresourceIndex = level;
+				copy->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+			}
+			}, m_GeomOffsetInUpload + (copyVB ? m_VBSize : 0));
+
+		if (ticket.IsValid()) {
+			//  ť   ҽ COMMON decay ->   (VB / PSR|NPSR) direct Ʈ  
+			// ̸ ϴ  Ʈ ù ̹Ƿ ⼭  
+			DX_CONTEXT.WaitForCopy(ticket);
+
+			if (copyVB) {
+				auto toVB = CD3DX12_RESOURCE_BARRIER::Transition(
+					m_VertexBuffer.Get(), D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+				cmdList->ResourceBarrier(1, &toVB);
+				mVBState = D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+				SetVbDirty(false);
+			}
+
+			auto toSRV = CD3DX12_RESOURCE_BARRIER::Transition(
+				tex, D3D12_RESOURCE_STATE_COMMON,
+				D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+			cmdList->ResourceBarrier(1, &toSRV);
+			mTexState = (D3D12_RESOURCE_STATES)
+				(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+			SetTexDirty(false);
+		}
+		mCopyQueueUpload = false;
+	}
+
 	// ===== (A) Vertex Buffer =====
 	if (m_VBSize > 0 && mVbDirty) {
 		if (mVBState != D3D12_RESOURCE_STATE_COPY_DEST) {
@@ -231,7 +281,9 @@ void RenderingObject::UploadTextureBuffer()
 			const UINT curH = (1u > prevH >> 1 ? 1u : prevH >> 1);
 			std::vector<uint8_t> cur(curW * curH * bytesPerPixel);
 
-			for (UINT y = 0; y < curH; ++y) {
+			//   Ŀ й ( mip grain 1 ζ )
+			DX_JOB.ParallelFor(0, curH, 32, [&](size_t row) {
+				const UINT y = (UINT)row;
 				for (UINT x = 0; x < curW; ++x) {
 					const UINT sx = x << 1, sy = y << 1;
 					const uint8_t* A = &prev[(sy * prevW + sx) * bytesPerPixel];
@@ -240,7 +292,7 @@ void RenderingObject::UploadTextureBuffer()
 					const uint8_t* D = &prev[((prevH - 1 < sy + 1 ? prevH - 1 : sy + 1) * prevW + (prevW - 1 < sx + 1 ? prevW - 1 : sx + 1)) * bytesPerPixel];
 					avg4(A, B, C, D, &cur[(y * curW + x) * bytesPerPixel]);
 				}
-			}
+			});
 
 			// ε ۿ    (RowPitch е )
 			BYTE* texDstBase = dst + m_MipFootprints[level].Offset;
@@ -260,11 +312,21 @@ void RenderingObject::UploadTextureBuffer()
 	
 	m_Image->UploadTextureBuffer();
 	mTexState = D3D12_RESOURCE_STATE_COPY_DEST;
+	mVBState = D3D12_RESOURCE_STATE_COPY_DEST;
+	mCopyQueueUpload = true;
 	
 	SetTexDirty(true);
 	SetVbDirty(true);
 }
 
+void RenderingObject::WaitForCopyOnce()
+{
+	if (!m_CopyTicket.IsValid()) return;
+
+	DX_CONTEXT.WaitForCopy(m_CopyTicket);
+	m_CopyTicket = {};
+}
+
 void RenderingObject::CreateSRV()
 {
 	if (m_Image == nullptr)
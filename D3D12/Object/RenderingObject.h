@@ -2,6 +2,7 @@
 #include "Object.h"
 #include "Util/Util.h"
 #include "Support/Image.h"
+#include "D3D/FenceTicket.h"
 
 #include <vector>
 #include <memory>
@@ -42,6 +43,9 @@ protected: // Functions
 	void UpateTexture(BYTE* dst);
 	void UpdateVertexBuffer(BYTE* dst);
 
+	// First use after a copy-queue upload: the direct queue waits for it once
+	void WaitForCopyOnce();
+
 protected: // Variables
 	std::vector<Triangle> m_Triangle;
 
@@ -63,6 +67,10 @@ protected: // Variables
 	bool mVbDirty = true;
 	bool mTexDirty = true;
 
+	// Freshly created resources are filled on the copy queue; later updates stay on the direct list
+	bool mCopyQueueUpload = true;
+	FenceTicket m_CopyTicket;
+
 	UINT m_MipCount = 1;
 	std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> m_MipFootprints;
 	std::vector<UINT>  m_MipNumRowsV;
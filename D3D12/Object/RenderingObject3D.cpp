@@ -42,6 +42,17 @@ void RenderingObject3D::Rendering(
 	const Camera& cam, float aspect,
 	D3D12_CPU_DESCRIPTOR_HANDLE& rtv, D3D12_CPU_DESCRIPTOR_HANDLE& dsv,
 	float angle)
+{
+	Rendering(cmd, cam, aspect, rtv, dsv, angle, DX_MANAGER.GetObjSrvGPU(),
+		DX_MANAGER.GetLightViewProj(), DX_MANAGER.GetLightDirWS());
+}
+
+void RenderingObject3D::Rendering(
+	ID3D12GraphicsCommandList7* cmd,
+	const Camera& cam, float aspect,
+	D3D12_CPU_DESCRIPTOR_HANDLE& rtv, D3D12_CPU_DESCRIPTOR_HANDLE& dsv,
+	float angle, D3D12_GPU_DESCRIPTOR_HANDLE srvTable,
+	const DirectX::XMMATRIX& lightVP, const DirectX::XMFLOAT3& lightDir)
 {
 	using namespace DirectX;
 
@@ -50,6 +61,8 @@ void RenderingObject3D::Rendering(
         return;
     }
 
+	WaitForCopyOnce();
+
 	cmd->SetGraphicsRootSignature(m_RootSig);
 	cmd->SetPipelineState(m_PSO);
 	cmd->OMSetRenderTargets(1, &rtv, FALSE, &dsv);
@@ -63,28 +76,29 @@ void RenderingObject3D::Rendering(
 
 	// MVP, LightVP (transposed)
 	XMFLOAT4X4 mvpT, lightVPT;
-	DX_MANAGER.BuildMVPs(W, cam, aspect, DX_MANAGER.GetLightViewProj(), mvpT, lightVPT);
+	DirectXManager::BuildMVPs(W, cam, aspect, lightVP, mvpT, lightVPT);
 
 	// World ĵ transposed غ (VS/PS mul(vector, matrix) )
 	XMFLOAT4X4 worldT;
 	XMStoreFloat4x4(&worldT, XMMatrixTranspose(W));
 
-	DirectX::XMFLOAT3 ld = DX_MANAGER.GetLightDirWS();
 	float b0[52] = { 0 };
 	memcpy(&b0[0], &mvpT, sizeof(mvpT));     // 16
 	memcpy(&b0[16], &lightVPT, sizeof(lightVPT)); // 16  ( ' lightVP')
 	memcpy(&b0[32], &worldT, sizeof(worldT));   // 16
-	b0[48] = ld.x; b0[49] = ld.y; b0[50] = ld.z; b0[51] = 0.0f;
+	b0[48] = lightDir.x; b0[49] = lightDir.y; b0[50] = lightDir.z; b0[51] = 0.0f;
 	cmd->SetGraphicsRoot32BitConstants(0, 52, b0, 0);
 
 	// PS: t0=albedo, t1=shadow (RenderOffscreen /̽ )
-	cmd->SetGraphicsRootDescriptorTable(1, DX_MANAGER.GetObjSrvGPU());
+	cmd->SetGraphicsRootDescriptorTable(1, srvTable);
 
 	cmd->DrawIndexedInstanced(m_IndexCount, 1, 0, 0, 0);
 }
 
 void RenderingObject3D::RenderingDepthOnly(ID3D12GraphicsCommandList7* cmd)
 {
+	WaitForCopyOnce();
+
 	cmd->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	cmd->IASetVertexBuffers(0, 1, &m_VertexBufferView);
 	cmd->IASetIndexBuffer(&m_IndexBufferView);
@@ -103,38 +117,24 @@ bool RenderingObject3D::InitGeometry(
 	m_IndexCount = index;
 
 	auto dev = DX_CONTEXT.GetDevice();
-	CD3DX12_HEAP_PROPERTIES hpDef(D3D12_HEAP_TYPE_DEFAULT), hpUp(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_HEAP_PROPERTIES hpDef(D3D12_HEAP_TYPE_DEFAULT);
 
-	// VB
-	ComPointer<ID3D12Resource> upVB;
+	// VB / IB (ε DXContext ε  )
 	auto rdVB = CD3DX12_RESOURCE_DESC::Buffer(vbSize);
 	dev->CreateCommittedResource(&hpDef, D3D12_HEAP_FLAG_NONE, &rdVB,
 		D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&m_VertexBuffer));
-	dev->CreateCommittedResource(&hpUp, D3D12_HEAP_FLAG_NONE, &rdVB,
-		D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&upVB));
 
-	// IB
-	ComPointer<ID3D12Resource> upIB;
 	auto rdIB = CD3DX12_RESOURCE_DESC::Buffer(ibSize);
 	dev->CreateCommittedResource(&hpDef, D3D12_HEAP_FLAG_NONE, &rdIB,
 		D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&m_IndexBuffer));
-	dev->CreateCommittedResource(&hpUp, D3D12_HEAP_FLAG_NONE, &rdIB,
-		D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&upIB));
-
-	// ε  ä
-	void* p = nullptr;
-	upVB->Map(0, nullptr, &p);  memcpy(p, vertexBuffer, vbSize);  upVB->Unmap(0, nullptr);
-	upIB->Map(0, nullptr, &p);  memcpy(p, indexBuffer, ibSize);  upIB->Unmap(0, nullptr);
-
-	//  + 
-	ID3D12GraphicsCommandList7* cmd = DX_CONTEXT.InitCommandList();
-	cmd->CopyResource(m_VertexBuffer, upVB);
-	cmd->CopyResource(m_IndexBuffer, upIB);
-	auto b1 = CD3DX12_RESOURCE_BARRIER::Transition(m_VertexBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-	auto b2 = CD3DX12_RESOURCE_BARRIER::Transition(m_IndexBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_INDEX_BUFFER);
-	cmd->ResourceBarrier(1, &b1);
-	cmd->ResourceBarrier(1, &b2);
-	DX_CONTEXT.ExecuteCommandList();
+
+	//  ť ε ( ġ  ű⿡ շ,  VB/IB   )
+	// ۴ COMMON Ͻ °ݵǹǷ  ʿ, ù ο쿡  潺 
+	const bool ownBatch = !DX_CONTEXT.IsInUploadBatch();
+	if (ownBatch) DX_CONTEXT.BeginUploadBatch();
+	DX_CONTEXT.UploadBuffer(m_VertexBuffer, vertexBuffer, vbSize);
+	m_CopyTicket = DX_CONTEXT.UploadBuffer(m_IndexBuffer, indexBuffer, ibSize);
+	if (ownBatch) m_CopyTicket = DX_CONTEXT.EndUploadBatch();
 
 	// VBV/IBV
 	m_VertexBufferView.BufferLocation = m_VertexBuffer->GetGPUVirtualAddress();
@@ -181,14 +181,12 @@ bool RenderingObject3D::InitGeometry(
 
     m_IndexCount = indexCount;
 
-    // 2) ҽ 
+    // 2) ҽ  (default heap; ε ۴ DXContext ε  )
     CD3DX12_HEAP_PROPERTIES hpDef(D3D12_HEAP_TYPE_DEFAULT);
-    CD3DX12_HEAP_PROPERTIES hpUp(D3D12_HEAP_TYPE_UPLOAD);
 
     HRESULT hr = S_OK;
 
     // VB
-    ComPointer<ID3D12Resource> upVB;
     auto rdVB = CD3DX12_RESOURCE_DESC::Buffer((UINT64)vbSize);
 
     hr = dev->CreateCommittedResource(
@@ -201,18 +199,7 @@ bool RenderingObject3D::InitGeometry(
         return false;
     }
 
-    hr = dev->CreateCommittedResource(
-        &hpUp, D3D12_HEAP_FLAG_NONE, &rdVB,
-        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&upVB));
-    if (FAILED(hr)) {
-        char buf[256];
-        sprintf_s(buf, "[InitGeometry] CreateCommittedResource(VB upload) failed: 0x%08X (vbSize=%u)\n", (unsigned)hr, vbSize);
-        OutputDebugStringA(buf);
-        return false;
-    }
-
     // IB
-    ComPointer<ID3D12Resource> upIB;
     auto rdIB = CD3DX12_RESOURCE_DESC::Buffer((UINT64)ibSize);
 
     hr = dev->CreateCommittedResource(
@@ -225,50 +212,24 @@ bool RenderingObject3D::InitGeometry(
         return false;
     }
 
-    hr = dev->CreateCommittedResource(
-        &hpUp, D3D12_HEAP_FLAG_NONE, &rdIB,
-        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&upIB));
-    if (FAILED(hr)) {
-        char buf[256];
-        sprintf_s(buf, "[InitGeometry] CreateCommittedResource(IB upload) failed: 0x%08X (ibSize=%u)\n", (unsigned)hr, ibSize);
-        OutputDebugStringA(buf);
-        return false;
-    }
+    // 3)  ť ε:  ġ  շ (SponzaModel::InitFromOBJ),  VB/IB   
+    //    ۴ COMMON Ͻ °ݵǹǷ  ʿ, ù ο쿡  潺 
+    const bool ownBatch = !DX_CONTEXT.IsInUploadBatch();
+    if (ownBatch) DX_CONTEXT.BeginUploadBatch();
 
-    // 3) ε(  üũ ʼ)
-    void* p = nullptr;
+    const bool uploaded =
+        DX_CONTEXT.UploadBuffer(m_VertexBuffer, vertices, vbSize).IsValid() &&
+        (m_CopyTicket = DX_CONTEXT.UploadBuffer(m_IndexBuffer, indices, ibSize)).IsValid();
 
-    hr = upVB->Map(0, nullptr, &p);
-    if (FAILED(hr) || !p) {
-        OutputDebugStringA("[InitGeometry] upVB->Map failed\n");
-        return false;
+    // 4)    (ġ  )
+    if (ownBatch) {
+        const FenceTicket batchTicket = DX_CONTEXT.EndUploadBatch();
+        if (uploaded) m_CopyTicket = batchTicket;
     }
-    memcpy(p, vertices, vbSize);
-    upVB->Unmap(0, nullptr);
-
-    hr = upIB->Map(0, nullptr, &p);
-    if (FAILED(hr) || !p) {
-        OutputDebugStringA("[InitGeometry] upIB->Map failed\n");
+    if (!uploaded) {
+        OutputDebugStringA("[InitGeometry] upload failed\n");
         return false;
     }
-    memcpy(p, indices, ibSize);
-    upIB->Unmap(0, nullptr);
-
-    // 4)  + 
-    ID3D12GraphicsCommandList7* cmd = DX_CONTEXT.InitCommandList();
-    cmd->CopyResource(m_VertexBuffer, upVB);
-    cmd->CopyResource(m_IndexBuffer, upIB);
-
-    auto b1 = CD3DX12_RESOURCE_BARRIER::Transition(
-        m_VertexBuffer, D3D12_RESOURCE_STATE_COPY_DEST,
-        D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-    auto b2 = CD3DX12_RESOURCE_BARRIER::Transition(
-        m_IndexBuffer, D3D12_RESOURCE_STATE_COPY_DEST,
-        D3D12_RESOURCE_STATE_INDEX_BUFFER);
-    cmd->ResourceBarrier(1, &b1);
-    cmd->ResourceBarrier(1, &b2);
-
-    DX_CONTEXT.ExecuteCommandList();
 
     // 5) VBV/IBV
     m_VertexBufferView.BufferLocation = m_VertexBuffer->GetGPUVirtualAddress();
@@ -26,6 +26,19 @@ public: // Functions
 		D3D12_CPU_DESCRIPTOR_HANDLE& dsv,
 		float angle
 	);
+	// Explicit SRV table and light (computed once by the caller): reads no shared
+	// DX_MANAGER state, safe to record from job threads
+	void Rendering(
+		ID3D12GraphicsCommandList7* cmd,
+		const Camera& cam,
+		float aspect,
+		D3D12_CPU_DESCRIPTOR_HANDLE& rtv,
+		D3D12_CPU_DESCRIPTOR_HANDLE& dsv,
+		float angle,
+		D3D12_GPU_DESCRIPTOR_HANDLE srvTable,
+		const DirectX::XMMATRIX& lightVP,
+		const DirectX::XMFLOAT3& lightDir
+	);
 	void RenderingDepthOnly(
 		ID3D12GraphicsCommandList7* cmd
 	);
@@ -1,6 +1,445 @@
 #include "OnnxRunnerInterface.h"
 #include "D3D/DXContext.h"
+#include "Util/OnnxProfileReport.h"
 
 #include "d3dx12.h"
 #include "d3d12.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <memory>
+
+extern const int ONNX_IO_BUCKET_PX;
+extern const bool ONNX_IO_BUCKET_POW2;
+extern const bool ONNX_PROFILE;
+extern const int ONNX_PROFILE_SKIP_RUNS;
+extern const int ONNX_PROFILE_RUNS;
+
+namespace
+{
+    // Largest alignment tried when learning (in / align) * align from one sample
+    constexpr int64_t kMaxShapeAlign = 64;
+    constexpr double kRunStatsWeight = 0.1;
+    // A kept buffer may be at most this many times its bucket, so a shrink to thumbnail size frees memory
+    constexpr uint64_t kMaxCapacitySlack = 4;
+    // Traces and their summaries go next to the DEBUG_PRINT_IMG captures
+    constexpr const char* kProfileDir = "./Export/Profile";
+    constexpr size_t kProfileTopOps = 5;
+
+    int64_t BucketDim(int64_t d)
+    {
+        if (d <= 0)
+        {
+            return d;
+        }
+        if (ONNX_IO_BUCKET_POW2)
+        {
+            int64_t p = 1;
+            while (p < d)
+            {
+                p <<= 1;
+            }
+            return p;
+        }
+        if (ONNX_IO_BUCKET_PX > 1)
+        {
+            return ((d + ONNX_IO_BUCKET_PX - 1) / ONNX_IO_BUCKET_PX) * ONNX_IO_BUCKET_PX;
+        }
+        return d;
+    }
+}
+
+void OnnxRunnerInterface::InitOutputShapeFunction(const std::wstring& modelPath, size_t contentInput)
+{
+    m_ModelPath = modelPath;
+    m_OutShapeFn = OnnxShapeFunction{};
+    m_OutChannels = 3;
+    m_OutShapePredicted = false;
+    m_InputResizable = false;
+    if (!m_Session || m_Session->GetInputCount() <= contentInput || m_Session->GetOutputCount() == 0)
+    {
+        return;
+    }
+
+    auto inInfo = m_Session->GetInputTypeInfo(contentInput).GetTensorTypeAndShapeInfo();
+    auto outInfo = m_Session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo();
+    const std::vector<int64_t> inShape = inInfo.GetShape();
+    const std::vector<int64_t> outShape = outInfo.GetShape();
+    m_InputResizable = inShape.size() == 4 && inShape[2] <= 0 && inShape[3] <= 0;
+    if (inShape.size() != 4 || outShape.size() != 4)
+    {
+        return;
+    }
+    if (outShape[1] > 0)
+    {
+        m_OutChannels = outShape[1];
+    }
+
+    // Static output dims are constant; a dynamic dim sharing the input's symbol is the identity
+    const std::vector<const char*> inSym = inInfo.GetSymbolicDimensions();
+    const std::vector<const char*> outSym = outInfo.GetSymbolicDimensions();
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        const size_t d = 2 + (size_t)axis;
+        if (outShape[d] > 0)
+        {
+            m_OutShapeFn.fixed[axis] = outShape[d];
+        }
+        else if (d < inSym.size() && d < outSym.size() &&
+            inSym[d] != nullptr && outSym[d] != nullptr && inSym[d][0] != '\0' &&
+            std::strcmp(inSym[d], outSym[d]) == 0)
+        {
+            m_OutShapeFn.align[axis] = 1;
+        }
+    }
+
+    if (m_OutShapeFn.IsKnown())
+    {
+        return;
+    }
+
+    OnnxShapeFunction learned;
+    if (OnnxModelCache::LoadShapeFunction(modelPath, learned))
+    {
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (m_OutShapeFn.IsKnown(axis) == false)
+            {
+                m_OutShapeFn.fixed[axis] = learned.fixed[axis];
+                m_OutShapeFn.align[axis] = learned.align[axis];
+            }
+        }
+    }
+}
+
+bool OnnxRunnerInterface::InitTensorElementType(const Ort::Session& session, size_t input)
+{
+    m_ElemType = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+    m_Precision = "fp32";
+    if (session.GetInputCount() <= input || session.GetOutputCount() == 0)
+    {
+        return false;
+    }
+
+    // Pre/post-process write and read one element type, so the image input and output must agree
+    const ONNXTensorElementDataType inType = session.GetInputTypeInfo(input).GetTensorTypeAndShapeInfo().GetElementType();
+    const ONNXTensorElementDataType outType = session.GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType();
+    const bool supported = inType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || inType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+    if (supported == false || inType != outType)
+    {
+        char buf[256];
+        sprintf_s(buf, "[OnnxRunner] unsupported tensor types (input %d, output %d); convert with keep_io_types=False\n",
+            (int)inType, (int)outType);
+        OutputDebugStringA(buf);
+        return false;
+    }
+
+    m_ElemType = inType;
+
+    // Quantized models keep float IO, so only the converter's metadata tells them apart
+    m_Precision = IsTensorFp16() ? "fp16" : "fp32";
+    Ort::AllocatorWithDefaultOptions alloc;
+    Ort::AllocatedStringPtr precision = session.GetModelMetadata().LookupCustomMetadataMapAllocated("precision", alloc);
+    if (precision)
+    {
+        m_Precision = precision.get();
+    }
+    return true;
+}
+
+bool OnnxRunnerInterface::PredictOutputShape(int64_t inH, int64_t inW, std::vector<int64_t>& outShape) const
+{
+    if (m_OutShapeFn.IsKnown() == false || inH <= 0 || inW <= 0)
+    {
+        return false;
+    }
+
+    const int64_t outH = m_OutShapeFn.Apply(0, inH);
+    const int64_t outW = m_OutShapeFn.Apply(1, inW);
+    if (outH <= 0 || outW <= 0)
+    {
+        return false;
+    }
+    outShape = { (int64_t)m_BatchSize, m_OutChannels, outH, outW };
+    return true;
+}
+
+void OnnxRunnerInterface::LearnOutputShape(int64_t inH, int64_t inW, const std::vector<int64_t>& outShape)
+{
+    if (outShape.size() != 4)
+    {
+        return;
+    }
+    m_OutChannels = outShape[1];
+
+    const int64_t in[2] = { inH, inW };
+    OnnxShapeFunction fn = m_OutShapeFn;
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        const int64_t out = outShape[2 + axis];
+        if (fn.IsKnown(axis) && fn.Apply(axis, in[axis]) == out)
+        {
+            continue;
+        }
+
+        // Largest alignment that explains this sample; after a wrong guess only smaller ones are
+        // tried, so a few resizes converge on the model's real stride
+        int64_t start = kMaxShapeAlign;
+        if (fn.align[axis] > 1)
+        {
+            start = fn.align[axis] / 2;
+        }
+
+        fn.fixed[axis] = 0;
+        fn.align[axis] = 0;
+        for (int64_t align = start; align >= 1; align /= 2)
+        {
+            if ((in[axis] / align) * align == out)
+            {
+                fn.align[axis] = align;
+                break;
+            }
+        }
+    }
+
+    m_OutShapeFn = fn;
+    if (fn.IsKnown())
+    {
+        OnnxModelCache::StoreShapeFunction(m_ModelPath, fn);
+    }
+}
+
+void OnnxRunnerInterface::RecordRunStats(double totalMs, double sessionMs)
+{
+    if (m_Profiling && ++m_ProfileRuns >= (uint64_t)std::max<int>(ONNX_PROFILE_SKIP_RUNS, 0) + (uint64_t)std::max<int>(ONNX_PROFILE_RUNS, 1))
+    {
+        FinishProfiling();
+    }
+
+    const double overheadMs = totalMs > sessionMs ? totalMs - sessionMs : 0.0;
+
+    m_RunStats.lastTotalMs = totalMs;
+    m_RunStats.lastOverheadMs = overheadMs;
+    if (m_RunStats.runs++ == 0)
+    {
+        m_RunStats.avgTotalMs = totalMs;
+        m_RunStats.avgOverheadMs = overheadMs;
+        return;
+    }
+    m_RunStats.avgTotalMs += (totalMs - m_RunStats.avgTotalMs) * kRunStatsWeight;
+    m_RunStats.avgOverheadMs += (overheadMs - m_RunStats.avgOverheadMs) * kRunStatsWeight;
+}
+
+uint64_t OnnxRunnerInterface::CapacityBytes(const std::vector<int64_t>& shape)
+{
+    std::vector<int64_t> bucket = shape;
+    if (bucket.size() == 4)
+    {
+        bucket[2] = BucketDim(bucket[2]);
+        bucket[3] = BucketDim(bucket[3]);
+    }
+    return TensorBytes(bucket);
+}
+
+HRESULT OnnxRunnerInterface::EnsureTensorBuffer(ID3D12Device* dev, const std::vector<int64_t>& shape, const wchar_t* name,
+    ComPointer<ID3D12Resource>& buf, void** dmlAlloc)
+{
+    const uint64_t need = TensorBytes(shape);
+    const uint64_t capacity = CapacityBytes(shape);
+    if (buf && (dmlAlloc == nullptr || *dmlAlloc != nullptr))
+    {
+        const uint64_t width = buf->GetDesc().Width;
+        if (need <= width && width <= capacity * kMaxCapacitySlack)
+        {
+            ++m_RunStats.bufferReuses;
+            return S_OK;
+        }
+    }
+
+    if (dmlAlloc != nullptr && *dmlAlloc != nullptr && m_DmlApi)
+    {
+        m_DmlApi->FreeGPUAllocation(*dmlAlloc);
+        *dmlAlloc = nullptr;
+    }
+    buf.Release();
+
+    auto hp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    auto rd = CD3DX12_RESOURCE_DESC::Buffer(capacity, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+    HRESULT hr = dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&buf));
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+    if (name != nullptr)
+    {
+        buf->SetName(name);
+    }
+
+    if (dmlAlloc != nullptr)
+    {
+        if (m_DmlApi == nullptr)
+        {
+            buf.Release();
+            return E_POINTER;
+        }
+        OrtStatus* st = m_DmlApi->CreateGPUAllocationFromD3DResource(buf.Get(), dmlAlloc);
+        if (st != nullptr)
+        {
+            Ort::GetApi().ReleaseStatus(st);
+            buf.Release();
+            return E_FAIL;
+        }
+    }
+
+    ++m_RunStats.bufferReallocs;
+    return S_OK;
+}
+
+bool OnnxRunnerInterface::CopyDiscoveredOutput(Ort::Value& src, ID3D12Resource* dst, UINT64 bytes)
+{
+    if (dst == nullptr || m_DmlApi == nullptr || !m_Session || !m_Dev || !m_Queue)
+    {
+        return false;
+    }
+
+    // The tensor's data pointer is the DML allocation handle; the API returns its buffer with a reference
+    Ort::Allocator allocator(*m_Session, miDml_);
+    ComPointer<ID3D12Resource> source;
+    OrtStatus* st = m_DmlApi->GetD3D12ResourceFromAllocation(allocator, src.GetTensorMutableRawData(), &source);
+    if (st != nullptr)
+    {
+        Ort::GetApi().ReleaseStatus(st);
+        return false;
+    }
+    if (!source)
+    {
+        return false;
+    }
+    bytes = std::min<UINT64>(bytes, std::min<UINT64>(source->GetDesc().Width, dst->GetDesc().Width));
+
+    // The allocator is free once the previous discovery copy has completed
+    if (m_DiscoveryFence && m_DiscoveryFence->GetCompletedValue() < m_DiscoveryFenceValue)
+    {
+        // No event: blocks until the fence reaches the value
+        m_DiscoveryFence->SetEventOnCompletion(m_DiscoveryFenceValue, nullptr);
+    }
+    const D3D12_COMMAND_LIST_TYPE type = m_Queue->GetDesc().Type;
+    if (!m_DiscoveryFence && FAILED(m_Dev->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_DiscoveryFence))))
+    {
+        return false;
+    }
+    if (!m_DiscoveryAllocator && FAILED(m_Dev->CreateCommandAllocator(type, IID_PPV_ARGS(&m_DiscoveryAllocator))))
+    {
+        return false;
+    }
+    if (FAILED(m_DiscoveryAllocator->Reset()))
+    {
+        return false;
+    }
+    const HRESULT hr = m_DiscoveryList
+        ? m_DiscoveryList->Reset(m_DiscoveryAllocator, nullptr)
+        : m_Dev->CreateCommandList(0, type, m_DiscoveryAllocator, nullptr, IID_PPV_ARGS(&m_DiscoveryList));
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    // DML allocations and EnsureTensorBuffer buffers both sit in UNORDERED_ACCESS between Runs
+    const D3D12_RESOURCE_BARRIER toCopy[] = {
+        CD3DX12_RESOURCE_BARRIER::Transition(source.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE),
+        CD3DX12_RESOURCE_BARRIER::Transition(dst, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST),
+    };
+    m_DiscoveryList->ResourceBarrier(_countof(toCopy), toCopy);
+    m_DiscoveryList->CopyBufferRegion(dst, 0, source.Get(), 0, bytes);
+    const D3D12_RESOURCE_BARRIER toUav[] = {
+        CD3DX12_RESOURCE_BARRIER::Transition(source.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+        CD3DX12_RESOURCE_BARRIER::Transition(dst, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+    };
+    m_DiscoveryList->ResourceBarrier(_countof(toUav), toUav);
+    if (FAILED(m_DiscoveryList->Close()))
+    {
+        return false;
+    }
+
+    // The DML EP submitted the Run on this queue, so the copy executes after it
+    ID3D12CommandList* lists[] = { m_DiscoveryList.Get() };
+    m_Queue->ExecuteCommandLists(1, lists);
+    m_Queue->Signal(m_DiscoveryFence, ++m_DiscoveryFenceValue);
+
+    // ORT may release its temporary as soon as the caller drops the value: keep the buffer until the copy is done
+    m_DiscoverySource = source;
+    return true;
+}
+
+void OnnxRunnerInterface::ApplyProfiling(Ort::SessionOptions& so, const std::wstring& modelPath, const char* epName)
+{
+    m_Profiling = false;
+    m_ProfileRuns = 0;
+    if (ONNX_PROFILE == false)
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(kProfileDir, ec);
+    m_ProfileModel = std::filesystem::path(modelPath).stem().string();
+    m_ProfileEp = epName;
+
+    // ORT appends _<date>.json; profiling covers every Run from session creation until FinishProfiling
+    const std::filesystem::path prefix = std::filesystem::path(kProfileDir) / (m_ProfileModel + "_" + m_ProfileEp);
+    so.EnableProfiling(prefix.c_str());
+    m_Profiling = true;
+}
+
+void OnnxRunnerInterface::FinishProfiling()
+{
+    m_Profiling = false;
+    if (!m_Session)
+    {
+        return;
+    }
+
+    char buf[512];
+    std::string tracePath;
+    try
+    {
+        Ort::AllocatorWithDefaultOptions alloc;
+        tracePath = m_Session->EndProfilingAllocated(alloc).get();
+    }
+    catch (const Ort::Exception& e)
+    {
+        sprintf_s(buf, "[OnnxProfile] EndProfiling failed: %s\n", e.what());
+        OutputDebugStringA(buf);
+        return;
+    }
+
+    OnnxProfileReport report;
+    if (report.Load(tracePath, std::max<int>(ONNX_PROFILE_RUNS, 1)) == false)
+    {
+        sprintf_s(buf, "[OnnxProfile] %s\n", report.GetError().c_str());
+        OutputDebugStringA(buf);
+        return;
+    }
+
+    const OnnxProfileReport::Info info{ m_ProfileModel, m_ProfileEp, m_Precision, m_InShapeContent };
+    const std::string base = (std::filesystem::path(tracePath).parent_path() / std::filesystem::path(tracePath).stem()).string() + "_summary";
+    const bool written = report.WriteCsv(base + ".csv", info) && report.WriteJson(base + ".json", info);
+
+    const int64_t h = m_InShapeContent.size() == 4 ? m_InShapeContent[2] : 0;
+    const int64_t w = m_InShapeContent.size() == 4 ? m_InShapeContent[3] : 0;
+    sprintf_s(buf, "[OnnxProfile] %s (%s, %s, %lldx%lld): %d runs, Run %.3f ms, kernels %.3f ms -> %s%s\n",
+        m_ProfileModel.c_str(), m_ProfileEp.c_str(), m_Precision.c_str(), (long long)w, (long long)h,
+        report.GetRuns(), report.GetRunAvgUs() / 1000.0, report.GetKernelTotalUs() / report.GetRuns() / 1000.0,
+        base.c_str(), written ? ".csv/.json" : " (write failed)");
+    OutputDebugStringA(buf);
+
+    const std::vector<OnnxProfileReport::Entry>& ops = report.GetOpTypes();
+    for (size_t i = 0; i < ops.size() && i < kProfileTopOps; ++i)
+    {
+        sprintf_s(buf, "  %-24s %6.2f%%  %.3f ms/run  (%s)\n", ops[i].name.c_str(),
+            report.GetKernelTotalUs() > 0.0 ? ops[i].totalUs * 100.0 / report.GetKernelTotalUs() : 0.0,
+            ops[i].totalUs / report.GetRuns() / 1000.0, ops[i].provider.c_str());
+        OutputDebugStringA(buf);
+    }
+}
@@ -3,6 +3,9 @@
 #include "D3D/DXContext.h"
 #include "Support/ComPointer.h"
 #include "Util/Util.h"
+#include "Util/OnnxDefine.h"
+#include "Util/OnnxModelCache.h"
+#include "Util/OnnxEnvironment.h"
 
 #include <string>
 #include <vector>
@@ -14,8 +17,11 @@
 class OnnxRunnerInterface
 {
 
+public:
+    // ߷ ػ  (DirectXManager  ػ)
+    static inline int AlignDown8(int v) { return (v / 8) * 8; }
+
 protected:
-    inline int AlignDown8(int v) { return (v / 8) * 8; }
     void FillDynamicNCHW(std::vector<int64_t>& s, int N, int C, int H, int W)
     {
         if (s.size() < 4) s = { N, C, H, W };
@@ -41,6 +47,20 @@ public: // Functions
 
     virtual void Shutdown() {}
 
+    //  : Ը Է/    ( PrepareIO ,   ȯ)
+    // ⺻   1 =   
+    virtual UINT SetPipelineSlotCount(UINT count) { return 1; }
+    virtual UINT GetPipelineSlotCount() const { return 1; }
+    virtual bool RunSlot(UINT slot) { return slot == 0 ? Run() : false; }
+    // Ÿ Է ۸  ä: Ÿ Ư¡ ĳϴ ʴ  Run ٽ ڵ
+    virtual void InvalidateStyle() {}
+    virtual ComPointer<ID3D12Resource> GetSlotOutputBuffer(UINT slot) const { return m_OutputBuf; }
+    virtual ComPointer<ID3D12Resource> GetSlotInputBufferContent(UINT slot) const { return m_InputBufContent; }
+    // ġ ũ N: / N Է ϳ [N,C,H,W]  Run   ( PrepareIO ,   ȯ)
+    // ⺻  N = 1.  N ̸  
+    virtual UINT SetBatchSize(UINT count) { return 1; }
+    UINT GetBatchSize() const { return m_BatchSize; }
+
     //===========Getter=================//
     ComPointer<ID3D12Resource> GetOutputBuffer()       const { return m_OutputBuf; }
     ComPointer<ID3D12Resource> GetInputBufferContent() const { return m_InputBufContent; }
@@ -52,6 +72,30 @@ public: // Functions
 
     virtual void AllocateOutputForShape(const std::vector<int64_t>& shape) {}
 
+    // Run CPU  (DEBUG_TIME ¿). overhead = Run ü - Session::Run (ټ/ε غ )
+    struct RunStats
+    {
+        double lastTotalMs = 0.0;
+        double lastOverheadMs = 0.0;
+        double avgTotalMs = 0.0;
+        double avgOverheadMs = 0.0;
+        uint64_t runs = 0;
+        uint64_t bindingRebuilds = 0;   // ε ٽ  Ƚ (PrepareIO/ResizeIO/ Ҵ)
+        uint64_t bufferReuses = 0;      // ũⰡ ٲ 뷮 ̶ IO ۸ ״  Ƚ
+        uint64_t bufferReallocs = 0;    // IO (+DML Ҵ)   Ƚ
+    };
+    const RunStats& GetRunStats() const { return m_RunStats; }
+
+    // ټ  : fp16 ȯ ̸ FLOAT16 (ó/ó ̴  ũⰡ )
+    ONNXTensorElementDataType GetTensorElementType() const { return m_ElemType; }
+    bool IsTensorFp16() const { return m_ElemType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16; }
+    //  е (fp32/fp16/int8_qdq): ȯ   Ÿ "precision",  ټ 
+    const std::string& GetPrecisionName() const { return m_Precision; }
+    //  Է H/W  (  PrepareIO ũ   ػ)
+    bool IsInputResizable() const { return m_InputResizable; }
+    // ORT ϸ â   
+    bool IsProfiling() const { return m_Profiling; }
+
 protected: // Functions
     inline uint64_t BytesOf(const std::vector<int64_t>& shape, size_t elemBytes)
     {
@@ -61,9 +105,42 @@ protected: // Functions
         return n * static_cast<uint64_t>(elemBytes);
     }
 
+    //  shape Լ (Է H,W ->  H,W): ߷  PrepareIO  Ҵ
+    //    ȣ. /ɺ shape ϰ, 𸣴   н  ǥ 
+    void InitOutputShapeFunction(const std::wstring& modelPath, size_t contentInput = 0);
+    // Լ 𸣸 false (ù Run shape discovery ʿ)
+    bool PredictOutputShape(int64_t inH, int64_t inW, std::vector<int64_t>& outShape) const;
+    // shape discovery  Լ н/ϰ ǥ 
+    void LearnOutputShape(int64_t inH, int64_t inW, const std::vector<int64_t>& outShape);
+
+    void RecordRunStats(double totalMs, double sessionMs);
+
+    // ORT ϸ (ONNX_PROFILE): m_Session   ɼǿ . ־ ONNX_PROFILE_SKIP_RUNS 
+    // ONNX_PROFILE_RUNS  RecordRunStats  /庰   (FinishProfiling)
+    void ApplyProfiling(Ort::SessionOptions& so, const std::wstring& modelPath, const char* epName);
+    void FinishProfiling();
+
+    //  Է/   m_ElemType . FLOAT/FLOAT16 ƴϰų  ٸ false
+    // INT8 QDQ   float ״ζ fp32   (ȭ/ȭ ׷ ȿ)
+    bool InitTensorElementType(const Ort::Session& session, size_t input = 0);
+    size_t ElemBytes() const { return IsTensorFp16() ? sizeof(uint16_t) : sizeof(float); }
+    // ټ  Ʈ : ̴ 4Ʈ(uint)  ϹǷ 4  ø
+    uint64_t TensorBytes(const std::vector<int64_t>& shape) { return (BytesOf(shape, ElemBytes()) + 3) & ~3ull; }
+    // fp16 ó  ϳ  2ȼ(uint ϳ) Ƿ  ¦ 
+    UINT AlignTensorWidth(UINT w) const { return IsTensorFp16() ? (w & ~1u) : w; }
+    //  뷮: H/W ONNX_IO_BUCKET_PX (ONNX_IO_BUCKET_POW2 2 ŵ) ø shape Ʈ 
+    uint64_t CapacityBytes(const std::vector<int64_t>& shape);
+    // shape  UAV  : 뷮 ̰ ʹ ũ  ״ ΰ, ƴϸ 뷮 ũ ٽ 
+    // dmlAlloc null ƴϸ DML allocation  (ٽ) .   Width  뷮 ü 
+    HRESULT EnsureTensorBuffer(ID3D12Device* dev, const std::vector<int64_t>& shape, const wchar_t* name,
+        ComPointer<ID3D12Resource>& buf, void** dmlAlloc);
+    // shape discovery Run (ORT Ҵ ӽ ټ)  ε  ۷  ( ӿ ٽ ߷ )
+    // m_Queue ϹǷ Run  Signal  . ϸ false (ȣ     )
+    bool CopyDiscoveredOutput(Ort::Value& src, ID3D12Resource* dst, UINT64 bytes);
+
 protected: // Variables
 
-    Ort::Env           m_Env{ ORT_LOGGING_LEVEL_WARNING, "app" };
+    Ort::Env&          m_Env = OnnxEnvironment::Get();   //  ʰ  (  Ǯ)
     Ort::SessionOptions m_So;
     std::unique_ptr<Ort::Session> m_Session;
     const OrtDmlApi* m_DmlApi = nullptr;
@@ -81,6 +158,10 @@ protected:
     std::string m_InNameStyle;   
     std::string m_OutName;       
 
+    //   Է shape (  -1). PrepareIO Ź ⼭ N/H/W ä
+    std::vector<int64_t> m_ModelShapeContent;
+    std::vector<int64_t> m_ModelShapeStyle;
+
     //  IO shape 
     std::vector<int64_t> m_InShapeContent; 
     std::vector<int64_t> m_InShapeStyle;   
@@ -98,5 +179,31 @@ protected:
     UINT64 m_InBytesContent = 0;
     UINT64 m_InBytesStyle = 0;
     UINT64 m_OutBytes = 0;
+
+    //  shape Լ.  Ҵ  ù Run   ̰
+    std::wstring m_ModelPath;
+    OnnxShapeFunction m_OutShapeFn;
+    int64_t m_OutChannels = 3;
+    bool m_OutShapePredicted = false;
+    bool m_InputResizable = false;
+    UINT m_BatchSize = 1;
+
+    // shape discovery   (幰  ϳ 潺 ٷ )
+    ComPointer<ID3D12CommandAllocator> m_DiscoveryAllocator;
+    ComPointer<ID3D12GraphicsCommandList> m_DiscoveryList;
+    ComPointer<ID3D12Fence> m_DiscoveryFence;
+    UINT64 m_DiscoveryFenceValue = 0;
+    ComPointer<ID3D12Resource> m_DiscoverySource;   // 簡   ORT ӽ  ۸  
+
+    RunStats m_RunStats;
+
+    // ϸ â:    Run ,  Ӹ   ̸/EP
+    bool m_Profiling = false;
+    uint64_t m_ProfileRuns = 0;
+    std::string m_ProfileModel;
+    std::string m_ProfileEp;
+
+    ONNXTensorElementDataType m_ElemType = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+    std::string m_Precision = "fp32";
 };
 
@@ -1,14 +1,40 @@
 #include "OnnxRunner_AdaIN.h"
 #include "D3D/DXContext.h"
+#include "Util/OnnxModelCache.h"
+#include "Util/OnnxEnvironment.h"
 
 #include "d3dx12.h"
 #include "d3d12.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <memory>
 
 #ifndef THROW_IF_FAILED
 #define THROW_IF_FAILED(hrcall) do { HRESULT _hr=(hrcall); if(FAILED(_hr)) { throw std::runtime_error("HRESULT failed"); } } while(0)
 #endif
 
+extern const bool ADAIN_SPLIT_STYLE;
+
+// <name>_end2end_2inputs_*.onnx -> <name>_style_encoder_*.onnx + <name>_decoder_*.onnx (  ־  )
+static bool FindSplitModels(const std::wstring& modelPath, std::wstring& encoderPath, std::wstring& decoderPath)
+{
+    const std::wstring tag = L"end2end_2inputs";
+    const size_t pos = modelPath.find(tag);
+    if (pos == std::wstring::npos)
+    {
+        return false;
+    }
+
+    encoderPath = modelPath;
+    encoderPath.replace(pos, tag.size(), L"style_encoder");
+    decoderPath = modelPath;
+    decoderPath.replace(pos, tag.size(), L"decoder");
+
+    std::error_code ec;
+    return std::filesystem::exists(encoderPath, ec) && std::filesystem::exists(decoderPath, ec);
+}
+
 
 bool OnnxRunner_AdaIN::Init(const std::wstring& modelPath, ID3D12Device* dev, ID3D12CommandQueue* queue)
 {
@@ -20,7 +46,7 @@ bool OnnxRunner_AdaIN::Init(const std::wstring& modelPath, ID3D12Device* dev, ID
     m_So = Ort::SessionOptions{};
     m_So.DisableMemPattern(); // 
     m_So.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
-    m_So.SetIntraOpNumThreads(0);
+    OnnxEnvironment::ApplySessionThreading(m_So, 0);
     m_So.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
 
     Ort::ThrowOnError(Ort::GetApi().GetExecutionProviderApi(
@@ -28,33 +54,56 @@ bool OnnxRunner_AdaIN::Init(const std::wstring& modelPath, ID3D12Device* dev, ID
     Ort::ThrowOnError(m_DmlApi->SessionOptionsAppendExecutionProvider_DML1(
         m_So, dml.Get(), m_Queue));
 
-    m_Session = std::make_unique<Ort::Session>(m_Env, modelPath.c_str(), m_So);
+    //  ׷  Ÿ ڴ Ÿ ٲ ,    ڴ + AdaIN + ڴ
+    std::wstring encoderPath, decoderPath;
+    m_SplitStyle = ADAIN_SPLIT_STYLE && FindSplitModels(modelPath, encoderPath, decoderPath);
+    m_StyleEncoded = false;
+    m_ContentInputIndex = 0;
+    if (m_SplitStyle)
+    {
+        m_StyleSession = OnnxModelCache::CreateSession(m_Env, encoderPath, m_So, "DML");
+        // ϸ   ϴ ڴ
+        ApplyProfiling(m_So, decoderPath, "DML");
+        m_Session = OnnxModelCache::CreateSession(m_Env, decoderPath, m_So, "DML");
+    }
+    else
+    {
+        ApplyProfiling(m_So, modelPath, "DML");
+        m_Session = OnnxModelCache::CreateSession(m_Env, modelPath, m_So, "DML");
+    }
     miDml_ = Ort::MemoryInfo("DML", OrtAllocatorType::OrtDeviceAllocator, 0, OrtMemTypeDefault);
 
     Ort::AllocatorWithDefaultOptions alloc;
 
-    int inputCount = m_Session->GetInputCount();
-    for (int i = 0; i < inputCount; ++i)
+    if (m_SplitStyle)
     {
-        switch (i)
-        {
-        case 0:
-        {
-            auto inName0 = m_Session->GetInputNameAllocated(0, alloc);
-            m_InNameContent = inName0.get();
-            auto info0 = m_Session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo();
-            m_InShapeContent = info0.GetShape();
-        }
-        break;
-
-        case 1:
+        InitSplitIO();
+    }
+    else
+    {
+        int inputCount = m_Session->GetInputCount();
+        for (int i = 0; i < inputCount; ++i)
         {
-            auto inName1 = m_Session->GetInputNameAllocated(1, alloc);
-            m_InNameStyle = inName1.get();
-            auto info1 = m_Session->GetInputTypeInfo(1).GetTensorTypeAndShapeInfo();
-            m_InShapeStyle = info1.GetShape();
-        }
-        break;
+            switch (i)
+            {
+            case 0:
+            {
+                auto inName0 = m_Session->GetInputNameAllocated(0, alloc);
+                m_InNameContent = inName0.get();
+                auto info0 = m_Session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo();
+                m_InShapeContent = info0.GetShape();
+            }
+            break;
+
+            case 1:
+            {
+                auto inName1 = m_Session->GetInputNameAllocated(1, alloc);
+                m_InNameStyle = inName1.get();
+                auto info1 = m_Session->GetInputTypeInfo(1).GetTensorTypeAndShapeInfo();
+                m_InShapeStyle = info1.GetShape();
+            }
+            break;
+            }
         }
     }
     int outputCount = m_Session->GetOutputCount();
@@ -72,114 +121,185 @@ bool OnnxRunner_AdaIN::Init(const std::wstring& modelPath, ID3D12Device* dev, ID
         break;
         }
     }
+
+    m_ModelShapeContent = m_InShapeContent;
+    m_ModelShapeStyle = m_InShapeStyle;
+
+    // fp16 ȯ ̸ Է/ ټ FLOAT16 ε
+    if (!InitTensorElementType(*m_Session, m_ContentInputIndex)) return false;
+
+    InitOutputShapeFunction(m_SplitStyle ? decoderPath : modelPath, m_ContentInputIndex);
     return true;
 }
 
-bool OnnxRunner_AdaIN::PrepareIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
+void OnnxRunner_AdaIN::InitSplitIO()
 {
-    // 1) Է shape Ȯ
-    auto inShapeContent = m_InShapeContent; // [-1,3,-1,-1] 
-    auto inShapeStyle = m_InShapeStyle;
-    FillDynamicNCHW(inShapeContent, 1, 3, (int)contentH, (int)contentW);
-    FillDynamicNCHW(inShapeStyle, 1, 3, (int)styleH, (int)styleW);
-
-    // 2) Ʈ  (÷ο   uint64_t ϴ BytesOf  )
-    m_InBytesContent = BytesOf(inShapeContent, sizeof(float));
-    m_InBytesStyle = BytesOf(inShapeStyle, sizeof(float));
-    if (m_InBytesContent == 0 || m_InBytesStyle == 0) return false;
+    Ort::AllocatorWithDefaultOptions alloc;
 
-    // 3)  Է ҽ/Ҵ  (GPU  ̸ ȣ  ȭ ʿ)
-    if (m_InAllocContent) { m_DmlApi->FreeGPUAllocation(m_InAllocContent); m_InAllocContent = nullptr; }
-    if (m_InAllocStyle) { m_DmlApi->FreeGPUAllocation(m_InAllocStyle);   m_InAllocStyle = nullptr; }
-    m_InputBufContent.Release();
-    m_InputBufStyle.Release();
+    // ڴ: Է = Ÿ ̹,  = Ÿ Ư¡ (ڴ Է° ̸ ƾ )
+    m_InNameStyle = m_StyleSession->GetInputNameAllocated(0, alloc).get();
+    m_InShapeStyle = m_StyleSession->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
 
-    // 4) UAV   + DML allocation 
-    CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);
+    m_StyleFeatureNames.clear();
+    for (size_t i = 0; i < m_StyleSession->GetOutputCount(); ++i)
     {
-        auto rd = CD3DX12_RESOURCE_DESC::Buffer(m_InBytesContent, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-        THROW_IF_FAILED(dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
-            D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&m_InputBufContent)));
-        m_InputBufContent->SetName(L"ORT_Input_Content");
-        Ort::ThrowOnError(m_DmlApi->CreateGPUAllocationFromD3DResource(m_InputBufContent.Get(), &m_InAllocContent));
+        m_StyleFeatureNames.push_back(m_StyleSession->GetOutputNameAllocated(i, alloc).get());
     }
+
+    // ڴ: Ÿ Ư¡ ƴ Է 
+    m_InNameContent.clear();
+    for (size_t i = 0; i < m_Session->GetInputCount(); ++i)
     {
-        auto rd = CD3DX12_RESOURCE_DESC::Buffer(m_InBytesStyle, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-        THROW_IF_FAILED(dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
-            D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&m_InputBufStyle)));
-        m_InputBufStyle->SetName(L"ORT_Input_Style");
-        Ort::ThrowOnError(m_DmlApi->CreateGPUAllocationFromD3DResource(m_InputBufStyle.Get(), &m_InAllocStyle));
+        std::string name = m_Session->GetInputNameAllocated(i, alloc).get();
+        if (std::find(m_StyleFeatureNames.begin(), m_StyleFeatureNames.end(), name) == m_StyleFeatureNames.end())
+        {
+            m_InNameContent = name;
+            m_InShapeContent = m_Session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+            m_ContentInputIndex = i;
+            break;
+        }
     }
+    if (m_InNameContent.empty() || m_Session->GetInputCount() != m_StyleFeatureNames.size() + 1)
+    {
+        throw std::runtime_error("AdaIN decoder inputs must be content + style encoder outputs");
+    }
+}
+
+bool OnnxRunner_AdaIN::PrepareIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
+{
+    // 1) Է shape Ȯ
+    // Ÿ Ư¡  ̶  N = 1 (m_BatchSize ״)
+    auto inShapeContent = m_ModelShapeContent; // [-1,3,-1,-1] 
+    auto inShapeStyle = m_ModelShapeStyle;
+    FillDynamicNCHW(inShapeContent, (int)m_BatchSize, 3, (int)contentH, (int)AlignTensorWidth(contentW));
+    FillDynamicNCHW(inShapeStyle, 1, 3, (int)styleH, (int)AlignTensorWidth(styleW));
+
+    // 2) Ʈ  ( ũ  : fp32 4 / fp16 2, 4Ʈ )
+    m_InBytesContent = TensorBytes(inShapeContent);
+    m_InBytesStyle = TensorBytes(inShapeStyle);
+    if (m_InBytesContent == 0 || m_InBytesStyle == 0) return false;
+
+    // 3)  ټ/ε  (GPU  ̸ ȣ  ȭ ʿ)
+    ReleaseBindings();
+
+    // 4) UAV  + DML allocation: 뷮 ̸ ״, ƴϸ 뷮 ܰ ũ ٽ 
+    THROW_IF_FAILED(EnsureTensorBuffer(dev, inShapeContent, L"ORT_Input_Content", m_InputBufContent, &m_InAllocContent));
+    THROW_IF_FAILED(EnsureTensorBuffer(dev, inShapeStyle, L"ORT_Input_Style", m_InputBufStyle, &m_InAllocStyle));
 
     // 5) Ȯ Է shape  (  ó/ε/ġ  ġؾ )
     m_InShapeContent = std::move(inShapeContent);
     m_InShapeStyle = std::move(inShapeStyle);
 
-    // 6)   Run 1ȸ Ÿ shape Ҵ
-    m_OutShape.clear();
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc); m_OutAlloc = nullptr; }
-    m_OutputBuf.Release();
-    m_OutBytes = 0;
+    // 6) Է ټ + ε:   , PrepareIO/ResizeIO ٽ 
+    m_InTensorContent = Ort::Value::CreateTensor(
+        miDml_, m_InAllocContent, m_InBytesContent,
+        m_InShapeContent.data(), m_InShapeContent.size(),
+        m_ElemType);
+    m_InTensorStyle = Ort::Value::CreateTensor(
+        miDml_, m_InAllocStyle, m_InBytesStyle,
+        m_InShapeStyle.data(), m_InShapeStyle.size(),
+        m_ElemType);
+
+    if (!m_Binding)
+    {
+        m_Binding = std::make_unique<Ort::IoBinding>(*m_Session);
+    }
+    m_Binding->BindInput(m_InNameContent.c_str(), m_InTensorContent);
+    if (m_SplitStyle)
+    {
+        // Ÿ ̹ ڴ Է, Ư¡ EncodeStyle ڴ ε (ORT GPU Ҵ)
+        if (!m_StyleBinding)
+        {
+            m_StyleBinding = std::make_unique<Ort::IoBinding>(*m_StyleSession);
+        }
+        m_StyleBinding->BindInput(m_InNameStyle.c_str(), m_InTensorStyle);
+        for (const std::string& name : m_StyleFeatureNames)
+        {
+            m_StyleBinding->BindOutput(name.c_str(), miDml_);
+        }
+    }
+    else
+    {
+        m_Binding->BindInput(m_InNameStyle.c_str(), m_InTensorStyle);
+    }
+    ++m_RunStats.bindingRebuilds;
+
+    // 7) : shape Լ ٷ Ҵ (𸣸  Run 1ȸ Ÿ shape Ҵ)
+    std::vector<int64_t> outShape;
+    m_OutShapePredicted = PredictOutputShape(m_InShapeContent[2], m_InShapeContent[3], outShape);
+    if (m_OutShapePredicted)
+    {
+        AllocateOutputForShape(outShape);
+    }
+    else
+    {
+        // ù Run shape discovery     ( ũ ۸ ó  ʵ)
+        ReleaseOutput();
+    }
 
     return true;
 }
 
 bool OnnxRunner_AdaIN::Run()
 {
+    const auto runBegin = std::chrono::steady_clock::now();
+    double sessionMs = 0.0;
+    auto timedRun = [&]() {
+        const auto begin = std::chrono::steady_clock::now();
+        m_Session->Run(Ort::RunOptions{ nullptr }, *m_Binding);
+        sessionMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        };
+
     try {
-        // === (0)  ˻: Ʈ shape ġϴ ( ܰ assert )
-        auto bytesOf = [](const std::vector<int64_t>& s) { return size_t(s[0]) * s[1] * s[2] * s[3] * sizeof(float); };
-        if (m_InBytesContent != bytesOf(m_InShapeContent)) return false;
-        if (m_InBytesStyle != bytesOf(m_InShapeStyle))   return false;
-
-        // === (1) Է ε (GPU ޸)
-        Ort::Value inContent = Ort::Value::CreateTensor(
-            miDml_, m_InAllocContent, m_InBytesContent,
-            m_InShapeContent.data(), m_InShapeContent.size(),
-            ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
-        Ort::Value inStyle = Ort::Value::CreateTensor(
-            miDml_, m_InAllocStyle, m_InBytesStyle,
-            m_InShapeStyle.data(), m_InShapeStyle.size(),
-            ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
-
-        Ort::IoBinding io(*m_Session);
-        io.BindInput(m_InNameContent.c_str(), inContent);
-        io.BindInput(m_InNameStyle.c_str(), inStyle);
-
-        // === (2) ù :    ORT GPU Ҵ (shape ľǿ)
-        if (!m_OutAlloc) {
-            io.BindOutput(m_OutName.c_str(), miDml_);  // GPU ӽ 
-            m_Session->Run(Ort::RunOptions{ nullptr }, io);
+        // === (0)  ˻: PrepareIO  Ʈ shape ġϴ
+        if (!m_Binding) return false;
+        if (m_InBytesContent != TensorBytes(m_InShapeContent)) return false;
+        if (m_InBytesStyle != TensorBytes(m_InShapeStyle))   return false;
+
+        // === (1)  ׷: Ÿ ٲ  ڴ 
+        if (m_SplitStyle && !m_StyleEncoded) {
+            const auto begin = std::chrono::steady_clock::now();
+            if (!EncodeStyle()) return false;
+            sessionMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        }
+
+        // === (2) shape Լ  :    ORT GPU Ҵ (shape ľǿ)
+        if (!m_OutTensor) {
+            m_Binding->BindOutput(m_OutName.c_str(), miDml_);  // GPU ӽ 
+            timedRun();
 
             // shape ȸ
-            auto outs = io.GetOutputValues();
+            auto outs = m_Binding->GetOutputValues();
             auto info = outs[0].GetTensorTypeAndShapeInfo();
             auto shape = info.GetShape();              // e.g., [1,3,H,W]
-            AllocateOutputForShape(shape);             //   ҽ/DML alloc 
-
-            // ε غ
-            io.ClearBoundInputs();
-            io.ClearBoundOutputs();
-
-            // Է ٽ ε
-            io.BindInput(m_InNameContent.c_str(), inContent);
-            io.BindInput(m_InNameStyle.c_str(), inStyle);
+            AllocateOutputForShape(shape);             //   ҽ/DML alloc  + ε ü
+            LearnOutputShape(m_InShapeContent[2], m_InShapeContent[3], shape); // ʹ ߷  Ҵ
+
+            // ̹ Run    ۷ ϸ ̹   (縦    Ʒ    )
+            if (CopyDiscoveredOutput(outs[0], m_OutputBuf.Get(), m_OutBytes))
+            {
+                RecordRunStats(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runBegin).count(), sessionMs);
+                return true;
+            }
         }
 
-        // === (3)  ° :   ۷ 
-        Ort::Value outTensor = Ort::Value::CreateTensor(
-            miDml_, m_OutAlloc, m_OutBytes,
-            m_OutShape.data(), m_OutShape.size(),
-            ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
-        io.BindOutput(m_OutName.c_str(), outTensor);
+        // === (3) Է/   ε:   Run
+        timedRun();
+        m_OutShapePredicted = false; //  shape ¾
 
-        m_Session->Run(Ort::RunOptions{ nullptr }, io);
-
-        io.ClearBoundInputs();
-        io.ClearBoundOutputs();
+        RecordRunStats(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runBegin).count(), sessionMs);
         return true;
     }
     catch (const Ort::Exception& e) {
+        //   shape Ʋ:   shape discovery    (Լ )
+        if (m_OutShapePredicted)
+        {
+            m_OutShapePredicted = false;
+            ReleaseOutput();
+            OutputDebugStringA("ORT Run failed with predicted output shape, retrying with shape discovery\n");
+            return Run();
+        }
+
         // ̽   α
         char buf[512];
         HRESULT reason = m_Dev ? m_Dev->GetDeviceRemovedReason() : S_OK;
@@ -191,53 +311,123 @@ bool OnnxRunner_AdaIN::Run()
 
 void OnnxRunner_AdaIN::ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
 {
-    if (m_InAllocContent) { m_DmlApi->FreeGPUAllocation(m_InAllocContent); m_InAllocContent = nullptr; }
-    if (m_InAllocStyle) { m_DmlApi->FreeGPUAllocation(m_InAllocStyle);   m_InAllocStyle = nullptr; }
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc);       m_OutAlloc = nullptr; }
-
-    m_InputBufContent.Release();
-    m_InputBufStyle.Release();
-    m_OutputBuf.Release();
-
+    // ۴ PrepareIO 뷮  ٽ ų  
     PrepareIO(dev, contentW, contentH, styleW, styleH);
 }
 
 void OnnxRunner_AdaIN::Shutdown()
 {
-    if (m_InAllocContent) { m_DmlApi->FreeGPUAllocation(m_InAllocContent); m_InAllocContent = nullptr; }
-    if (m_InAllocStyle) { m_DmlApi->FreeGPUAllocation(m_InAllocStyle);   m_InAllocStyle = nullptr; }
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc);       m_OutAlloc = nullptr; }
-
-    m_InputBufContent.Release();
-    m_InputBufStyle.Release();
-    m_OutputBuf.Release();
+    ReleaseOutput();
+    ReleaseInputs();
+    m_Binding.reset();
+    m_StyleBinding.reset();
 
     m_Session.reset();
+    m_StyleSession.reset();
+}
+
+bool OnnxRunner_AdaIN::EncodeStyle()
+{
+    if (!m_StyleSession || !m_StyleBinding || !m_Binding)
+    {
+        return false;
+    }
+
+    // Ÿ Է ۴ ó ä (߷ ť ó  ٸ  )
+    m_StyleSession->Run(Ort::RunOptions{ nullptr }, *m_StyleBinding);
+    m_StyleFeatures = m_StyleBinding->GetOutputValues();
+    if (m_StyleFeatures.size() != m_StyleFeatureNames.size())
+    {
+        return false;
+    }
+
+    //  ̸ ٽ εϸ  Ư¡ ü
+    for (size_t i = 0; i < m_StyleFeatures.size(); ++i)
+    {
+        m_Binding->BindInput(m_StyleFeatureNames[i].c_str(), m_StyleFeatures[i]);
+    }
+    m_StyleEncoded = true;
+    return true;
 }
 
 void OnnxRunner_AdaIN::AllocateOutputForShape(const std::vector<int64_t>& shape)
 {
-    // shape = [1,3,H_out,W_out]  (Ÿ  '¥' ũ)
-    if (shape.size() != 4 || shape[0] != 1 || shape[1] != 3)
+    // shape = [N,3,H_out,W_out]  (Ÿ  '¥' ũ, N = Է ġ)
+    if (shape.size() != 4 || shape[0] != m_InShapeContent[0] || shape[1] != 3)
         throw std::runtime_error("Unexpected output shape");
 
+    //   ټ  (۴ 뷮 ̸ ״)
+    if (m_Binding) m_Binding->ClearBoundOutputs();
+    m_OutTensor = Ort::Value{ nullptr };
+
     m_OutShape = shape;
 
     // Ʈ  
-    uint64_t n = 1;
-    for (auto d : shape) n *= static_cast<uint64_t>(d);
-    m_OutBytes = n * sizeof(float);
+    m_OutBytes = TensorBytes(shape);
 
-    //   ҽ 
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc); m_OutAlloc = nullptr; }
-    m_OutputBuf.Release();
+    THROW_IF_FAILED(EnsureTensorBuffer(m_Dev, m_OutShape, L"ORT_Output", m_OutputBuf, &m_OutAlloc));
+
+    //  ټ  ε
+    m_OutTensor = Ort::Value::CreateTensor(
+        miDml_, m_OutAlloc, m_OutBytes,
+        m_OutShape.data(), m_OutShape.size(),
+        m_ElemType);
+    if (m_Binding)
+    {
+        m_Binding->BindOutput(m_OutName.c_str(), m_OutTensor);
+        ++m_RunStats.bindingRebuilds;
+    }
+}
 
-    //    
-    CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);
-    CD3DX12_RESOURCE_DESC rd = CD3DX12_RESOURCE_DESC::Buffer(m_OutBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-    THROW_IF_FAILED(m_Dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
-        D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&m_OutputBuf)));
-    m_OutputBuf->SetName(L"ORT_Output");
+void OnnxRunner_AdaIN::ReleaseBindings()
+{
+    // ε ټ ŰǷ ε
+    if (m_Binding)
+    {
+        m_Binding->ClearBoundInputs();
+        m_Binding->ClearBoundOutputs();
+    }
+    if (m_StyleBinding)
+    {
+        m_StyleBinding->ClearBoundInputs();
+        m_StyleBinding->ClearBoundOutputs();
+    }
+    m_StyleFeatures.clear();
+    m_StyleEncoded = false;
+    m_InTensorContent = Ort::Value{ nullptr };
+    m_InTensorStyle = Ort::Value{ nullptr };
+    m_OutTensor = Ort::Value{ nullptr };
+    m_OutShape.clear();
+    m_OutBytes = 0;
+}
 
-    Ort::ThrowOnError(m_DmlApi->CreateGPUAllocationFromD3DResource(m_OutputBuf.Get(), &m_OutAlloc));
+void OnnxRunner_AdaIN::ReleaseInputs()
+{
+    // ε ټ, ټ DML allocation ŰǷ   
+    if (m_Binding) m_Binding->ClearBoundInputs();
+    if (m_StyleBinding)
+    {
+        m_StyleBinding->ClearBoundInputs();
+        m_StyleBinding->ClearBoundOutputs();
+    }
+    m_StyleFeatures.clear();
+    m_StyleEncoded = false;
+    m_InTensorContent = Ort::Value{ nullptr };
+    m_InTensorStyle = Ort::Value{ nullptr };
+
+    if (m_InAllocContent) { m_DmlApi->FreeGPUAllocation(m_InAllocContent); m_InAllocContent = nullptr; }
+    if (m_InAllocStyle) { m_DmlApi->FreeGPUAllocation(m_InAllocStyle);   m_InAllocStyle = nullptr; }
+    m_InputBufContent.Release();
+    m_InputBufStyle.Release();
+}
+
+void OnnxRunner_AdaIN::ReleaseOutput()
+{
+    if (m_Binding) m_Binding->ClearBoundOutputs();
+    m_OutTensor = Ort::Value{ nullptr };
+
+    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc); m_OutAlloc = nullptr; }
+    m_OutputBuf.Release();
+    m_OutShape.clear();
+    m_OutBytes = 0;
 }
\ No newline at end of file
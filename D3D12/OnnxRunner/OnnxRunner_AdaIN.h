@@ -12,7 +12,32 @@ public: // Functions
     virtual void ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH) override;
     virtual void Shutdown() override;
     virtual void AllocateOutputForShape(const std::vector<int64_t>& shape) override;
+    virtual void InvalidateStyle() override { m_StyleEncoded = false; }
 
 protected:
+    void InitSplitIO();
+    // Split graph only: runs the style encoder and binds its features as decoder inputs
+    bool EncodeStyle();
+    // Drops tensors and bindings only; the IO buffers stay for the next PrepareIO to reuse
+    void ReleaseBindings();
+    void ReleaseInputs();
+    void ReleaseOutput();
+
+protected:
+    // Bound once in PrepareIO/ResizeIO (output once its shape is known) and reused by every Run
+    std::unique_ptr<Ort::IoBinding> m_Binding;
+    Ort::Value m_InTensorContent{ nullptr };
+    Ort::Value m_InTensorStyle{ nullptr };
+    Ort::Value m_OutTensor{ nullptr };
+
+    // Split graph (<name>_style_encoder / <name>_decoder next to <name>_end2end_2inputs):
+    // the style encoder runs once per style, its outputs stay on the GPU as decoder inputs
+    bool m_SplitStyle = false;
+    bool m_StyleEncoded = false;
+    size_t m_ContentInputIndex = 0;
+    std::unique_ptr<Ort::Session> m_StyleSession;
+    std::unique_ptr<Ort::IoBinding> m_StyleBinding;
+    std::vector<std::string> m_StyleFeatureNames;
+    std::vector<Ort::Value> m_StyleFeatures;
 };
 
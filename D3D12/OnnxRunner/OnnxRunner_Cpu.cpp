@@ -0,0 +1,367 @@
+#include "OnnxRunner_Cpu.h"
+#include "D3D/DXContext.h"
+#include "Util/OnnxModelCache.h"
+#include "Util/OnnxEnvironment.h"
+
+#include "d3dx12.h"
+#include "d3d12.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+extern const int ONNX_CPU_THREADS;
+
+bool OnnxRunner_Cpu::Init(const std::wstring& modelPath, ID3D12Device* dev, ID3D12CommandQueue* queue)
+{
+    m_Dev = dev; m_Queue = queue;
+
+    OnnxCpuSession::Config config;
+    config.intraOpThreads = ONNX_CPU_THREADS;
+    config.globalThreadPools = OnnxEnvironment::UsesGlobalPools();
+    m_So = OnnxCpuSession::MakeOptions(config);
+    ApplyProfiling(m_So, modelPath, "CPU");
+
+    try {
+        m_Session = OnnxModelCache::CreateSession(m_Env, modelPath, m_So, "CPU");
+    }
+    catch (const Ort::Exception& e) {
+        char buf[512];
+        sprintf_s(buf, "[OnnxRunner_Cpu] session creation failed: %s\n", e.what());
+        OutputDebugStringA(buf);
+        return false;
+    }
+
+    if (m_Cpu.Init(m_Session.get()) == false)
+    {
+        char buf[512];
+        sprintf_s(buf, "[OnnxRunner_Cpu] %s\n", m_Cpu.GetError().c_str());
+        OutputDebugStringA(buf);
+        return false;
+    }
+
+    m_InNameContent = m_Cpu.GetInputName(0);
+    m_ModelShapeContent = m_Cpu.GetModelInputShape(0);
+    m_InShapeContent = m_ModelShapeContent;
+    if (m_Cpu.GetInputCount() > 1)
+    {
+        m_InNameStyle = m_Cpu.GetInputName(1);
+        m_ModelShapeStyle = m_Cpu.GetModelInputShape(1);
+        m_InShapeStyle = m_ModelShapeStyle;
+    }
+    m_OutName = m_Cpu.GetOutputName();
+    m_OutShape = m_Cpu.GetModelOutputShape();
+
+    if (!InitTensorElementType(*m_Session)) return false;
+    InitOutputShapeFunction(modelPath);
+
+    char buf[256];
+    sprintf_s(buf, "[OnnxRunner_Cpu] CPU EP, %d intra-op threads (%s), %s\n",
+        config.globalThreadPools ? OnnxEnvironment::GetIntraOpThreads() : std::max<int>(ONNX_CPU_THREADS, 0),
+        config.globalThreadPools ? "global pool" : "own pool, 0 = ORT default",
+        m_Dev ? "staging through the inference queue" : "host tensors only");
+    OutputDebugStringA(buf);
+    return true;
+}
+
+bool OnnxRunner_Cpu::PrepareIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
+{
+    // Device buffers are kept while the new shapes fit their capacity (CreateStaging / AllocateOutputForShape)
+    WaitForCopies();
+    m_InBytesContent = 0;
+    m_InBytesStyle = 0;
+    m_OutBytes = 0;
+    m_OutShape.clear();
+
+    // Same sizes the DML runners bind: single-input style nets take multiples of 4, two-input nets any even width
+    const bool twoInputs = m_Cpu.GetInputCount() > 1;
+    const UINT W = twoInputs ? AlignTensorWidth(contentW) : (contentW / 4) * 4;
+    const UINT H = twoInputs ? contentH : (contentH / 4) * 4;
+
+    std::vector<int64_t> inShapeContent = m_ModelShapeContent;
+    std::vector<int64_t> inShapeStyle = m_ModelShapeStyle;
+    FillDynamicNCHW(inShapeContent, (int)m_BatchSize, 3, (int)H, (int)W);
+    if (twoInputs)
+    {
+        FillDynamicNCHW(inShapeStyle, 1, 3, (int)styleH, (int)AlignTensorWidth(styleW));
+    }
+
+    std::vector<int64_t> outShape;
+    m_OutShapePredicted = PredictOutputShape(inShapeContent[2], inShapeContent[3], outShape);
+    if (m_Cpu.Prepare(inShapeContent, inShapeStyle, m_OutShapePredicted ? outShape : std::vector<int64_t>{}) == false)
+    {
+        char buf[512];
+        sprintf_s(buf, "[OnnxRunner_Cpu] PrepareIO %ux%u failed: %s\n", W, H, m_Cpu.GetError().c_str());
+        OutputDebugStringA(buf);
+        return false;
+    }
+
+    m_InShapeContent = std::move(inShapeContent);
+    m_InBytesContent = TensorBytes(m_InShapeContent);
+    if (twoInputs)
+    {
+        m_InShapeStyle = std::move(inShapeStyle);
+        m_InBytesStyle = TensorBytes(m_InShapeStyle);
+    }
+    m_StyleDirty = true;
+    ++m_RunStats.bindingRebuilds;
+
+    m_Dev = dev;
+    if (m_Dev && CreateStaging() == false)
+    {
+        OutputDebugStringA("[OnnxRunner_Cpu] staging buffers could not be created\n");
+        ReleaseBuffers();
+        return false;
+    }
+
+    // Static or predicted output: the post-process can bind it before the first Run
+    if (m_Cpu.IsOutputBound())
+    {
+        AllocateOutputForShape(m_Cpu.GetOutputShape());
+    }
+    else
+    {
+        // No output buffer until the first Run discovers the shape, as with the DML runners
+        m_OutputBuf.Release();
+        m_Upload.Release();
+    }
+    return true;
+}
+
+bool OnnxRunner_Cpu::Run()
+{
+    const auto runBegin = std::chrono::steady_clock::now();
+
+    if (m_Dev)
+    {
+        // The inference queue already waits for the pre-process, so the copy sees this frame's input
+        if (!m_InputBufContent || SubmitCopy(false) == false)
+        {
+            return false;
+        }
+        WaitForCopies();
+
+        const bool style = m_StyleDirty && m_InputBufStyle;
+        D3D12_RANGE readRange{ 0, (SIZE_T)(m_InBytesContent + (style ? m_InBytesStyle : 0)) };
+        uint8_t* mapped = nullptr;
+        if (FAILED(m_Readback->Map(0, &readRange, reinterpret_cast<void**>(&mapped))))
+        {
+            return false;
+        }
+        std::memcpy(m_Cpu.GetInputData(0), mapped, std::min<size_t>(m_Cpu.GetInputBytes(0), (size_t)m_InBytesContent));
+        if (style)
+        {
+            std::memcpy(m_Cpu.GetInputData(1), mapped + m_InBytesContent, std::min<size_t>(m_Cpu.GetInputBytes(1), (size_t)m_InBytesStyle));
+            m_StyleDirty = false;
+        }
+        D3D12_RANGE noWrite{ 0, 0 };
+        m_Readback->Unmap(0, &noWrite);
+    }
+
+    if (m_Cpu.Run() == false)
+    {
+        char buf[512];
+        sprintf_s(buf, "ORT Run failed (CPU EP): %s\n", m_Cpu.GetError().c_str());
+        OutputDebugStringA(buf);
+        return false;
+    }
+
+    // First Run without a known output shape, or a wrong prediction the session ran again with discovery
+    if (m_Cpu.GetOutputShape() != m_OutShape || (m_Dev && !m_Upload))
+    {
+        AllocateOutputForShape(m_Cpu.GetOutputShape());
+        LearnOutputShape(m_InShapeContent[2], m_InShapeContent[3], m_OutShape);
+    }
+    m_OutShapePredicted = false;
+
+    if (m_Dev)
+    {
+        uint8_t* mapped = nullptr;
+        D3D12_RANGE noRead{ 0, 0 };
+        if (!m_Upload || FAILED(m_Upload->Map(0, &noRead, reinterpret_cast<void**>(&mapped))))
+        {
+            return false;
+        }
+        std::memcpy(mapped, m_Cpu.GetOutputData(), std::min<size_t>(m_Cpu.GetOutputBytes(), (size_t)m_OutBytes));
+        m_Upload->Unmap(0, nullptr);
+
+        // Not waited on here: the caller's inference signal comes after it on the same queue
+        if (SubmitCopy(true) == false)
+        {
+            return false;
+        }
+    }
+
+    RecordRunStats(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runBegin).count(), m_Cpu.GetLastSessionMs());
+    return true;
+}
+
+void OnnxRunner_Cpu::ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
+{
+    PrepareIO(dev, contentW, contentH, styleW, styleH);
+}
+
+void OnnxRunner_Cpu::Shutdown()
+{
+    WaitForCopies();
+    ReleaseBuffers();
+    m_Cpu.Release();
+
+    m_CopyList.Release();
+    m_CopyAllocator.Release();
+    m_CopyFence.Release();
+
+    m_Session.reset();
+}
+
+void OnnxRunner_Cpu::AllocateOutputForShape(const std::vector<int64_t>& shape)
+{
+    m_OutShape = shape;
+    m_OutBytes = TensorBytes(shape);
+    if (!m_Dev)
+    {
+        return;
+    }
+
+    // The upload buffer follows the output buffer's capacity, so it is only recreated with it
+    if (FAILED(EnsureTensorBuffer(m_Dev, m_OutShape, L"ORT_Output", m_OutputBuf, nullptr))
+        || CreateHostBuffer(D3D12_HEAP_TYPE_UPLOAD, m_OutputBuf->GetDesc().Width, L"ORT_CPU_Output_Upload", m_Upload,
+            !m_Upload || m_Upload->GetDesc().Width != m_OutputBuf->GetDesc().Width) == false)
+    {
+        OutputDebugStringA("[OnnxRunner_Cpu] output buffers could not be created\n");
+        m_OutputBuf.Release();
+        m_Upload.Release();
+        return;
+    }
+    ++m_RunStats.bindingRebuilds;
+}
+
+bool OnnxRunner_Cpu::CreateStaging()
+{
+    // Tensor buffers look exactly like the DML runners' (UAV state between passes), capacity-bucketed the same way
+    if (FAILED(EnsureTensorBuffer(m_Dev, m_InShapeContent, L"ORT_Input_Content", m_InputBufContent, nullptr)))
+    {
+        return false;
+    }
+    if (m_InBytesStyle == 0)
+    {
+        m_InputBufStyle.Release();
+    }
+    else if (FAILED(EnsureTensorBuffer(m_Dev, m_InShapeStyle, L"ORT_Input_Style", m_InputBufStyle, nullptr)))
+    {
+        return false;
+    }
+
+    // Sized for the capacities, so it only grows together with them
+    const UINT64 readbackBytes = m_InputBufContent->GetDesc().Width + (m_InputBufStyle ? m_InputBufStyle->GetDesc().Width : 0);
+    if (CreateHostBuffer(D3D12_HEAP_TYPE_READBACK, readbackBytes, L"ORT_CPU_Input_Readback", m_Readback,
+        !m_Readback || m_Readback->GetDesc().Width != readbackBytes) == false)
+    {
+        return false;
+    }
+
+    if (!m_CopyAllocator && FAILED(m_Dev->CreateCommandAllocator(m_Queue->GetDesc().Type, IID_PPV_ARGS(&m_CopyAllocator))))
+    {
+        return false;
+    }
+    if (!m_CopyFence && FAILED(m_Dev->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_CopyFence))))
+    {
+        return false;
+    }
+    return true;
+}
+
+bool OnnxRunner_Cpu::CreateHostBuffer(D3D12_HEAP_TYPE type, UINT64 bytes, const wchar_t* name, ComPointer<ID3D12Resource>& buf, bool recreate)
+{
+    if (buf && recreate == false)
+    {
+        return true;
+    }
+    buf.Release();
+
+    CD3DX12_HEAP_PROPERTIES hp(type);
+    auto rd = CD3DX12_RESOURCE_DESC::Buffer(bytes);
+    const D3D12_RESOURCE_STATES state = type == D3D12_HEAP_TYPE_READBACK ? D3D12_RESOURCE_STATE_COPY_DEST : D3D12_RESOURCE_STATE_GENERIC_READ;
+    if (FAILED(m_Dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd, state, nullptr, IID_PPV_ARGS(&buf))))
+    {
+        return false;
+    }
+    buf->SetName(name);
+    return true;
+}
+
+bool OnnxRunner_Cpu::SubmitCopy(bool upload)
+{
+    // The allocator is free once the previous copy has completed
+    WaitForCopies();
+    if (FAILED(m_CopyAllocator->Reset()))
+    {
+        return false;
+    }
+    const HRESULT hr = m_CopyList
+        ? m_CopyList->Reset(m_CopyAllocator, nullptr)
+        : m_Dev->CreateCommandList(0, m_Queue->GetDesc().Type, m_CopyAllocator, nullptr, IID_PPV_ARGS(&m_CopyList));
+    if (FAILED(hr))
+    {
+        return false;
+    }
+
+    auto copy = [this](ID3D12Resource* staging, UINT64 stagingOffset, ID3D12Resource* gpu, UINT64 bytes, bool toGpu) {
+        const D3D12_RESOURCE_STATES copyState = toGpu ? D3D12_RESOURCE_STATE_COPY_DEST : D3D12_RESOURCE_STATE_COPY_SOURCE;
+        auto toCopy = CD3DX12_RESOURCE_BARRIER::Transition(gpu, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, copyState);
+        m_CopyList->ResourceBarrier(1, &toCopy);
+        if (toGpu)
+        {
+            m_CopyList->CopyBufferRegion(gpu, 0, staging, stagingOffset, bytes);
+        }
+        else
+        {
+            m_CopyList->CopyBufferRegion(staging, stagingOffset, gpu, 0, bytes);
+        }
+        auto toUav = CD3DX12_RESOURCE_BARRIER::Transition(gpu, copyState, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        m_CopyList->ResourceBarrier(1, &toUav);
+        };
+
+    if (upload)
+    {
+        copy(m_Upload.Get(), 0, m_OutputBuf.Get(), m_OutBytes, true);
+    }
+    else
+    {
+        copy(m_Readback.Get(), 0, m_InputBufContent.Get(), m_InBytesContent, false);
+        if (m_StyleDirty && m_InputBufStyle)
+        {
+            copy(m_Readback.Get(), m_InBytesContent, m_InputBufStyle.Get(), m_InBytesStyle, false);
+        }
+    }
+
+    if (FAILED(m_CopyList->Close()))
+    {
+        return false;
+    }
+    ID3D12CommandList* lists[] = { m_CopyList.Get() };
+    m_Queue->ExecuteCommandLists(1, lists);
+    m_Queue->Signal(m_CopyFence, ++m_CopyFenceValue);
+    return true;
+}
+
+void OnnxRunner_Cpu::WaitForCopies()
+{
+    if (m_CopyFence && m_CopyFence->GetCompletedValue() < m_CopyFenceValue)
+    {
+        // No event: blocks until the fence reaches the value
+        m_CopyFence->SetEventOnCompletion(m_CopyFenceValue, nullptr);
+    }
+}
+
+void OnnxRunner_Cpu::ReleaseBuffers()
+{
+    m_InputBufContent.Release();
+    m_InputBufStyle.Release();
+    m_OutputBuf.Release();
+    m_Readback.Release();
+    m_Upload.Release();
+    m_InBytesContent = 0;
+    m_InBytesStyle = 0;
+    m_OutBytes = 0;
+    m_OutShape.clear();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "OnnxRunnerInterface.h"
+#include "Util/OnnxCpuSession.h"
+
+// ORT CPU execution provider over host-memory tensors (OnnxCpuSession), any one- or two-input style model
+// With a device (DML unavailable, or ONNX_CPU_EP) the IO buffers are the same UAV buffers the pre/post passes
+// bind for DML: Run copies the inputs back to the host on the inference queue, waits, runs on the CPU and
+// queues the upload of the output, so the passes and the inference tickets work unchanged.
+// Without a device (headless) the tensors stay in host memory only: GetHostInput/GetHostOutput.
+class OnnxRunner_Cpu : public OnnxRunnerInterface
+{
+
+public: // Functions
+    virtual bool Init(const std::wstring& modelPath, ID3D12Device* dev, ID3D12CommandQueue* queue) override;
+    virtual bool PrepareIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH) override;
+    virtual bool Run() override;
+    virtual void ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH) override;
+    virtual void Shutdown() override;
+    virtual void AllocateOutputForShape(const std::vector<int64_t>& shape) override;
+    virtual void InvalidateStyle() override { m_StyleDirty = true; }
+
+    // Host tensors (0 = content, 1 = style), filled directly when running without a device
+    void* GetHostInput(size_t i) { return i < m_Cpu.GetInputCount() ? m_Cpu.GetInputData(i) : nullptr; }
+    const void* GetHostOutput() const { return m_Cpu.IsOutputBound() ? m_Cpu.GetOutputData() : nullptr; }
+    const OnnxCpuSession& GetCpuSession() const { return m_Cpu; }
+
+protected:
+    bool CreateStaging();
+    // Readback/upload staging, created when missing or when recreate is set
+    bool CreateHostBuffer(D3D12_HEAP_TYPE type, UINT64 bytes, const wchar_t* name, ComPointer<ID3D12Resource>& buf, bool recreate);
+    // Records into the copy list, executes it on m_Queue and signals m_CopyFence
+    bool SubmitCopy(bool upload);
+    void WaitForCopies();
+    void ReleaseBuffers();
+
+protected:
+    OnnxCpuSession m_Cpu;
+    bool m_StyleDirty = true;       // style input changes rarely: read back only after InvalidateStyle
+
+    // Device bridge (null when headless)
+    ComPointer<ID3D12Resource> m_Readback;      // content, then style
+    ComPointer<ID3D12Resource> m_Upload;        // output
+    ComPointer<ID3D12CommandAllocator> m_CopyAllocator;
+    ComPointer<ID3D12GraphicsCommandList> m_CopyList;
+    ComPointer<ID3D12Fence> m_CopyFence;
+    UINT64 m_CopyFenceValue = 0;
+};
@@ -1,8 +1,12 @@
 #include "OnnxRunner_FastNeuralStyle.h"
 #include "D3D/DXContext.h"
+#include "Util/OnnxModelCache.h"
+#include "Util/OnnxEnvironment.h"
 
 #include "d3dx12.h"
 #include "d3d12.h"
+#include <algorithm>
+#include <chrono>
 #include <memory>
 
 #ifndef THROW_IF_FAILED
@@ -20,14 +24,15 @@ bool OnnxRunner_FastNeuralStyle::Init(const std::wstring& modelPath, ID3D12Devic
     m_So = Ort::SessionOptions{};
     m_So.DisableMemPattern();
     m_So.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
-    m_So.SetIntraOpNumThreads(0);
+    OnnxEnvironment::ApplySessionThreading(m_So, 0);
     m_So.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
 
     Ort::ThrowOnError(Ort::GetApi().GetExecutionProviderApi("DML", ORT_API_VERSION,
         reinterpret_cast<const void**>(&m_DmlApi)));
     Ort::ThrowOnError(m_DmlApi->SessionOptionsAppendExecutionProvider_DML1(m_So, dml.Get(), m_Queue));
 
-    m_Session = std::make_unique<Ort::Session>(m_Env, modelPath.c_str(), m_So);
+    ApplyProfiling(m_So, modelPath, "DML");
+    m_Session = OnnxModelCache::CreateSession(m_Env, modelPath, m_So, "DML");
     miDml_ = Ort::MemoryInfo("DML", OrtAllocatorType::OrtDeviceAllocator, 0, OrtMemTypeDefault);
 
     Ort::AllocatorWithDefaultOptions alloc;
@@ -46,10 +51,15 @@ bool OnnxRunner_FastNeuralStyle::Init(const std::wstring& modelPath, ID3D12Devic
         m_OutName = outName0.get();
         m_OutShape = m_Session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
     }
+    m_ModelShapeContent = m_InShapeContent;
+    SetBatchSize(m_BatchSize); //  N ̸  
 
-    //  IoBinding 
-    m_Binding = std::make_unique<Ort::IoBinding>(*m_Session);
+    // fp16 ȯ ̸ Է/ ټ FLOAT16 ε
+    if (!InitTensorElementType(*m_Session)) return false;
 
+    InitOutputShapeFunction(modelPath);
+
+    // Ժ IoBinding PrepareIO 
     return true;
 }
 
@@ -58,83 +68,153 @@ bool OnnxRunner_FastNeuralStyle::PrepareIO(ID3D12Device* dev, UINT contentW, UIN
     const UINT W = (contentW / 4) * 4;
     const UINT H = (contentH / 4) * 4;
 
-    auto inShapeContent = m_InShapeContent; //  [-1,3,-1,-1]
-    FillDynamicNCHW(inShapeContent, 1, 3, (int)H, (int)W);
-    m_InBytesContent = BytesOf(inShapeContent, sizeof(float));
+    auto inShapeContent = m_ModelShapeContent; //  [-1,3,-1,-1]
+    FillDynamicNCHW(inShapeContent, (int)m_BatchSize, 3, (int)H, (int)W);
+    m_InBytesContent = TensorBytes(inShapeContent);
     if (m_InBytesContent == 0) return false;
-
-    if (m_InAllocContent) { m_DmlApi->FreeGPUAllocation(m_InAllocContent); m_InAllocContent = nullptr; }
-    m_InputBufContent.Release();
-
-    CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);
-    auto rd = CD3DX12_RESOURCE_DESC::Buffer(m_InBytesContent, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-    THROW_IF_FAILED(dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
-        D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&m_InputBufContent)));
-    m_InputBufContent->SetName(L"ORT_Input_Content");
-    Ort::ThrowOnError(m_DmlApi->CreateGPUAllocationFromD3DResource(m_InputBufContent.Get(), &m_InAllocContent));
-
     m_InShapeContent = std::move(inShapeContent);
-    m_InTensorDML = Ort::Value::CreateTensor(
-        miDml_, m_InAllocContent, m_InBytesContent,
-        m_InShapeContent.data(), m_InShapeContent.size(),
-        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
 
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc); m_OutAlloc = nullptr; }
-    m_OutputBuf.Release();
+    //  shape Լ Ʒ Ҵ (𸣸 ù Run shape Ȯ   Կ Ҵ)
     m_OutBytes = 0;
-    m_OutTensorDML = Ort::Value{ nullptr };
     m_OutShape.clear();
     m_OutputBound = false;
 
-    m_Binding->ClearBoundInputs();
-    m_Binding->ClearBoundOutputs();
-    m_Binding->BindInput(m_InNameContent.c_str(), m_InTensorDML);
-    m_Binding->BindOutput(m_OutName.c_str(), miDml_); // shape discovery
+    for (UINT i = 0; i < ONNX_MAX_PIPELINE_SLOTS; ++i)
+    {
+        PipelineSlot& slot = m_Slots[i];
+        if (slot.binding)
+        {
+            slot.binding->ClearBoundInputs();
+            slot.binding->ClearBoundOutputs();
+        }
+        if (i >= m_SlotCount)
+        {
+            ReleaseSlotOutput(slot);
+            ReleaseSlotInput(slot);
+            slot.binding.reset();
+            continue;
+        }
+
+        // ۴ 뷮 ̸ ״ ΰ ټ/ε  shape
+        slot.inTensor = Ort::Value{ nullptr };
+        slot.outTensor = Ort::Value{ nullptr };
+        wchar_t name[32];
+        swprintf_s(name, L"ORT_Input_Content_%u", i);
+        THROW_IF_FAILED(EnsureTensorBuffer(dev, m_InShapeContent, name, slot.inBuf, &slot.inAlloc));
+
+        slot.inTensor = Ort::Value::CreateTensor(
+            miDml_, slot.inAlloc, m_InBytesContent,
+            m_InShapeContent.data(), m_InShapeContent.size(),
+            m_ElemType);
+
+        if (!slot.binding)
+        {
+            slot.binding = std::make_unique<Ort::IoBinding>(*m_Session);
+        }
+        slot.binding->BindInput(m_InNameContent.c_str(), slot.inTensor);
+        slot.binding->BindOutput(m_OutName.c_str(), miDml_); // shape discovery
+        ++m_RunStats.bindingRebuilds;
+    }
+
+    //  ( )  0
+    m_InputBufContent = m_Slots[0].inBuf;
+    m_OutputBuf.Release();
+
+    // shape Լ ˸ ߷   Ҵ +  ε ( ߷ 1ȸ)
+    std::vector<int64_t> outShape;
+    m_OutShapePredicted = PredictOutputShape(m_InShapeContent[2], m_InShapeContent[3], outShape);
+    if (m_OutShapePredicted)
+    {
+        AllocateOutputForShape(outShape);
+        m_OutputBound = true;
+    }
+    else
+    {
+        // ù Run shape discovery     ( ũ ۸ ó  ʵ)
+        for (UINT i = 0; i < m_SlotCount; ++i)
+        {
+            ReleaseSlotOutput(m_Slots[i]);
+        }
+    }
 
     return true;
 }
 
 bool OnnxRunner_FastNeuralStyle::Run()
 {
+    return RunSlot(0);
+}
+
+bool OnnxRunner_FastNeuralStyle::RunSlot(UINT slotIndex)
+{
+    if (slotIndex >= m_SlotCount || !m_Slots[slotIndex].binding)
+    {
+        return false;
+    }
+    Ort::IoBinding& binding = *m_Slots[slotIndex].binding;
+
+    const auto runBegin = std::chrono::steady_clock::now();
+    double sessionMs = 0.0;
+    auto timedRun = [&]() {
+        const auto begin = std::chrono::steady_clock::now();
+        m_Session->Run(Ort::RunOptions{ nullptr }, binding);
+        sessionMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        };
+
     try {
-        auto bytesOf = [](const std::vector<int64_t>& s) {
-            return size_t(s[0]) * size_t(s[1]) * size_t(s[2]) * size_t(s[3]) * sizeof(float);
-            };
-        if (m_InBytesContent != bytesOf(m_InShapeContent)) return false;
+        if (m_InBytesContent != TensorBytes(m_InShapeContent)) return false;
 
-        // 1)   ε ʾҴٸ: 1ȸ shape discovery
+        // 1) shape Լ   ε ʾҴٸ: 1ȸ shape discovery
         if (!m_OutputBound) {
-            m_Session->Run(Ort::RunOptions{ nullptr }, *m_Binding); // ӽ ¿ 
+            timedRun(); // ӽ ¿ 
 
             // shape Ȯ
-            auto outs = m_Binding->GetOutputValues();
+            auto outs = binding.GetOutputValues();
             auto info = outs[0].GetTensorTypeAndShapeInfo();
-            auto shape = info.GetShape(); // [1,3,H,W] 
+            auto shape = info.GetShape(); // [N,3,H,W] 
 
-            //   /ټ غ
+            //    /ټ غ + " ε" ȯ
             AllocateOutputForShape(shape);
-            m_OutTensorDML = Ort::Value::CreateTensor(
-                miDml_, m_OutAlloc, m_OutBytes,
-                m_OutShape.data(), m_OutShape.size(),
-                ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
-
-            //  ε " ε" ȯ
-            m_Binding->ClearBoundOutputs(); // Է ״ 
-            m_Binding->BindOutput(m_OutName.c_str(), m_OutTensorDML);
-
             m_OutputBound = true;
-
-            // :  ӿ      ± 
-            // (ʿ   ȣ ص )
-            m_Session->Run(Ort::RunOptions{ nullptr }, *m_Binding);
+            LearnOutputShape(m_InShapeContent[2], m_InShapeContent[3], shape); // ʹ ߷  Ҵ
+
+            // ̹ Run  ORT ӽ ¿ :  ε  ۷ ؼ ״ 
+            // (縦     ε    . ó  ۸ )
+            if (!CopyDiscoveredOutput(outs[0], m_Slots[slotIndex].outBuf.Get(), m_OutBytes))
+            {
+                timedRun();
+            }
+            RecordRunStats(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runBegin).count(), sessionMs);
             return true;
         }
 
         // 2) ±  ε ٸ,   ׳ Run!
-        m_Session->Run(Ort::RunOptions{ nullptr }, *m_Binding);
+        timedRun();
+        m_OutShapePredicted = false; //  shape ¾
+        RecordRunStats(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runBegin).count(), sessionMs);
         return true;
     }
     catch (const Ort::Exception& e) {
+        //   shape Ʋ:   shape discovery    (Լ )
+        if (m_OutShapePredicted)
+        {
+            m_OutShapePredicted = false;
+            for (UINT i = 0; i < m_SlotCount; ++i)
+            {
+                PipelineSlot& slot = m_Slots[i];
+                if (!slot.binding) continue;
+                slot.binding->ClearBoundOutputs();
+                ReleaseSlotOutput(slot);
+                slot.binding->BindOutput(m_OutName.c_str(), miDml_);
+            }
+            m_OutputBuf.Release();
+            m_OutShape.clear();
+            m_OutBytes = 0;
+            m_OutputBound = false;
+            OutputDebugStringA("ORT Run failed with predicted output shape, retrying with shape discovery\n");
+            return RunSlot(slotIndex);
+        }
+
         char buf[512];
         HRESULT reason = m_Dev ? m_Dev->GetDeviceRemovedReason() : S_OK;
         sprintf_s(buf, "ORT Run failed: %s (GetDeviceRemovedReason=0x%08X)\n", e.what(), (unsigned)reason);
@@ -145,9 +225,7 @@ bool OnnxRunner_FastNeuralStyle::Run()
 
 void OnnxRunner_FastNeuralStyle::ResizeIO(ID3D12Device* dev, UINT contentW, UINT contentH, UINT styleW, UINT styleH)
 {
-    if (m_InAllocContent) { m_DmlApi->FreeGPUAllocation(m_InAllocContent); m_InAllocContent = nullptr; }
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc);       m_OutAlloc = nullptr; }
-
+    //  ۴ PrepareIO 뷮  ٽ ų  
     m_InputBufContent.Release();
     m_OutputBuf.Release();
 
@@ -163,8 +241,13 @@ void OnnxRunner_FastNeuralStyle::ResizeIO(ID3D12Device* dev, UINT contentW, UINT
 
 void OnnxRunner_FastNeuralStyle::Shutdown()
 {
-    if (m_InAllocContent) { m_DmlApi->FreeGPUAllocation(m_InAllocContent); m_InAllocContent = nullptr; }
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc);       m_OutAlloc = nullptr; }
+    for (PipelineSlot& slot : m_Slots)
+    {
+        slot.binding.reset();
+        ReleaseSlotOutput(slot);
+        ReleaseSlotInput(slot);
+    }
+    m_OutputBound = false;
 
     m_InputBufContent.Release();
     m_OutputBuf.Release();
@@ -181,27 +264,75 @@ void OnnxRunner_FastNeuralStyle::Shutdown()
 
 void OnnxRunner_FastNeuralStyle::AllocateOutputForShape(const std::vector<int64_t>& shape)
 {
-    // shape = [1,3,H_out,W_out]  (Ÿ  '¥' ũ)
-    if (shape.size() != 4 || shape[0] != 1 || shape[1] != 3)
+    // shape = [N,3,H_out,W_out]  (Ÿ  '¥' ũ, N = Է ġ)
+    if (shape.size() != 4 || shape[0] != m_InShapeContent[0] || shape[1] != 3)
         throw std::runtime_error("Unexpected output shape");
 
     m_OutShape = shape;
 
     // Ʈ  
-    uint64_t n = 1;
-    for (auto d : shape) n *= static_cast<uint64_t>(d);
-    m_OutBytes = n * sizeof(float);
+    m_OutBytes = TensorBytes(shape);
 
-    //   ҽ 
-    if (m_OutAlloc) { m_DmlApi->FreeGPUAllocation(m_OutAlloc); m_OutAlloc = nullptr; }
-    m_OutputBuf.Release();
+    for (UINT i = 0; i < m_SlotCount; ++i)
+    {
+        PipelineSlot& slot = m_Slots[i];
+
+        //   ټ  (۴ 뷮 ̸ ״)
+        if (slot.binding) slot.binding->ClearBoundOutputs(); // Է ״ 
+        slot.outTensor = Ort::Value{ nullptr };
+
+        wchar_t name[32];
+        swprintf_s(name, L"ORT_Output_%u", i);
+        THROW_IF_FAILED(EnsureTensorBuffer(m_Dev, m_OutShape, name, slot.outBuf, &slot.outAlloc));
+        slot.outTensor = Ort::Value::CreateTensor(
+            miDml_, slot.outAlloc, m_OutBytes,
+            m_OutShape.data(), m_OutShape.size(),
+            m_ElemType);
+
+        if (slot.binding)
+        {
+            slot.binding->BindOutput(m_OutName.c_str(), slot.outTensor);
+            ++m_RunStats.bindingRebuilds;
+        }
+    }
 
-    //    
-    CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);
-    CD3DX12_RESOURCE_DESC rd = CD3DX12_RESOURCE_DESC::Buffer(m_OutBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-    THROW_IF_FAILED(m_Dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &rd,
-        D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&m_OutputBuf)));
-    m_OutputBuf->SetName(L"ORT_Output");
+    m_OutputBuf = m_Slots[0].outBuf;
+}
+
+UINT OnnxRunner_FastNeuralStyle::SetPipelineSlotCount(UINT count)
+{
+    m_SlotCount = std::clamp<UINT>(count, 1, ONNX_MAX_PIPELINE_SLOTS);
+    return m_SlotCount;
+}
 
-    Ort::ThrowOnError(m_DmlApi->CreateGPUAllocationFromD3DResource(m_OutputBuf.Get(), &m_OutAlloc));
-}
\ No newline at end of file
+UINT OnnxRunner_FastNeuralStyle::SetBatchSize(UINT count)
+{
+    // A model exported with a fixed N only ever takes that many
+    const int64_t modelBatch = m_ModelShapeContent.size() == 4 ? m_ModelShapeContent[0] : 1;
+    m_BatchSize = modelBatch > 0 ? (UINT)modelBatch : std::clamp<UINT>(count, 1, ONNX_MAX_BATCH);
+    return m_BatchSize;
+}
+
+ComPointer<ID3D12Resource> OnnxRunner_FastNeuralStyle::GetSlotOutputBuffer(UINT slot) const
+{
+    return slot < m_SlotCount ? m_Slots[slot].outBuf : ComPointer<ID3D12Resource>{};
+}
+
+ComPointer<ID3D12Resource> OnnxRunner_FastNeuralStyle::GetSlotInputBufferContent(UINT slot) const
+{
+    return slot < m_SlotCount ? m_Slots[slot].inBuf : ComPointer<ID3D12Resource>{};
+}
+
+void OnnxRunner_FastNeuralStyle::ReleaseSlotInput(PipelineSlot& slot)
+{
+    slot.inTensor = Ort::Value{ nullptr };
+    if (slot.inAlloc) { m_DmlApi->FreeGPUAllocation(slot.inAlloc); slot.inAlloc = nullptr; }
+    slot.inBuf.Release();
+}
+
+void OnnxRunner_FastNeuralStyle::ReleaseSlotOutput(PipelineSlot& slot)
+{
+    slot.outTensor = Ort::Value{ nullptr };
+    if (slot.outAlloc) { m_DmlApi->FreeGPUAllocation(slot.outAlloc); slot.outAlloc = nullptr; }
+    slot.outBuf.Release();
+}
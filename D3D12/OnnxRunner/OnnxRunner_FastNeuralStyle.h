@@ -13,10 +13,32 @@ public: // Functions
     virtual void Shutdown() override;
     virtual void AllocateOutputForShape(const std::vector<int64_t>& shape) override;
 
+    virtual UINT SetPipelineSlotCount(UINT count) override;
+    virtual UINT GetPipelineSlotCount() const override { return m_SlotCount; }
+    virtual bool RunSlot(UINT slot) override;
+    virtual UINT SetBatchSize(UINT count) override;
+    virtual ComPointer<ID3D12Resource> GetSlotOutputBuffer(UINT slot) const override;
+    virtual ComPointer<ID3D12Resource> GetSlotInputBufferContent(UINT slot) const override;
+
+protected:
+    // One input/output pair per pipeline slot, each with its own fixed binding
+    struct PipelineSlot
+    {
+        ComPointer<ID3D12Resource> inBuf;
+        ComPointer<ID3D12Resource> outBuf;
+        void* inAlloc = nullptr;
+        void* outAlloc = nullptr;
+        Ort::Value inTensor{ nullptr };
+        Ort::Value outTensor{ nullptr };
+        std::unique_ptr<Ort::IoBinding> binding;
+    };
+
+    void ReleaseSlotInput(PipelineSlot& slot);
+    void ReleaseSlotOutput(PipelineSlot& slot);
+
 protected:
-    std::unique_ptr<Ort::IoBinding> m_Binding; 
-    Ort::Value m_InTensorDML{ nullptr };       
-    Ort::Value m_OutTensorDML{ nullptr };      
-    bool m_OutputBound = false;                
+    PipelineSlot m_Slots[ONNX_MAX_PIPELINE_SLOTS];
+    UINT m_SlotCount = 1;
+    bool m_OutputBound = false;     // every slot shares the output shape
 };
 
@@ -0,0 +1,27 @@
+// cs_history.hlsl
+// Ű(߷ ) ó   ̸ .  Űӱ cs_reproject 
+
+cbuffer CB : register(b0)
+{
+    float4x4 CurInvViewProj; // ̹  clip -> world
+    float4x4 KeyViewProj; //  Ű world -> clip
+    uint W, H;
+    float NearZ, FarZ;
+    float DepthTolerance, FillRadius, _pad0, _pad1;
+};
+
+Texture2D<float4> gColor : register(t0); // OnnxTex
+Texture2D<float> gDepth : register(t1); //   (D32 -> R32_FLOAT)
+
+RWTexture2D<float4> gHistColor : register(u0);
+RWTexture2D<float> gHistDepth : register(u1);
+
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= W || id.y >= H)
+        return;
+
+    gHistColor[id.xy] = gColor[id.xy];
+    gHistDepth[id.xy] = gDepth[id.xy];
+}
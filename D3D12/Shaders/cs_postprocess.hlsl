@@ -3,18 +3,38 @@
 static const uint OUT_TANH = 0x0001; // [-1,1] -> [0,1]
 static const uint OUT_255 = 0x0002; // [0,255] -> [0,1]
 
+// TENSOR_FP16: fp16  . half 2 uint ϳ (¦ ε =  16Ʈ)
+#ifndef TENSOR_FP16
+#define TENSOR_FP16 0
+#endif
+
+#if TENSOR_FP16
+StructuredBuffer<uint> gOut : register(t0); // CHW
+#else
 StructuredBuffer<float> gOut : register(t0); // CHW
+#endif
 RWTexture2D<float4> gDst : register(u0); // 
 
 cbuffer CB : register(b0)
 {
-    uint SrcW, SrcH, SrcC, Flags;
-    uint DstW, DstH, _r1, _r2;
+    uint SrcW, SrcH, SrcC, Flags; // Ÿ ߷̸ Ÿ ϳ ũ
+    uint DstW, DstH, TilesX, TilesY; // TilesX == 0̸ Ÿ 
     float Gain, Bias, _pad0, _pad1;
+    uint ImgW, ImgH, Slice, _pad2; // Ÿ ߷: (߷ ػ) ũ, Slice: ġ  ̹
 }
-float sampleCHW_bilinear(uint c, float2 uv)
+float LoadCHW(uint i)
+{
+#if TENSOR_FP16
+    uint w = gOut[i >> 1];
+    return f16tof32((i & 1) ? (w >> 16) : w);
+#else
+    return gOut[i];
+#endif
+}
+
+// base: ټ  , p: ȼ ǥ (ؼ ߽ = )
+float sampleCHW_bilinear(uint base, uint c, float2 p)
 {
-    float2 p = uv * float2(SrcW, SrcH) - 0.5;
     int2 p0 = int2(floor(p));
     float2 f = frac(p);
     int x0 = clamp(p0.x, 0, (int) SrcW - 1);
@@ -28,14 +48,93 @@ float sampleCHW_bilinear(uint c, float2 uv)
     uint i01 = y1 * SrcW + x0;
     uint i11 = y1 * SrcW + x1;
 
-    float v00 = gOut[i00 + c * plane];
-    float v10 = gOut[i10 + c * plane];
-    float v01 = gOut[i01 + c * plane];
-    float v11 = gOut[i11 + c * plane];
+    base += c * plane;
+    float v00 = LoadCHW(base + i00);
+    float v10 = LoadCHW(base + i10);
+    float v01 = LoadCHW(base + i01);
+    float v11 = LoadCHW(base + i11);
 
     return lerp(lerp(v00, v10, f.x), lerp(v01, v11, f.x), f.y);
 }
 
+float3 sampleRGB(uint base, float2 p)
+{
+    float r = (SrcC > 0) ? sampleCHW_bilinear(base, 0, p) : 0.0;
+    float g = (SrcC > 1) ? sampleCHW_bilinear(base, 1, p) : r;
+    float b = (SrcC > 2) ? sampleCHW_bilinear(base, 2, p) : r;
+    return float3(r, g, b);
+}
+
+// Ÿ i  (cs_preprocess  )
+uint TileOrigin(uint i, uint n, uint img, uint tile)
+{
+    return n > 1 ? (i * (img - tile)) / (n - 1) : 0;
+}
+
+// p   ִ Ÿ  (뷫,   ȣϴ ʿ Ȯ)
+void TileRange(float p, uint n, uint img, uint tile, out uint lo, out uint hi)
+{
+    lo = 0;
+    hi = 0;
+    if (n <= 1)
+        return;
+    float s = max((float) (img - tile) / (float) (n - 1), 1.0);
+    lo = (uint) clamp(floor((p + 0.5 - tile) / s), 0.0, (float) (n - 1));
+    hi = (uint) clamp(ceil((p + 1.5) / s), 0.0, (float) (n - 1));
+}
+
+//  ġ: ̿ Ÿϰ ġ ʸ ģ    0 پ (ٱ ڸ 1)
+// x: Ÿ  ȼ ǥ
+float Feather(uint i, uint n, uint img, uint tile, float x)
+{
+    uint o = TileOrigin(i, n, img, tile);
+    float w = 1.0;
+    if (i > 0)
+    {
+        float overlap = (float) (TileOrigin(i - 1, n, img, tile) + tile - o);
+        w = min(w, (x + 0.5) / overlap);
+    }
+    if (i + 1 < n)
+    {
+        float overlap = (float) (o + tile - TileOrigin(i + 1, n, img, tile));
+        w = min(w, ((float) tile - x - 0.5) / overlap);
+    }
+    return saturate(w);
+}
+
+// Ÿ ߷  ġ Ÿϳ   (Ÿ  е ڱ )
+float3 sampleTiled(float2 uv)
+{
+    float2 p = uv * float2(ImgW, ImgH) - 0.5;
+    uint tileElems = SrcC * SrcW * SrcH;
+
+    uint x0, x1, y0, y1;
+    TileRange(p.x, TilesX, ImgW, SrcW, x0, x1);
+    TileRange(p.y, TilesY, ImgH, SrcH, y0, y1);
+
+    float3 sum = 0.0;
+    float wsum = 0.0;
+    for (uint ty = y0; ty <= y1; ++ty)
+    {
+        float ly = p.y - (float) TileOrigin(ty, TilesY, ImgH, SrcH);
+        if (ly < -0.5 || ly >= (float) SrcH - 0.5)
+            continue;
+        float wy = Feather(ty, TilesY, ImgH, SrcH, ly);
+
+        for (uint tx = x0; tx <= x1; ++tx)
+        {
+            float lx = p.x - (float) TileOrigin(tx, TilesX, ImgW, SrcW);
+            if (lx < -0.5 || lx >= (float) SrcW - 0.5)
+                continue;
+            float w = wy * Feather(tx, TilesX, ImgW, SrcW, lx);
+
+            sum += w * sampleRGB((ty * TilesX + tx) * tileElems, float2(lx, ly));
+            wsum += w;
+        }
+    }
+    return wsum > 0.0 ? sum / wsum : 0.0;
+}
+
 [numthreads(8, 8, 1)]
 void main(uint3 dtid : SV_DispatchThreadID)
 {
@@ -43,11 +142,9 @@ void main(uint3 dtid : SV_DispatchThreadID)
         return;
     float2 uv = (dtid.xy + 0.5) / float2(DstW, DstH);
 
-    float r = (SrcC > 0) ? sampleCHW_bilinear(0, uv) : 0.0;
-    float g = (SrcC > 1) ? sampleCHW_bilinear(1, uv) : r;
-    float b = (SrcC > 2) ? sampleCHW_bilinear(2, uv) : r;
+    float3 src = (TilesX > 0) ? sampleTiled(uv) : sampleRGB(Slice * SrcC * SrcW * SrcH, uv * float2(SrcW, SrcH) - 0.5);
 
-    float3 rgb = float3(r, g, b);
+    float3 rgb = src;
     if (Flags & 0x1)
     {
         rgb = rgb.bgr;
@@ -55,7 +152,7 @@ void main(uint3 dtid : SV_DispatchThreadID)
     
     if (Flags & 0x10)
     {
-        rgb = float3(r, g, b) / 255.0;
+        rgb = src / 255.0;
     }
     
     gDst[dtid.xy] = float4(saturate(rgb), 1);
@@ -17,15 +17,26 @@ static const float3 CAFFE_MEAN_BGR = float3(103.939, 116.779, 123.68); // 0..255
 
 cbuffer CB : register(b0)
 {
-    uint W, H, C, Flags;
-    uint _pad0, _pad1, _pad2, _pad3;
+    uint W, H, C, Flags; // ټ ũ (Ÿ ߷̸ Ÿ ϳ)
+    uint ImgW, ImgH, TilesX, TilesY; // Ÿ ߷:  ũ Ÿ  (TilesX == 0̸ Ÿ )
+    uint Slice, _pad0, _pad1, _pad2; // ġ [N,C,H,W]  н  ̹ (Ÿ ߷̸ 0)
 };
 
 Texture2D<float4> Src : register(t0);
 Texture2D<float4> PreSrc : register(t1);
 
 SamplerState Smp : register(s0);
+
+// TENSOR_FP16: fp16  Է. half 2 uint ϳ (¦ x =  16Ʈ), W ¦
+#ifndef TENSOR_FP16
+#define TENSOR_FP16 0
+#endif
+
+#if TENSOR_FP16
+RWStructuredBuffer<uint> Out : register(u0);
+#else
 RWStructuredBuffer<float> Out : register(u0);
+#endif
 
 float3 LinearToSRGB(float3 x)
 {
@@ -43,31 +54,16 @@ float3 SRGBToLinear(float3 c)
 }
 
 
-[numthreads(8, 8, 1)]
-void main(uint3 id : SV_DispatchThreadID)
+float3 Normalize(float3 rgb)
 {
-    if (id.x >= W || id.y >= H)
-        return;
-
-    float2 uv = (float2(id.x + 0.5, id.y + 0.5) / float2(W, H));
-    float3 rgb = Src.SampleLevel(Smp, uv, 0).rgb;
-    float3 preRgb;
-    if (C >= 6)
-        preRgb = PreSrc.SampleLevel(Smp, uv, 0).rgb;
-    
-    //float3 it = Src.Load(int3(id.xy, 0)).rgb;
-    //float3 pt = PreSrc.Load(int3(id.xy, 0)).rgb;
-    
     if (Flags & PRE_BGR_SWAP)
     {
         rgb = rgb.bgr;
-        preRgb = preRgb.bgr;
     }
     
     if (Flags & LINEAR_TO_SRGB)
     {
         rgb = LinearToSRGB(rgb);
-        preRgb = LinearToSRGB(preRgb);
     }
 
     
@@ -75,29 +71,102 @@ void main(uint3 id : SV_DispatchThreadID)
     if (Flags & PRE_CAFFE_BGR_MEAN)
     {
         rgb = rgb * 255.0 - CAFFE_MEAN_BGR;
-        preRgb = preRgb * 255.0 - CAFFE_MEAN_BGR;
     }
     else if (Flags & PRE_IMAGENET_MEANSTD)
     {
         // ImageNet: (x-mean)/std (Է 0..1)
         rgb = (rgb - IMAGENET_MEAN) / IMAGENET_STD;
-        preRgb = (preRgb - IMAGENET_MEAN) / IMAGENET_STD;
     }
     else if (Flags & PRE_TANH_INPUT)
     {
         // [-1,1] Է
         rgb = rgb * 2.0 - 1.0;
-        preRgb = preRgb * 2.0 - 1.0;
     }
 
     if (Flags & PRE_MUL_255)
     {
         rgb *= 255.0;
-        preRgb *= 255.0;
     }
+    return rgb;
+}
+
+// Ÿ i  (OnnxTileGrid  ): ù/ Ÿ ڸ ٰ ̴ 
+uint TileOrigin(uint i, uint n, uint img, uint tile)
+{
+    return n > 1 ? (i * (img - tile)) / (n - 1) : 0;
+}
+
+// ټ ǥ ->  uv. Ÿ̸ id.z = Ÿ ȣ ( 켱)
+float2 PixelUV(uint x, uint y, uint tile)
+{
+    if (TilesX == 0)
+        return float2(x + 0.5, y + 0.5) / float2(W, H);
+
+    uint ox = TileOrigin(tile % TilesX, TilesX, ImgW, W);
+    uint oy = TileOrigin(tile / TilesX, TilesY, ImgH, H);
+    return float2(ox + x + 0.5, oy + y + 0.5) / float2(ImgW, ImgH);
+}
+
+// ȼ ϳ CHW ä : 0..2 =  , 3..5 =  (C >= 6)
+void SamplePixel(uint x, uint y, uint tile, out float3 rgb, out float3 pt)
+{
+    float2 uv = PixelUV(x, y, tile);
+    rgb = Normalize(Src.SampleLevel(Smp, uv, 0).rgb);
+    pt = 0.0.xxx;
+    if (C >= 6 && (Flags & PRE_PT_VALID))
+        pt = Normalize(PreSrc.SampleLevel(Smp, uv, 0).rgb);
+    
+    //float3 it = Src.Load(int3(id.xy, 0)).rgb;
+    //float3 pt = PreSrc.Load(int3(id.xy, 0)).rgb;
+}
+
+#if TENSOR_FP16
+
+uint PackHalf2(float a, float b)
+{
+    return f32tof16(a) | (f32tof16(b) << 16);
+}
+
+//  ϳ =  2ȼ (ġ X W/2 )
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    uint x = id.x * 2;
+    if (x >= W || id.y >= H)
+        return;
+
+    float3 rgb0, pt0, rgb1, pt1;
+    SamplePixel(x, id.y, id.z, rgb0, pt0);
+    SamplePixel(x + 1, id.y, id.z, rgb1, pt1);
+
+    uint plane = W * H / 2;
+    uint idx = (id.y * W + x) / 2 + (Slice + id.z) * C * plane;
+
+    // CHW layout
+    Out[idx + 0 * plane] = PackHalf2(rgb0.r, rgb1.r);
+    Out[idx + 1 * plane] = PackHalf2(rgb0.g, rgb1.g);
+    Out[idx + 2 * plane] = PackHalf2(rgb0.b, rgb1.b);
+    if (C >= 6)
+    {
+        Out[idx + 3 * plane] = PackHalf2(pt0.r, pt1.r);
+        Out[idx + 4 * plane] = PackHalf2(pt0.g, pt1.g);
+        Out[idx + 5 * plane] = PackHalf2(pt0.b, pt1.b);
+    }
+}
+
+#else
+
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= W || id.y >= H)
+        return;
+
+    float3 rgb, pt;
+    SamplePixel(id.x, id.y, id.z, rgb, pt);
     
-    uint idx = id.y * W + id.x;
     uint plane = W * H;
+    uint idx = id.y * W + id.x + (Slice + id.z) * C * plane;
 
     // CHW layout
     Out[idx + 0 * plane] = rgb.r;
@@ -105,10 +174,10 @@ void main(uint3 id : SV_DispatchThreadID)
     Out[idx + 2 * plane] = rgb.b;
     if (C >= 6)
     {
-        float3 p = (Flags & PRE_PT_VALID) ? preRgb : 0.0.xxx;
-        Out[idx + 3 * plane] = p.r;
-        Out[idx + 4 * plane] = p.g;
-        Out[idx + 5 * plane] = p.b;
+        Out[idx + 3 * plane] = pt.r;
+        Out[idx + 4 * plane] = pt.g;
+        Out[idx + 5 * plane] = pt.b;
     }
 }
 
+#endif
@@ -0,0 +1,96 @@
+// cs_reproject.hlsl
+// ߷ ǳʶ : ̹  ̷  ġ   Ű ȭ鿡 ϰ
+//  ġ Ű   OnnxTex .
+// Ű ̿  ʴ ( ִ , ȭ ) ֺ ̰    ä
+
+cbuffer CB : register(b0)
+{
+    float4x4 CurInvViewProj; // ̹  clip -> world ( : mul(v, M))
+    float4x4 KeyViewProj; //  Ű world -> clip ( : mul(v, M))
+    uint W, H;
+    float NearZ, FarZ;
+    float DepthTolerance, FillRadius, _pad0, _pad1; // DepthTolerance:  ǥ    
+};
+
+Texture2D<float4> gHistColor : register(t0); // Ű OnnxTex
+Texture2D<float> gHistDepth : register(t1); // Ű 
+Texture2D<float> gDepth : register(t2); // ̹  
+
+SamplerState Smp : register(s0);
+
+RWTexture2D<float4> gDst : register(u0); // OnnxTex
+
+// ġ (0..1,  LH) -> þ  
+float LinearDepth(float z)
+{
+    return NearZ * FarZ / (FarZ - z * (FarZ - NearZ));
+}
+
+float DepthError(int2 p, float expect)
+{
+    return abs(LinearDepth(gHistDepth[p]) - expect) / expect;
+}
+
+static const float2 kRing[8] =
+{
+    float2(1, 0), float2(-1, 0), float2(0, 1), float2(0, -1),
+    float2(0.7071, 0.7071), float2(-0.7071, 0.7071), float2(0.7071, -0.7071), float2(-0.7071, -0.7071)
+};
+
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= W || id.y >= H)
+        return;
+
+    const float2 size = float2(W, H);
+    const int2 maxP = int2(W - 1, H - 1);
+
+    // 1) ̹  ȼ ->  -> Ű ȭ
+    float2 uv = (id.xy + 0.5) / size;
+    float4 ndc = float4(uv.x * 2.0 - 1.0, 1.0 - uv.y * 2.0, gDepth[id.xy], 1.0);
+    float4 world = mul(ndc, CurInvViewProj);
+    world /= world.w;
+
+    float4 clip = mul(world, KeyViewProj);
+    if (clip.w <= 1e-5)
+    {
+        // Ű ī޶ :  ڸ  (Ű  ª 干)
+        gDst[id.xy] = gHistColor[id.xy];
+        return;
+    }
+    float3 keyNdc = clip.xyz / clip.w;
+    float2 keyUV = float2(keyNdc.x * 0.5 + 0.5, 0.5 - keyNdc.y * 0.5);
+    float expect = LinearDepth(saturate(keyNdc.z));
+
+    // 2) Űӿ ̴ ǥ̸ ״ (bilinear)
+    int2 keyP = clamp(int2(keyUV * size), int2(0, 0), maxP);
+    bool inside = all(keyUV >= 0.0) && all(keyUV <= 1.0);
+    if (inside && DepthError(keyP, expect) <= DepthTolerance)
+    {
+        gDst[id.xy] = gHistColor.SampleLevel(Smp, keyUV, 0);
+        return;
+    }
+
+    // 3)  ִ :  巯    ȼ  Űӿ ̴ ̹Ƿ
+    //    ֺ   ̿   ؼ 
+    float bestErr = inside ? DepthError(keyP, expect) : 1e30;
+    float4 best = gHistColor[keyP];
+    [unroll]
+    for (int r = 1; r <= 3; ++r)
+    {
+        float radius = FillRadius * r / 3.0;
+        [unroll]
+        for (int i = 0; i < 8; ++i)
+        {
+            int2 p = clamp(int2(keyUV * size + kRing[i] * radius), int2(0, 0), maxP);
+            float err = DepthError(p, expect);
+            if (err < bestErr)
+            {
+                bestErr = err;
+                best = gHistColor[p];
+            }
+        }
+    }
+    gDst[id.xy] = best;
+}
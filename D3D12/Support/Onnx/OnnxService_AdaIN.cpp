@@ -7,6 +7,8 @@
 #include "Support/Image.h"
 #include "Support/Shader.h"
 
+#include <algorithm>
+
 
 static void WriteSceneSRVToSlot0(ID3D12Resource2* sceneColor, OnnxGPUResources* onnxGPUResource)
 {
@@ -19,6 +21,11 @@ static void WriteSceneSRVToSlot0(ID3D12Resource2* sceneColor, OnnxGPUResources*
 	dev->CreateShaderResourceView(sceneColor, &s, onnxGPUResource->m_SceneSRV_CPU);
 }
 
+// Ÿ ؽó  (ǻƮ Ʈ PSR ٷ    Ʈ    ְ  )
+static D3D12_RESOURCE_STATES sStyleTexState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+// Ÿ ̹ ̶ Է ۸   (CreateOnnxResources_AdaIN)   ó
+static bool sStyleInputReady = false;
+
 static void WriteStyleSRVToSlot6(ID3D12Resource* styleTex, DXGI_FORMAT fmt, OnnxGPUResources* onnxGPUResource)
 {
 	if (!styleTex) return;
@@ -64,17 +71,17 @@ void OnnxService_AdaIN::RecordPreprocess_AdaIN(
 		if (fmtC == DXGI_FORMAT_B8G8R8A8_UNORM || fmtC == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB)
 			flagsC |= PRE_BGR_SWAP; // BGR swap
 
+		// Ÿ ߷: ټ ũ = Ÿ, ġ Z = Ÿ 
+		const OnnxTileGrid& grid = DX_ONNX.GetTileGrid();
 		PreCBData cb
 		{ 
 			inWc, inHc, inCc, flagsC,
-			0, 0, 0, 0
+			grid.ImgW, grid.ImgH, grid.TilesX, grid.TilesY
 		};
 
-		uint8_t* base = nullptr;
-		onnxGPUResource->m_CB->Map(0, nullptr, (void**)&base);
-		memcpy(base + 0, &cb, sizeof(cb));
-		onnxGPUResource->m_CB->Unmap(0, nullptr);
-		cmd->SetComputeRootConstantBufferView(2, onnxGPUResource->m_CB->GetGPUVirtualAddress() + 0);
+		D3D12_GPU_VIRTUAL_ADDRESS cbVA = DX_CONTEXT.PushFrameConstants(&cb, sizeof(cb));
+		if (cbVA == 0) cbVA = onnxGPUResource->WriteConstants(0, &cb, sizeof(cb));
+		cmd->SetComputeRootConstantBufferView(2, cbVA);
 
 		// t0/u0
 		WriteSceneSRVToSlot0(sceneColor, onnxGPUResource);
@@ -92,13 +99,16 @@ void OnnxService_AdaIN::RecordPreprocess_AdaIN(
 
 		if (inWc && inHc) {
 			const UINT TG = 8;
-			cmd->Dispatch((inWc + TG - 1) / TG, (inHc + TG - 1) / TG, 1);
+			// fp16  ϳ  2ȼ
+			const UINT threadsX = DX_ONNX.IsTensorFp16() ? inWc / 2 : inWc;
+			cmd->Dispatch((threadsX + TG - 1) / TG, (inHc + TG - 1) / TG, std::max<UINT>(grid.Count(), 1));
 			auto uav = CD3DX12_RESOURCE_BARRIER::UAV(DX_ONNX.GetInputBufferContent().Get());
 			cmd->ResourceBarrier(1, &uav);
 		}
 	}
 
 	// ----- (B) STYLE -----
+	if (sStyleInputReady == false)
 	{
 		ID3D12Resource* styleTex = styleImage.GetTexture();
 		auto sDesc = styleTex->GetDesc();
@@ -124,14 +134,11 @@ void OnnxService_AdaIN::RecordPreprocess_AdaIN(
 			inWs, inHs, inCs, flags,
 			0, 0, 0, 0
 		};
-		uint8_t* base = nullptr;
-		onnxGPUResource->m_CB->Map(0, nullptr, (void**)&base);
-		memcpy(base + Slice, &cb, sizeof(cb));
-		onnxGPUResource->m_CB->Unmap(0, nullptr);
-		cmd->SetComputeRootConstantBufferView(2, onnxGPUResource->m_CB->GetGPUVirtualAddress() + Slice);
-
-		// StyleTex: PSR -> NPSR
-		static D3D12_RESOURCE_STATES sStyleTexState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+		D3D12_GPU_VIRTUAL_ADDRESS cbVA = DX_CONTEXT.PushFrameConstants(&cb, sizeof(cb));
+		if (cbVA == 0) cbVA = onnxGPUResource->WriteConstants(Slice, &cb, sizeof(cb));
+		cmd->SetComputeRootConstantBufferView(2, cbVA);
+
+		// StyleTex: PSR -> NPSR (ǻƮ Ʈ PrepareStyleForCompute_AdaIN ̹ )
 		if (sStyleTexState != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE) {
 			auto b = CD3DX12_RESOURCE_BARRIER::Transition(
 				styleTex, sStyleTexState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
@@ -156,12 +163,32 @@ void OnnxService_AdaIN::RecordPreprocess_AdaIN(
 
 		// Dispatch preprocess (now planar CHW)
 		const UINT TG = 8;
-		cmd->Dispatch((inWs + TG - 1) / TG, (inHs + TG - 1) / TG, 1);
+		// fp16  ϳ  2ȼ
+		const UINT threadsX = DX_ONNX.IsTensorFp16() ? inWs / 2 : inWs;
+		cmd->Dispatch((threadsX + TG - 1) / TG, (inHs + TG - 1) / TG, 1);
 		auto uav = CD3DX12_RESOURCE_BARRIER::UAV(DX_ONNX.GetInputBufferStyle().Get());
 		cmd->ResourceBarrier(1, &uav);
+
+		//  ׷ ʰ  Run Ÿ Ư¡ ٽ ڵ
+		sStyleInputReady = true;
+		DX_ONNX.InvalidateStyle();
 	}
 }
 
+void OnnxService_AdaIN::PrepareStyleForCompute_AdaIN(ID3D12GraphicsCommandList7* cmd, Image& styleImage)
+{
+	ID3D12Resource* styleTex = styleImage.GetTexture();
+	if (cmd == nullptr || styleTex == nullptr || sStyleTexState == D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+	{
+		return;
+	}
+
+	auto b = CD3DX12_RESOURCE_BARRIER::Transition(
+		styleTex, sStyleTexState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	cmd->ResourceBarrier(1, &b);
+	sStyleTexState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+}
+
 void OnnxService_AdaIN::RecordPostprocess_AdaIN(
 	ID3D12GraphicsCommandList7* cmd, 
 	ID3D12DescriptorHeap* heap, 
@@ -206,7 +233,7 @@ void OnnxService_AdaIN::RecordPostprocess_AdaIN(
 		s.Format = DXGI_FORMAT_UNKNOWN; // structured
 		s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 		s.Buffer.FirstElement = 0;
-		s.Buffer.NumElements = srcW * srcH * srcC;
+		s.Buffer.NumElements = (UINT)(DX_ONNX.GetOutputBuffer()->GetDesc().Width / sizeof(float)); // 4Ʈ  (fp16̸ half 2)
 		s.Buffer.StructureByteStride = sizeof(float);
 		s.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 
@@ -224,18 +251,20 @@ void OnnxService_AdaIN::RecordPostprocess_AdaIN(
 		Flags |= 0x1;
 	}
 
+	// Ÿ ߷̸ src = Ÿ ϳ, ̴ Ÿ ڷ ģ κ ´
+	const OnnxTileGrid& grid = DX_ONNX.GetTileGrid();
 	PostCBData cb
 	{
 		srcW, srcH, srcC, Flags,
-		dstW, dstH, 0, 0, 
-		1.0f, 0.0f, 0, 0 
+		dstW, dstH, grid.TilesX, grid.TilesY,
+		1.0f, 0.0f, 0, 0,
+		grid.ImgW, grid.ImgH, 0, 0
 	}; 
 
-	void* p = nullptr;
-	onnxGPUResource->m_CB->Map(0, nullptr, &p); 
-	std::memcpy(p, &cb, sizeof(cb)); 
-	onnxGPUResource->m_CB->Unmap(0, nullptr);
-	cmd->SetComputeRootConstantBufferView(2, onnxGPUResource->m_CB->GetGPUVirtualAddress());
+	// Ӻ ε   (ó CB  GPU д   )
+	D3D12_GPU_VIRTUAL_ADDRESS cbVA = DX_CONTEXT.PushFrameConstants(&cb, sizeof(cb));
+	if (cbVA == 0) cbVA = onnxGPUResource->WriteConstants(0, &cb, sizeof(cb));
+	cmd->SetComputeRootConstantBufferView(2, cbVA);
 	cmd->SetComputeRootDescriptorTable(0, onnxGPUResource->m_ModelOutSRV_GPU);
 	cmd->SetComputeRootDescriptorTable(1, onnxGPUResource->m_OnnxTexUAV_GPU);
 
@@ -250,6 +279,8 @@ void OnnxService_AdaIN::RecordPostprocess_AdaIN(
 		cmd->ResourceBarrier(1, &b);
 		sOutputState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 	}
+	// ǻƮ Ʈ PSR   : UAV ΰ ( Ʈ) 
+	if (cmd->GetType() != D3D12_COMMAND_LIST_TYPE_COMPUTE)
 	{
 		auto b = CD3DX12_RESOURCE_BARRIER::Transition(
 			onnxGPUResource->m_OnnxTex.Get(),
@@ -262,6 +293,7 @@ void OnnxService_AdaIN::RecordPostprocess_AdaIN(
 }
 
 void OnnxService_AdaIN::CreateOnnxResources_AdaIN(UINT W, UINT H,
+	UINT inferW, UINT inferH,
 	Image& styleImage,
 	OnnxPassResources* onnxResource,
 	OnnxGPUResources* onnxGPUResource,
@@ -276,7 +308,8 @@ void OnnxService_AdaIN::CreateOnnxResources_AdaIN(UINT W, UINT H,
 	UINT styleW = (UINT)sDesc.Width;
 	UINT styleH = sDesc.Height;
 
-	DX_ONNX.PrepareIO(DX_CONTEXT.GetDevice(), W, H, styleW, styleH);
+	DX_ONNX.PrepareIO(DX_CONTEXT.GetDevice(), inferW, inferH, styleW, styleH);
+	sStyleInputReady = false;
 
 	ID3D12Device* dev = DX_CONTEXT.GetDevice();
 
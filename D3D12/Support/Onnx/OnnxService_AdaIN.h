@@ -24,6 +24,12 @@ public:
 		Image& styleImage
 	);
 
+	// Async compute: moves the style texture PSR -> NPSR on a direct list (compute lists cannot)
+	static void PrepareStyleForCompute_AdaIN(
+		ID3D12GraphicsCommandList7* cmd,
+		Image& styleImage
+	);
+
 	static void RecordPostprocess_AdaIN(
 		ID3D12GraphicsCommandList7* cmd,
 		ID3D12DescriptorHeap* heap,
@@ -34,6 +40,7 @@ public:
 
 	static void CreateOnnxResources_AdaIN(
 		UINT W, UINT H,
+		UINT inferW, UINT inferH,	// model input size (<= W,H; the post-process resamples to W,H)
 		Image& styleImage,
 		OnnxPassResources* onnxResource,
 		OnnxGPUResources* onnxGPUResource,
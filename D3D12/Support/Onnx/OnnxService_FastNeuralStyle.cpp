@@ -7,8 +7,10 @@
 #include "Support/Image.h"
 #include "Support/Shader.h"
 
+#include <algorithm>
 
-static void WriteSceneSRVToSlot0(ID3D12Resource2* sceneColor, OnnxGPUResources* onnxGPUResource)
+
+static void WriteSceneSRV(ID3D12Resource2* sceneColor, OnnxGPUResources* onnxGPUResource, UINT slot)
 {
 	ID3D12Device* dev = DX_CONTEXT.GetDevice();
 	D3D12_SHADER_RESOURCE_VIEW_DESC s{};
@@ -16,7 +18,7 @@ static void WriteSceneSRVToSlot0(ID3D12Resource2* sceneColor, OnnxGPUResources*
 	s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	s.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
 	s.Texture2D.MipLevels = 1;
-	dev->CreateShaderResourceView(sceneColor, &s, onnxGPUResource->m_SceneSRV_CPU);
+	dev->CreateShaderResourceView(sceneColor, &s, onnxGPUResource->SlotCPU(onnxGPUResource->m_SceneSRV_CPU, slot));
 }
 
 
@@ -26,12 +28,19 @@ void OnnxService_FastNeuralStyle::RecordPreprocess_FastNeuralStyle(
 	OnnxPassResources* onnxResource,
 	OnnxGPUResources* onnxGPUResource,
 	ID3D12Resource2* sceneColor,
-	Image& styleImage
+	Image& styleImage,
+	UINT slot,
+	UINT slice
 )
 {
 	if (heap == nullptr || onnxResource == nullptr || sceneColor == nullptr || onnxGPUResource == nullptr)
 		return;
 
+	//   Է  (  ߷ ť  д   )
+	ComPointer<ID3D12Resource> inputContent = DX_ONNX.GetInputBufferContent(slot);
+	if (!inputContent)
+		return;
+
 	ID3D12DescriptorHeap* heaps[] = { heap };
 	cmd->SetDescriptorHeaps(1, heaps);
 	cmd->SetComputeRootSignature(onnxResource->m_PreRS.Get());
@@ -57,25 +66,26 @@ void OnnxService_FastNeuralStyle::RecordPreprocess_FastNeuralStyle(
 			flagsC |= LINEAR_TO_SRGB;
 		}
 		
+		// Ÿ ߷: ټ ũ = Ÿ, ġ Z = Ÿ . ġ slice ° ̹ 
+		const OnnxTileGrid& grid = DX_ONNX.GetTileGrid();
 		PreCBData cb
 		{ 
 			inWc, inHc, inCc, flagsC,
-			0, 0, 0, 0
+			grid.ImgW, grid.ImgH, grid.TilesX, grid.TilesY,
+			slice, 0, 0, 0
 		};
-		uint8_t* base = nullptr;
-		onnxGPUResource->m_CB->Map(0, nullptr, (void**)&base);
-		std::memcpy(base + 0, &cb, sizeof(cb)); //  0 
-		onnxGPUResource->m_CB->Unmap(0, nullptr);
-		cmd->SetComputeRootConstantBufferView(2, onnxGPUResource->m_CB->GetGPUVirtualAddress() + 0);
+		D3D12_GPU_VIRTUAL_ADDRESS cbVA = DX_CONTEXT.PushFrameConstants(&cb, sizeof(cb));
+		if (cbVA == 0) cbVA = onnxGPUResource->WriteConstants(0, &cb, sizeof(cb)); //  0 
+		cmd->SetComputeRootConstantBufferView(2, cbVA);
 
-		WriteSceneSRVToSlot0(sceneColor, onnxGPUResource);
-		cmd->SetComputeRootDescriptorTable(0, onnxGPUResource->m_SceneSRV_GPU);       // t0
-		cmd->SetComputeRootDescriptorTable(1, onnxGPUResource->m_InputContentUAV_GPU);// u0
+		WriteSceneSRV(sceneColor, onnxGPUResource, slot);
+		cmd->SetComputeRootDescriptorTable(0, onnxGPUResource->SlotGPU(onnxGPUResource->m_SceneSRV_GPU, slot));       // t0
+		cmd->SetComputeRootDescriptorTable(1, onnxGPUResource->SlotGPU(onnxGPUResource->m_InputContentUAV_GPU, slot));// u0
 
 		static D3D12_RESOURCE_STATES sInContentState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 		if (sInContentState != D3D12_RESOURCE_STATE_UNORDERED_ACCESS) {
 			auto t = CD3DX12_RESOURCE_BARRIER::Transition(
-				DX_ONNX.GetInputBufferContent().Get(),
+				inputContent.Get(),
 				sInContentState, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 			cmd->ResourceBarrier(1, &t);
 			sInContentState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
@@ -84,8 +94,10 @@ void OnnxService_FastNeuralStyle::RecordPreprocess_FastNeuralStyle(
 		// ġ
 		if (inWc && inHc) {
 			const UINT TG = 8;
-			cmd->Dispatch((inWc + TG - 1) / TG, (inHc + TG - 1) / TG, 1);
-			auto uav = CD3DX12_RESOURCE_BARRIER::UAV(DX_ONNX.GetInputBufferContent().Get());
+			// fp16  ϳ  2ȼ
+			const UINT threadsX = DX_ONNX.IsTensorFp16() ? inWc / 2 : inWc;
+			cmd->Dispatch((threadsX + TG - 1) / TG, (inHc + TG - 1) / TG, std::max<UINT>(grid.Count(), 1));
+			auto uav = CD3DX12_RESOURCE_BARRIER::UAV(inputContent.Get());
 			cmd->ResourceBarrier(1, &uav);
 		}
 	}
@@ -96,9 +108,16 @@ void OnnxService_FastNeuralStyle::RecordPostprocess_FastNeuralStyle(
 	ID3D12DescriptorHeap* heap, 
 	OnnxPassResources* onnxResource, 
 	OnnxGPUResources* onnxGPUResource,
-	D3D12_RESOURCE_STATES& mOnnxTexState
+	D3D12_RESOURCE_STATES& mOnnxTexState,
+	UINT slot,
+	UINT slice
 )
 {
+	//   ߷  (ù Run   )
+	ComPointer<ID3D12Resource> output = DX_ONNX.GetOutputBuffer(slot);
+	if (!output)
+		return;
+
 	ID3D12DescriptorHeap* heaps[] = { heap };
 	cmd->SetDescriptorHeaps(1, heaps);
 	cmd->SetComputeRootSignature(onnxResource->m_PreRS.Get());  //  RS 
@@ -115,7 +134,7 @@ void OnnxService_FastNeuralStyle::RecordPostprocess_FastNeuralStyle(
 	static D3D12_RESOURCE_STATES sOutputState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 	if (sOutputState != D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE) {
 		auto b = CD3DX12_RESOURCE_BARRIER::Transition(
-			DX_ONNX.GetOutputBuffer().Get(),
+			output.Get(),
 			sOutputState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 		cmd->ResourceBarrier(1, &b);
 		sOutputState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
@@ -135,12 +154,12 @@ void OnnxService_FastNeuralStyle::RecordPostprocess_FastNeuralStyle(
 		s.Format = DXGI_FORMAT_UNKNOWN; // structured
 		s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 		s.Buffer.FirstElement = 0;
-		s.Buffer.NumElements = srcW * srcH * srcC;
+		s.Buffer.NumElements = (UINT)(output->GetDesc().Width / sizeof(float)); // 4Ʈ  (fp16̸ half 2)
 		s.Buffer.StructureByteStride = sizeof(float);
 		s.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 
 		DX_CONTEXT.GetDevice()->CreateShaderResourceView(
-			DX_ONNX.GetOutputBuffer().Get(), &s, onnxGPUResource->m_ModelOutSRV_CPU);
+			output.Get(), &s, onnxGPUResource->SlotCPU(onnxGPUResource->m_ModelOutSRV_CPU, slot));
 	}
 
 	// 4) CB Ʈ (SrcW/H/C, DstW/H, Gain/Bias)
@@ -152,16 +171,17 @@ void OnnxService_FastNeuralStyle::RecordPostprocess_FastNeuralStyle(
 		UINT DstW, DstH, _r1, _r2;
 		float Gain, Bias, _f0, _f1;
 	};*/
-	PostCBData cb{ srcW, srcH, srcC, 0, dstW, dstH, 0, 0, 1.0f, 0.0f, 0, 0 };
+	// Ÿ ߷̸ src = Ÿ ϳ, ̴ Ÿ ڷ ģ κ ´
+	const OnnxTileGrid& grid = DX_ONNX.GetTileGrid();
+	PostCBData cb{ srcW, srcH, srcC, 0, dstW, dstH, grid.TilesX, grid.TilesY, 1.0f, 0.0f, 0, 0, grid.ImgW, grid.ImgH, slice, 0 };
 
-	void* p = nullptr;
-	onnxGPUResource->m_CB->Map(0, nullptr, &p);
-	std::memcpy(p, &cb, sizeof(cb)); //  0 
-	onnxGPUResource->m_CB->Unmap(0, nullptr);
-	cmd->SetComputeRootConstantBufferView(2, onnxGPUResource->m_CB->GetGPUVirtualAddress());
+	// Ӻ ε   (ó CB  GPU д   )
+	D3D12_GPU_VIRTUAL_ADDRESS cbVA = DX_CONTEXT.PushFrameConstants(&cb, sizeof(cb));
+	if (cbVA == 0) cbVA = onnxGPUResource->WriteConstants(0, &cb, sizeof(cb)); //  0 
+	cmd->SetComputeRootConstantBufferView(2, cbVA);
 
 	// 5) ε: t0=ModelOut SRV, u0=OnnxTex UAV
-	cmd->SetComputeRootDescriptorTable(0, onnxGPUResource->m_ModelOutSRV_GPU);
+	cmd->SetComputeRootDescriptorTable(0, onnxGPUResource->SlotGPU(onnxGPUResource->m_ModelOutSRV_GPU, slot));
 	cmd->SetComputeRootDescriptorTable(1, onnxGPUResource->m_OnnxTexUAV_GPU);
 
 	// 6) ġ
@@ -171,12 +191,14 @@ void OnnxService_FastNeuralStyle::RecordPostprocess_FastNeuralStyle(
 	// 7)  
 	{
 		auto b = CD3DX12_RESOURCE_BARRIER::Transition(
-			DX_ONNX.GetOutputBuffer().Get(),
+			output.Get(),
 			D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
 			D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 		cmd->ResourceBarrier(1, &b);
 		sOutputState = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 	}
+	// ǻƮ Ʈ PSR   : UAV ΰ ( Ʈ) 
+	if (cmd->GetType() != D3D12_COMMAND_LIST_TYPE_COMPUTE)
 	{
 		auto b = CD3DX12_RESOURCE_BARRIER::Transition(
 			onnxGPUResource->m_OnnxTex.Get(),
@@ -189,19 +211,21 @@ void OnnxService_FastNeuralStyle::RecordPostprocess_FastNeuralStyle(
 }
 
 void OnnxService_FastNeuralStyle::CreateOnnxResources_FastNeuralStyle(UINT W, UINT H,
+	UINT inferW, UINT inferH,
 	Image& styleImage,
 	OnnxPassResources* onnxResource,
 	OnnxGPUResources* onnxGPUResource,
 	ID3D12DescriptorHeap* heapCPU,
-	ID3D12Resource2* sceneColor,
+	ID3D12Resource2* const* sceneColors,
+	UINT slotCount,
 	D3D12_RESOURCE_STATES& mOnnxTexState,
 	D3D12_RESOURCE_STATES& mOnnxInputState
 )
 {
 	ID3D12Device* dev = DX_CONTEXT.GetDevice();
 
-	// 1) ONNX IO غ:  (W,H)
-	DX_ONNX.PrepareIO(DX_CONTEXT.GetDevice(), W, H);
+	// 1) ONNX IO غ:  (߷ ػ, OnnxTex W,H)
+	DX_ONNX.PrepareIO(DX_CONTEXT.GetDevice(), inferW, inferH);
 
 	// 2) ǻƮ (/ó)
 	if (!DX_MANAGER.CreateOnnxComputePipeline()) return;
@@ -223,11 +247,12 @@ void OnnxService_FastNeuralStyle::CreateOnnxResources_FastNeuralStyle(UINT W, UI
 		mOnnxTexState = D3D12_RESOURCE_STATE_COMMON;
 	}
 
-	// 4) ũ  (ʿ Ը;   8 )
+	// 4) ũ  (ʿ Ը;   8 ) x  
+	const UINT kDescPerSlot = 8;
 	{
 		D3D12_DESCRIPTOR_HEAP_DESC d{};
 		d.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-		d.NumDescriptors = 8; // Scene SRV, InC UAV, OnnxTex UAV/SRV, ModelOut SRV, InputC SRV(debug) 
+		d.NumDescriptors = kDescPerSlot * slotCount; // Scene SRV, InC UAV, OnnxTex UAV/SRV, ModelOut SRV, InputC SRV(debug) 
 		d.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
 		dev->CreateDescriptorHeap(&d, IID_PPV_ARGS(&onnxGPUResource->m_Heap));
 
@@ -238,33 +263,71 @@ void OnnxService_FastNeuralStyle::CreateOnnxResources_FastNeuralStyle(UINT W, UI
 	const UINT inc = dev->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 	auto nthGPU = [&](UINT i) { auto h = gpuStart; h.ptr += i * inc; return h; };
 	auto nthCPU_GPU = [&](UINT i) { auto h = cpuGPU;  h.ptr += i * inc; return h; };
-
-	// (0) Scene SRV
+	onnxGPUResource->m_SlotStride = kDescPerSlot * inc;
+
+	onnxGPUResource->m_SceneSRV_CPU = nthCPU_GPU(0);
+	onnxGPUResource->m_SceneSRV_GPU = nthGPU(0);
+	onnxGPUResource->m_InputContentUAV_CPU = nthCPU_GPU(1);
+	onnxGPUResource->m_InputContentUAV_GPU = nthGPU(1);
+	onnxGPUResource->m_ModelOutSRV_CPU = nthCPU_GPU(4);
+	onnxGPUResource->m_ModelOutSRV_GPU = nthGPU(4);
+	onnxGPUResource->m_InputContentSRV_CPU = nthCPU_GPU(5);
+	onnxGPUResource->m_InputContentSRV_GPU = nthGPU(5);
+
+	// Ժ: (0) Scene SRV, (1) InputContent UAV, (4) ModelOut SRV, (5) InputContent SRV
+	for (UINT slot = 0; slot < slotCount; ++slot)
 	{
-		D3D12_SHADER_RESOURCE_VIEW_DESC s{};
-		s.Format = sceneColor->GetDesc().Format;
-		s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		s.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		s.Texture2D.MipLevels = 1;
-		onnxGPUResource->m_SceneSRV_CPU = nthCPU_GPU(0);
-		onnxGPUResource->m_SceneSRV_GPU = nthGPU(0);
-		dev->CreateShaderResourceView(sceneColor, &s, onnxGPUResource->m_SceneSRV_CPU);
-	}
+		ComPointer<ID3D12Resource> inputContent = DX_ONNX.GetInputBufferContent(slot);
+		ComPointer<ID3D12Resource> output = DX_ONNX.GetOutputBuffer(slot);
+		const auto inBytes = inputContent ? inputContent->GetDesc().Width : 0;
 
-	// (1) InputContent UAV (structured float)
-	{
-		D3D12_UNORDERED_ACCESS_VIEW_DESC u{};
-		u.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
-		u.Format = DXGI_FORMAT_UNKNOWN;
-		auto bytes = DX_ONNX.GetInputBufferContent()->GetDesc().Width;
-		u.Buffer.FirstElement = 0;
-		u.Buffer.NumElements = (UINT)(bytes / sizeof(float));
-		u.Buffer.StructureByteStride = sizeof(float);
-		u.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
-
-		onnxGPUResource->m_InputContentUAV_CPU = nthCPU_GPU(1);
-		onnxGPUResource->m_InputContentUAV_GPU = nthGPU(1);
-		dev->CreateUnorderedAccessView(DX_ONNX.GetInputBufferContent().Get(), nullptr, &u, onnxGPUResource->m_InputContentUAV_CPU);
+		// (0) Scene SRV
+		{
+			D3D12_SHADER_RESOURCE_VIEW_DESC s{};
+			s.Format = sceneColors[slot]->GetDesc().Format;
+			s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+			s.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+			s.Texture2D.MipLevels = 1;
+			dev->CreateShaderResourceView(sceneColors[slot], &s, onnxGPUResource->SlotCPU(onnxGPUResource->m_SceneSRV_CPU, slot));
+		}
+
+		// (1) InputContent UAV (structured float)
+		{
+			D3D12_UNORDERED_ACCESS_VIEW_DESC u{};
+			u.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+			u.Format = DXGI_FORMAT_UNKNOWN;
+			u.Buffer.FirstElement = 0;
+			u.Buffer.NumElements = (UINT)(inBytes / sizeof(float));
+			u.Buffer.StructureByteStride = sizeof(float);
+			u.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
+			dev->CreateUnorderedAccessView(inputContent.Get(), nullptr, &u, onnxGPUResource->SlotCPU(onnxGPUResource->m_InputContentUAV_CPU, slot));
+		}
+
+		// (4) ModelOut SRV 
+		{
+			D3D12_SHADER_RESOURCE_VIEW_DESC s{};
+			s.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+			s.Format = DXGI_FORMAT_UNKNOWN;
+			s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+			s.Buffer.FirstElement = 0;
+			s.Buffer.NumElements = 1; // ó 
+			s.Buffer.StructureByteStride = sizeof(float);
+			s.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
+			dev->CreateShaderResourceView(output.Get(), &s, onnxGPUResource->SlotCPU(onnxGPUResource->m_ModelOutSRV_CPU, slot));
+		}
+
+		// (5) InputContent SRV (debug)
+		{
+			D3D12_SHADER_RESOURCE_VIEW_DESC s{};
+			s.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+			s.Format = DXGI_FORMAT_UNKNOWN;
+			s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+			s.Buffer.FirstElement = 0;
+			s.Buffer.NumElements = (UINT)(inBytes / sizeof(float));
+			s.Buffer.StructureByteStride = sizeof(float);
+			s.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
+			dev->CreateShaderResourceView(inputContent.Get(), &s, onnxGPUResource->SlotCPU(onnxGPUResource->m_InputContentSRV_CPU, slot));
+		}
 	}
 
 	// (2) OnnxTex UAV
@@ -289,39 +352,6 @@ void OnnxService_FastNeuralStyle::CreateOnnxResources_FastNeuralStyle(UINT W, UI
 		dev->CreateShaderResourceView(onnxGPUResource->m_OnnxTex.Get(), &s, onnxGPUResource->m_OnnxTexSRV_CPU);
 	}
 
-	// (4) ModelOut SRV 
-	{
-		D3D12_SHADER_RESOURCE_VIEW_DESC s{};
-		s.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-		s.Format = DXGI_FORMAT_UNKNOWN;
-		s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		s.Buffer.FirstElement = 0;
-		s.Buffer.NumElements = 1; // ó 
-		s.Buffer.StructureByteStride = sizeof(float);
-		s.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-
-		onnxGPUResource->m_ModelOutSRV_CPU = nthCPU_GPU(4);
-		onnxGPUResource->m_ModelOutSRV_GPU = nthGPU(4);
-		dev->CreateShaderResourceView(DX_ONNX.GetOutputBuffer().Get(), &s, onnxGPUResource->m_ModelOutSRV_CPU);
-	}
-
-	// (5) InputContent SRV (debug)
-	{
-		D3D12_SHADER_RESOURCE_VIEW_DESC s{};
-		s.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-		s.Format = DXGI_FORMAT_UNKNOWN;
-		s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		s.Buffer.FirstElement = 0;
-		auto bytes = DX_ONNX.GetInputBufferContent()->GetDesc().Width;
-		s.Buffer.NumElements = (UINT)(bytes / sizeof(float));
-		s.Buffer.StructureByteStride = sizeof(float);
-		s.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-
-		onnxGPUResource->m_InputContentSRV_CPU = nthCPU_GPU(5);
-		onnxGPUResource->m_InputContentSRV_GPU = nthGPU(5);
-		dev->CreateShaderResourceView(DX_ONNX.GetInputBufferContent().Get(), &s, onnxGPUResource->m_InputContentSRV_CPU);
-	}
-
 	// 6) CB (/ó , 1̽ )
 	{
 		const UINT kCBAligned = ((sizeof(UINT) * 8 + 255) & ~255);
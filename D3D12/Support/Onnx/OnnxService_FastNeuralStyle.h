@@ -21,7 +21,9 @@ public:
 		OnnxPassResources* onnxResource,
 		OnnxGPUResources* onnxGPUResource,
 		ID3D12Resource2* sceneColor,
-		Image& styleImage
+		Image& styleImage,
+		UINT slot,
+		UINT slice	// image of the [N,C,H,W] batch to write (0 without batching)
 	);
 
 	static void RecordPostprocess_FastNeuralStyle(
@@ -29,16 +31,20 @@ public:
 		ID3D12DescriptorHeap* heap,
 		OnnxPassResources* onnxResource,
 		OnnxGPUResources* onnxGPUResource,
-		D3D12_RESOURCE_STATES& mOnnxTexState
+		D3D12_RESOURCE_STATES& mOnnxTexState,
+		UINT slot,
+		UINT slice	// image of the batch to read
 	);
 
 	static void CreateOnnxResources_FastNeuralStyle(
 		UINT W, UINT H,
+		UINT inferW, UINT inferH,	// model input size (<= W,H; the post-process resamples to W,H)
 		Image& styleImage,
 		OnnxPassResources* onnxResource,
 		OnnxGPUResources* onnxGPUResource,
 		ID3D12DescriptorHeap* heapCPU,
-		ID3D12Resource2* sceneColor,
+		ID3D12Resource2* const* sceneColors,	// one per pipeline slot
+		UINT slotCount,
 		D3D12_RESOURCE_STATES& mOnnxTexState,
 		D3D12_RESOURCE_STATES& mOnnxInputState
 	);
@@ -0,0 +1,249 @@
+#include "OnnxService_Temporal.h"
+#include "Util/OnnxDefine.h"
+
+#include "Support/Shader.h"
+#include "D3D/DXContext.h"
+
+//   ̾ƿ (̺ ): SRV t0..t2, UAV u0..u1
+//  丮 : SRV(0) OnnxTex, (1) , (2) null / UAV(6) HistoryTex, (7) HistoryDepth
+//  :       SRV(3) HistoryTex, (4) HistoryDepth, (5)  / UAV(8) OnnxTex, (9) null
+namespace
+{
+	constexpr UINT kHistorySRV = 0;
+	constexpr UINT kReprojectSRV = 3;
+	constexpr UINT kHistoryUAV = 6;
+	constexpr UINT kReprojectUAV = 8;
+	constexpr UINT kDescCount = 10;
+
+	D3D12_CPU_DESCRIPTOR_HANDLE NthCPU(ID3D12DescriptorHeap* heap, UINT i)
+	{
+		const UINT inc = DX_CONTEXT.GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		D3D12_CPU_DESCRIPTOR_HANDLE h = heap->GetCPUDescriptorHandleForHeapStart();
+		h.ptr += (SIZE_T)i * inc;
+		return h;
+	}
+
+	D3D12_GPU_DESCRIPTOR_HANDLE NthGPU(ID3D12DescriptorHeap* heap, UINT i)
+	{
+		const UINT inc = DX_CONTEXT.GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		D3D12_GPU_DESCRIPTOR_HANDLE h = heap->GetGPUDescriptorHandleForHeapStart();
+		h.ptr += (UINT64)i * inc;
+		return h;
+	}
+
+	void WriteTextureSRV(ID3D12Resource* res, DXGI_FORMAT format, D3D12_CPU_DESCRIPTOR_HANDLE dst)
+	{
+		D3D12_SHADER_RESOURCE_VIEW_DESC s{};
+		s.Format = format;
+		s.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		s.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+		s.Texture2D.MipLevels = 1;
+		DX_CONTEXT.GetDevice()->CreateShaderResourceView(res, &s, dst);
+	}
+
+	void WriteTextureUAV(ID3D12Resource* res, DXGI_FORMAT format, D3D12_CPU_DESCRIPTOR_HANDLE dst)
+	{
+		D3D12_UNORDERED_ACCESS_VIEW_DESC u{};
+		u.Format = format;
+		u.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+		DX_CONTEXT.GetDevice()->CreateUnorderedAccessView(res, nullptr, &u, dst);
+	}
+
+	bool CreateTemporalPipeline(OnnxPassResources* onnxResource)
+	{
+		ID3D12Device* device = DX_CONTEXT.GetDevice();
+
+		CD3DX12_DESCRIPTOR_RANGE1 rangeSRV(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 3, 0);
+		CD3DX12_DESCRIPTOR_RANGE1 rangeUAV(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 2, 0);
+
+		CD3DX12_ROOT_PARAMETER1 params[3];
+		params[0].InitAsDescriptorTable(1, &rangeSRV, D3D12_SHADER_VISIBILITY_ALL);
+		params[1].InitAsDescriptorTable(1, &rangeUAV, D3D12_SHADER_VISIBILITY_ALL);
+		params[2].InitAsConstantBufferView(0);
+
+		D3D12_STATIC_SAMPLER_DESC samp{};
+		samp.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+		samp.AddressU = samp.AddressV = samp.AddressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+		samp.ShaderRegister = 0; // s0
+
+		CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rsDesc;
+		rsDesc.Init_1_1(_countof(params), params, 1, &samp, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+		ComPointer<ID3DBlob> sigBlob, errBlob;
+		if (FAILED(D3D12SerializeVersionedRootSignature(&rsDesc, &sigBlob, &errBlob))) return false;
+		if (FAILED(device->CreateRootSignature(0, sigBlob->GetBufferPointer(), sigBlob->GetBufferSize(),
+			IID_PPV_ARGS(&onnxResource->m_TemporalRS)))) return false;
+
+		ComPointer<ID3DBlob> csHistory, csReproject;
+		HRESULT hr = D3DCompileFromFile(L"./Shaders/cs_history.hlsl", nullptr, nullptr, "main", "cs_5_0", 0, 0, &csHistory, &errBlob);
+		if (FAILED(hr) || !csHistory) return false;
+		hr = D3DCompileFromFile(L"./Shaders/cs_reproject.hlsl", nullptr, nullptr, "main", "cs_5_0", 0, 0, &csReproject, &errBlob);
+		if (FAILED(hr) || !csReproject) return false;
+
+		D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
+		desc.pRootSignature = onnxResource->m_TemporalRS.Get();
+		desc.CS = { csHistory->GetBufferPointer(), csHistory->GetBufferSize() };
+		if (FAILED(device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&onnxResource->m_HistoryPSO)))) return false;
+
+		desc.CS = { csReproject->GetBufferPointer(), csReproject->GetBufferSize() };
+		if (FAILED(device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&onnxResource->m_ReprojectPSO)))) return false;
+
+		return true;
+	}
+
+	// OnnxTex/̸ н ´ ·. ̴ н  DEPTH_WRITE ǵ
+	void Transition(ID3D12GraphicsCommandList7* cmd, ID3D12Resource* res, D3D12_RESOURCE_STATES& state, D3D12_RESOURCE_STATES to)
+	{
+		if (state == to) return;
+		auto b = CD3DX12_RESOURCE_BARRIER::Transition(res, state, to);
+		cmd->ResourceBarrier(1, &b);
+		state = to;
+	}
+
+	// 丮 /̴ ׻  
+	void TransitionHistory(ID3D12GraphicsCommandList7* cmd, OnnxGPUResources* onnxGPUResource, D3D12_RESOURCE_STATES to)
+	{
+		const D3D12_RESOURCE_STATES from = onnxGPUResource->m_HistoryState;
+		if (from == to) return;
+		D3D12_RESOURCE_BARRIER b[2] =
+		{
+			CD3DX12_RESOURCE_BARRIER::Transition(onnxGPUResource->m_HistoryTex.Get(), from, to),
+			CD3DX12_RESOURCE_BARRIER::Transition(onnxGPUResource->m_HistoryDepth.Get(), from, to),
+		};
+		cmd->ResourceBarrier(2, b);
+		onnxGPUResource->m_HistoryState = to;
+	}
+
+	void Dispatch(
+		ID3D12GraphicsCommandList7* cmd,
+		OnnxPassResources* onnxResource,
+		OnnxGPUResources* onnxGPUResource,
+		ID3D12PipelineState* pso,
+		UINT srvTable, UINT uavTable,
+		const TemporalCBData& cb)
+	{
+		ID3D12DescriptorHeap* heap = onnxGPUResource->m_TemporalHeap.Get();
+		ID3D12DescriptorHeap* heaps[] = { heap };
+		cmd->SetDescriptorHeaps(1, heaps);
+		cmd->SetComputeRootSignature(onnxResource->m_TemporalRS.Get());
+		cmd->SetPipelineState(pso);
+
+		//  CB(m_CB) /ó ̶  ε  
+		D3D12_GPU_VIRTUAL_ADDRESS cbVA = DX_CONTEXT.PushFrameConstants(&cb, sizeof(cb));
+		if (cbVA == 0) cbVA = onnxGPUResource->WriteConstants(0, &cb, sizeof(cb));
+		cmd->SetComputeRootConstantBufferView(2, cbVA);
+		cmd->SetComputeRootDescriptorTable(0, NthGPU(heap, srvTable));
+		cmd->SetComputeRootDescriptorTable(1, NthGPU(heap, uavTable));
+
+		const UINT TG = 8;
+		cmd->Dispatch((cb.W + TG - 1) / TG, (cb.H + TG - 1) / TG, 1);
+	}
+}
+
+bool OnnxService_Temporal::CreateTemporalResources(
+	UINT W, UINT H,
+	ID3D12Resource* depth,
+	OnnxPassResources* onnxResource,
+	OnnxGPUResources* onnxGPUResource
+)
+{
+	if (depth == nullptr || onnxResource == nullptr || onnxGPUResource == nullptr || !onnxGPUResource->m_OnnxTex)
+		return false;
+
+	ID3D12Device* dev = DX_CONTEXT.GetDevice();
+
+	// 1) RS/PSO (ʰ ٲ OnnxPassResources Բ  )
+	if (!onnxResource->m_TemporalRS && !CreateTemporalPipeline(onnxResource))
+	{
+		OutputDebugStringA("[OnnxService_Temporal] pipeline creation failed\n");
+		return false;
+	}
+
+	// 2) 丮 ؽó (OnnxTex  ũ)
+	CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC colorDesc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8G8B8A8_UNORM, W, H, 1, 1);
+	colorDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+	CD3DX12_RESOURCE_DESC depthDesc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R32_FLOAT, W, H, 1, 1);
+	depthDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+	onnxGPUResource->m_HistoryTex.Release();
+	onnxGPUResource->m_HistoryDepth.Release();
+	if (FAILED(dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &colorDesc,
+		D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&onnxGPUResource->m_HistoryTex)))) return false;
+	if (FAILED(dev->CreateCommittedResource(&hp, D3D12_HEAP_FLAG_NONE, &depthDesc,
+		D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&onnxGPUResource->m_HistoryDepth)))) return false;
+	onnxGPUResource->m_HistoryState = D3D12_RESOURCE_STATE_COMMON;
+
+	// 3)  . ̴ ̴ ̶ GPU  ߿ ġ :
+	//     SRV(1, 5) ⼭   ,  ۰ ٽ   Լ ٽ Ҹ (GPU  )
+	if (!onnxGPUResource->m_TemporalHeap)
+	{
+		D3D12_DESCRIPTOR_HEAP_DESC d{};
+		d.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		d.NumDescriptors = kDescCount;
+		d.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		if (FAILED(dev->CreateDescriptorHeap(&d, IID_PPV_ARGS(&onnxGPUResource->m_TemporalHeap)))) return false;
+	}
+	ID3D12DescriptorHeap* heap = onnxGPUResource->m_TemporalHeap.Get();
+
+	WriteTextureSRV(onnxGPUResource->m_OnnxTex.Get(), DXGI_FORMAT_R8G8B8A8_UNORM, NthCPU(heap, kHistorySRV + 0));
+	WriteTextureSRV(depth, DXGI_FORMAT_R32_FLOAT, NthCPU(heap, kHistorySRV + 1));
+	WriteTextureSRV(nullptr, DXGI_FORMAT_R32_FLOAT, NthCPU(heap, kHistorySRV + 2));
+	WriteTextureSRV(onnxGPUResource->m_HistoryTex.Get(), DXGI_FORMAT_R8G8B8A8_UNORM, NthCPU(heap, kReprojectSRV + 0));
+	WriteTextureSRV(onnxGPUResource->m_HistoryDepth.Get(), DXGI_FORMAT_R32_FLOAT, NthCPU(heap, kReprojectSRV + 1));
+	WriteTextureSRV(depth, DXGI_FORMAT_R32_FLOAT, NthCPU(heap, kReprojectSRV + 2));
+	WriteTextureUAV(onnxGPUResource->m_HistoryTex.Get(), DXGI_FORMAT_R8G8B8A8_UNORM, NthCPU(heap, kHistoryUAV + 0));
+	WriteTextureUAV(onnxGPUResource->m_HistoryDepth.Get(), DXGI_FORMAT_R32_FLOAT, NthCPU(heap, kHistoryUAV + 1));
+	WriteTextureUAV(onnxGPUResource->m_OnnxTex.Get(), DXGI_FORMAT_R8G8B8A8_UNORM, NthCPU(heap, kReprojectUAV + 0));
+	WriteTextureUAV(nullptr, DXGI_FORMAT_R32_FLOAT, NthCPU(heap, kReprojectUAV + 1));
+
+	return true;
+}
+
+void OnnxService_Temporal::RecordHistory_Temporal(
+	ID3D12GraphicsCommandList7* cmd,
+	OnnxPassResources* onnxResource,
+	OnnxGPUResources* onnxGPUResource,
+	ID3D12Resource* depth,
+	D3D12_RESOURCE_STATES& mOnnxTexState,
+	const TemporalCBData& cb
+)
+{
+	if (cmd == nullptr || depth == nullptr || onnxResource == nullptr || onnxGPUResource == nullptr
+		|| !onnxResource->m_HistoryPSO || !onnxGPUResource->m_TemporalHeap)
+		return;
+
+	//  ״ PSR   ְ OnnxTex ̴ ҽ · 
+	D3D12_RESOURCE_STATES depthState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+	Transition(cmd, onnxGPUResource->m_OnnxTex.Get(), mOnnxTexState, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+	Transition(cmd, depth, depthState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	TransitionHistory(cmd, onnxGPUResource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	Dispatch(cmd, onnxResource, onnxGPUResource, onnxResource->m_HistoryPSO.Get(), kHistorySRV, kHistoryUAV, cb);
+
+	Transition(cmd, depth, depthState, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+}
+
+void OnnxService_Temporal::RecordReproject_Temporal(
+	ID3D12GraphicsCommandList7* cmd,
+	OnnxPassResources* onnxResource,
+	OnnxGPUResources* onnxGPUResource,
+	ID3D12Resource* depth,
+	D3D12_RESOURCE_STATES& mOnnxTexState,
+	const TemporalCBData& cb
+)
+{
+	if (cmd == nullptr || depth == nullptr || onnxResource == nullptr || onnxGPUResource == nullptr
+		|| !onnxResource->m_ReprojectPSO || !onnxGPUResource->m_TemporalHeap)
+		return;
+
+	D3D12_RESOURCE_STATES depthState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+	Transition(cmd, onnxGPUResource->m_OnnxTex.Get(), mOnnxTexState, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	Transition(cmd, depth, depthState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	TransitionHistory(cmd, onnxGPUResource, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+	Dispatch(cmd, onnxResource, onnxGPUResource, onnxResource->m_ReprojectPSO.Get(), kReprojectSRV, kReprojectUAV, cb);
+
+	Transition(cmd, depth, depthState, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+	Transition(cmd, onnxGPUResource->m_OnnxTex.Get(), mOnnxTexState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Windows.h>
+#include <memory>
+
+class OnnxPassResources;
+struct ID3D12GraphicsCommandList7;
+struct ID3D12Resource;
+struct OnnxGPUResources;
+struct TemporalCBData;
+enum D3D12_RESOURCE_STATES;
+
+// Temporal reuse of OnnxTex, independent of the runner: keyframes store OnnxTex and
+// the scene depth, the frames in between reproject that history into OnnxTex.
+// Runs on a direct list with its own root signature and descriptor heap.
+class OnnxService_Temporal
+{
+public:
+	// History textures (W,H), the pass pipelines and the pass heap; call after OnnxTex and
+	// depth exist, with the GPU idle. The depth SRVs are written here only, so call it again
+	// whenever the depth buffer is recreated
+	static bool CreateTemporalResources(
+		UINT W, UINT H,
+		ID3D12Resource* depth,
+		OnnxPassResources* onnxResource,
+		OnnxGPUResources* onnxGPUResource
+	);
+
+	// Keyframe: OnnxTex + depth -> history. depth stays in DEPTH_WRITE outside the pass
+	static void RecordHistory_Temporal(
+		ID3D12GraphicsCommandList7* cmd,
+		OnnxPassResources* onnxResource,
+		OnnxGPUResources* onnxGPUResource,
+		ID3D12Resource* depth,
+		D3D12_RESOURCE_STATES& mOnnxTexState,
+		const TemporalCBData& cb
+	);
+
+	// Skipped frame: history reprojected with this frame's depth -> OnnxTex (left in PSR for the blit)
+	static void RecordReproject_Temporal(
+		ID3D12GraphicsCommandList7* cmd,
+		OnnxPassResources* onnxResource,
+		OnnxGPUResources* onnxGPUResource,
+		ID3D12Resource* depth,
+		D3D12_RESOURCE_STATES& mOnnxTexState,
+		const TemporalCBData& cb
+	);
+};
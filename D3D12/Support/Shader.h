@@ -9,15 +9,28 @@
 
 struct PreCBData
 {
-	UINT W, H, C, Flags;
-	UINT _pad0, _pad1, _pad2, _pad3;
+	UINT W, H, C, Flags;			// tensor size (one tile when tiled)
+	UINT ImgW, ImgH, TilesX, TilesY;	// tiled inference: full image size and tile grid, TilesX == 0 otherwise
+	UINT Slice, _pad0, _pad1, _pad2;	// image of the batch this pass writes
 };
 
 struct PostCBData 
 {
 	UINT SrcW, SrcH, SrcC, Flags;
-	UINT DstW, DstH, _r1, _r2;
+	UINT DstW, DstH, TilesX, TilesY;
 	float Gain, Bias, _pad0, _pad1;
+	UINT ImgW, ImgH, Slice, _pad2;		// Slice: image of the batch this pass reads
+};
+
+struct TemporalCBData
+{
+	float CurInvViewProj[16];		// this frame, transposed for HLSL (column-major)
+	float KeyViewProj[16];			// last keyframe, transposed
+	UINT W, H;
+	float NearZ, FarZ;
+	float DepthTolerance;			// relative view depth error still taken as the same surface
+	float FillRadius;				// disocclusion search radius in pixels
+	float _pad0, _pad1;
 };
 
 
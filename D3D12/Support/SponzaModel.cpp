@@ -4,9 +4,15 @@
 #include "Manager/ImageManager.h"
 #include "Object/RenderingObject3D.h"
 #include "Support/tiny_obj_loader.h"
+#include "Support/Window.h"
+#include "Util/JobSystem.h"
 #include <cmath> 
 #include <unordered_map>
 #include <algorithm> 
+#include <chrono>
+
+extern const bool PARALLEL_RECORD;
+extern const int PARALLEL_RECORD_MIN_DRAWS;
 
 struct Vec3 { float x, y, z; };
 
@@ -289,6 +295,12 @@ bool SponzaModel::InitFromOBJ(const std::string& objPath, const std::string& bas
         };
 
     // 6) GPU ε + ޽ 
+    //     ޽ VB/IB 縦 ε  ġ ϳ (Ŀǵ Ʈ 1, 潺 1)
+    struct UploadBatchScope {
+        UploadBatchScope() { DX_CONTEXT.BeginUploadBatch(); }
+        ~UploadBatchScope() { DX_CONTEXT.EndUploadBatch(); }
+    } uploadBatch;
+
     m_Subs.clear(); m_Subs.reserve(subs.size());
     for (auto& C : subs) {
         SponzaSubmesh sm;
@@ -320,8 +332,6 @@ bool SponzaModel::InitFromOBJ(const std::string& objPath, const std::string& bas
         m_Subs.emplace_back(std::move(sm));
     }
 
-    ID3D12GraphicsCommandList7* cmd = DX_CONTEXT.InitCommandList();
-    DX_CONTEXT.ExecuteCommandList();
     return true;
 }
 
@@ -332,13 +342,75 @@ void SponzaModel::Render(ID3D12GraphicsCommandList7* cmd,
     D3D12_CPU_DESCRIPTOR_HANDLE& dsv,
     float angle)
 {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
     ID3D12DescriptorHeap* heaps[] = { m_Heap.Get() };
-    cmd->SetDescriptorHeaps(1, heaps);  
 
-    for (auto& sm : m_Subs) {
-        DX_MANAGER.SetObjSrvGPU(sm.tableBase);
-        sm.ro->Rendering(cmd, cam, aspect, rtv, dsv, angle);
+    // Ʈ /  忡     ο(Ŀ ) 
+    const DirectX::XMMATRIX lightVP = DX_MANAGER.GetLightViewProj();
+    const DirectX::XMFLOAT3 lightDir = DX_MANAGER.GetLightDirWS();
+
+    // ûũ : Ŀ+   , ûũ ּ PARALLEL_RECORD_MIN_DRAWS ο
+    const size_t subCount = m_Subs.size();
+    const size_t minDraws = (size_t)std::max<int>(PARALLEL_RECORD_MIN_DRAWS, 1);
+    size_t chunkCount = 1;
+    if (PARALLEL_RECORD && DX_JOB.IsRunning()) {
+        chunkCount = std::min<size_t>(DX_JOB.GetWorkerCount() + 1, subCount / minDraws);
+        chunkCount = std::max<size_t>(chunkCount, 1);
     }
+
+    m_RecordStats.chunks.assign(chunkCount, {});
+    m_RecordStats.parallel = chunkCount > 1;
+
+    if (chunkCount == 1) {
+        cmd->SetDescriptorHeaps(1, heaps);
+
+        for (auto& sm : m_Subs) {
+            sm.ro->Rendering(cmd, cam, aspect, rtv, dsv, angle, sm.tableBase, lightVP, lightDir);
+        }
+
+        m_RecordStats.chunks[0] = { JobSystem::GetThreadIndex(), (UINT)subCount,
+            std::chrono::duration<float, std::milli>(Clock::now() - start).count() };
+        m_RecordStats.totalMs = m_RecordStats.chunks[0].ms;
+        return;
+    }
+
+    //  Ʈ ¸  Ƿ Ʈ/ ο   ؼ ûũ 
+    const D3D12_VIEWPORT vp = DX_WINDOW.CreateViewport();
+    const RECT sc = DX_WINDOW.CreateScissorRect();
+
+    std::vector<DXContext::CommandContext*> ctxs(chunkCount, nullptr);
+    const size_t perChunk = (subCount + chunkCount - 1) / chunkCount;
+
+    DX_JOB.ParallelFor(0, chunkCount, 1, [&](size_t c) {
+        const Clock::time_point chunkStart = Clock::now();
+
+        const size_t b = c * perChunk;
+        const size_t e = std::min<size_t>(subCount, b + perChunk);
+        if (b >= e) return;
+
+        DXContext::CommandContext* ctx = DX_CONTEXT.AcquireCommandContext();
+        if (ctx == nullptr) return;
+        ID3D12GraphicsCommandList7* list = ctx->list.Get();
+
+        list->SetDescriptorHeaps(1, heaps);
+        list->RSSetViewports(1, &vp);
+        list->RSSetScissorRects(1, &sc);
+
+        for (size_t i = b; i < e; ++i) {
+            m_Subs[i].ro->Rendering(list, cam, aspect, rtv, dsv, angle, m_Subs[i].tableBase, lightVP, lightDir);
+        }
+
+        ctxs[c] = ctx;
+        m_RecordStats.chunks[c] = { JobSystem::GetThreadIndex(), (UINT)(e - b),
+            std::chrono::duration<float, std::milli>(Clock::now() - chunkStart).count() };
+    });
+
+    //   = ûũ  ( Ʈ -> ûũ 0..N-1 -> ̾   Ʈ)
+    cmd = DX_CONTEXT.ChainCommandLists(ctxs.data(), (UINT)ctxs.size());
+
+    m_RecordStats.totalMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
 }
 
 void SponzaModel::UploadGPUResource(ID3D12GraphicsCommandList7* cmdList)
@@ -15,6 +15,18 @@ struct SponzaSubmesh {
     std::shared_ptr<Image> keepAlive;       
 };
 
+//    (ûũ ϳ = Ŀǵ Ʈ ϳ)
+struct SponzaRecordStats {
+    struct Chunk {
+        unsigned thread = 0;   // JobSystem::GetThreadIndex (0 = )
+        UINT draws = 0;
+        float ms = 0.f;        // ش ûũ  ð
+    };
+    std::vector<Chunk> chunks;
+    float totalMs = 0.f;       //    б~շ
+    bool parallel = false;
+};
+
 struct ObjImportOptions {
     bool zUpToYUp = true;      
     bool toLeftHanded = true;  
@@ -30,12 +42,15 @@ public:
         ID3D12RootSignature* rs,
         const ObjImportOptions& opts = {});
 
-    void Render(ID3D12GraphicsCommandList7* cmd,
+    //    cmd ̾   Ʈ ٲ (DXContext::ChainCommandLists)
+    void Render(ID3D12GraphicsCommandList7*& cmd,
         const Camera& cam, float aspect,
         D3D12_CPU_DESCRIPTOR_HANDLE& rtv,
         D3D12_CPU_DESCRIPTOR_HANDLE& dsv,
         float angle = 0.f);
 
+    const SponzaRecordStats& GetRecordStats() const { return m_RecordStats; }
+
     void Reset(); // /޽ 
 
     void UploadGPUResource(ID3D12GraphicsCommandList7* cmdList);
@@ -44,4 +59,6 @@ private:
     std::vector<SponzaSubmesh> m_Subs;
     ComPointer<ID3D12DescriptorHeap> m_Heap;  
     UINT m_DescInc = 0;                
+
+    SponzaRecordStats m_RecordStats;
 };
\ No newline at end of file
@@ -10,6 +10,8 @@
 
 #pragma comment(lib, "User32.lib")
 
+extern const double RESIZE_DEBOUNCE_MS;
+
 #ifdef UNICODE
 #pragma message("UNICODE is defined")
 #else
@@ -143,7 +145,27 @@ void DXWindow::Update(float deltaTime)
 
 void DXWindow::UpdateResize()
 {
-	if (ShouldResize())
+	if (ShouldResize() == false)
+	{
+		return;
+	}
+
+	// ũⰡ ٲ  ü  ũ ۸ ÷ ǥϰ,
+	// Ⱑ ų RESIZE_DEBOUNCE_MS  ״    ٽ 
+	const double sinceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_resizeRequestTime).count();
+	if (m_inSizeMove || sinceMs < RESIZE_DEBOUNCE_MS)
+	{
+		return;
+	}
+
+	//  ũ ƿ ٽ   
+	RECT cr;
+	if (GetClientRect(m_window, &cr) && (UINT)(cr.right - cr.left) == m_width && (UINT)(cr.bottom - cr.top) == m_height)
+	{
+		m_shouldResize = false;
+		return;
+	}
+
 	{
 		DX_CONTEXT.Flush(DXWindow::GetFrameCount());
 
@@ -158,25 +180,16 @@ void DXWindow::UpdateChangeOnnx()
 {
 	if (ShouldChangeOnnx())
 	{
+		//   IO ۸     ʵ
 		DX_CONTEXT.Flush(DXWindow::GetFrameCount());
 
-		DX_MANAGER.Shutdown();
-		DX_IMAGE.Shutdown();
-		DX_ONNX.Shutdown();
-
-		if (DX_ONNX.Init(DX_ONNX.GetChangeOnnxType(), DX_CONTEXT.GetDevice(), DX_CONTEXT.GetCommandQueue()) == false)
+		// ʴ OnnxManager Ǯ   (ó  𵨸 ε): Ȱ  ü  /ó IO ٽ 
+		if (DX_ONNX.SwitchTo(DX_ONNX.GetChangeOnnxType()) == false)
 		{
 			m_shouldClose = true;
 			return;
 		}
-		DX_IMAGE.Init();
-		DX_MANAGER.Init();
-		{ auto* c = DX_CONTEXT.InitCommandList(); DX_MANAGER.UploadGPUResource(c); DX_CONTEXT.ExecuteCommandList(); }
-
-		Resize();
-		DX_MANAGER.Resize();
-
-		DX_CONTEXT.Flush(DXWindow::GetFrameCount());
+		DX_MANAGER.RebindOnnx();
 
 		m_shouldChangeOnnx = false;
 	}
@@ -239,9 +252,11 @@ void DXWindow::OnChangedReCoNetModel()
 
 
 
-void DXWindow::Present()
+void DXWindow::Present(UINT syncInterval)
 {
-	m_swapChain->Present(1, 0);
+	// vsync  ׾  (ü ALLOW_TEARING , â  )
+	const UINT flags = syncInterval == 0 ? DXGI_PRESENT_ALLOW_TEARING : 0;
+	m_swapChain->Present(syncInterval, flags);
 	m_currentBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
 }
 
@@ -531,13 +546,29 @@ LRESULT DXWindow::OnWindowMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPa
 
 		case WM_SIZE:
 		{
-			if (lParam && (HIWORD(lParam) != Get().m_width || LOWORD(lParam) != Get().m_height))
+			// LOWORD = , HIWORD =  (ּȭ 0)
+			if (lParam && (LOWORD(lParam) != Get().m_width || HIWORD(lParam) != Get().m_height))
 			{
 				DX_WINDOW.m_shouldResize = true;
+				DX_WINDOW.m_resizeRequestTime = std::chrono::steady_clock::now();
 			}
 			break;
 		}
 
+		case WM_ENTERSIZEMOVE:
+		{
+			DX_WINDOW.m_inSizeMove = true;
+			break;
+		}
+
+		case WM_EXITSIZEMOVE:
+		{
+			// Ⱑ  ٿ ٸ 
+			DX_WINDOW.m_inSizeMove = false;
+			DX_WINDOW.m_resizeRequestTime = {};
+			break;
+		}
+
 		case WM_CLOSE:
 		{
 			DX_WINDOW.m_shouldClose = true;
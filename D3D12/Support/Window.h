@@ -4,6 +4,7 @@
 #include "Support/ComPointer.h"
 #include "D3D/DXContext.h"
 
+#include <chrono>
 #include <map>
 #include <vector>
 
@@ -18,7 +19,7 @@ class DXWindow
 public:
 	bool Init();
 	void Update(float deltaTime);
-	void Present();
+	void Present(UINT syncInterval = 1);
 	void Shutdown();
 	void Resize();
 	void SetFullScreen(bool enabled);
@@ -89,6 +90,8 @@ private:
 	bool m_shouldClose = false;
 
 	bool m_shouldResize = false;
+	bool m_inSizeMove = false;											// 테두리를 끄는 중 (WM_ENTERSIZEMOVE ~ WM_EXITSIZEMOVE)
+	std::chrono::steady_clock::time_point m_resizeRequestTime{};		// 마지막 WM_SIZE
 	bool m_shouldChangeOnnx = false;
 	UINT m_width = WINDOW_X;
 	UINT m_height = WINDOW_Y;
@@ -0,0 +1,235 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+	constexpr FrameStage kBusyStages[] = { FrameStage::Render, FrameStage::Preprocess, FrameStage::Inference, FrameStage::Postprocess };
+	constexpr double kSpinMs = 2.0;
+}
+
+void FramePacer::Reset(const Config& config)
+{
+	m_Config = config;
+	m_Config.minQueuedFrames = std::max<uint32_t>(m_Config.minQueuedFrames, 1);
+	m_Config.maxQueuedFrames = std::max<uint32_t>(m_Config.maxQueuedFrames, m_Config.minQueuedFrames);
+	m_Config.targetFrameMs = std::max<double>(m_Config.targetFrameMs, 0.0);
+	m_Config.averageWeight = std::clamp<double>(m_Config.averageWeight, 0.001, 1.0);
+
+	for (StageStats& stats : m_Stages)
+	{
+		stats = StageStats{};
+	}
+	for (double& pending : m_Pending)
+	{
+		pending = 0.0;
+	}
+	m_Frame = StageStats{};
+	m_GpuMs = 0.0;
+	m_FrameStartMs = 0.0;
+	m_NextStartMs = 0.0;
+	m_FrameNumber = 0;
+
+	// Start deep: first frames hitch (PSO/ORT warm-up) and nothing is measured yet
+	m_QueuedFrames = m_Config.maxQueuedFrames;
+	m_WantedFrames = m_QueuedFrames;
+	m_WantedStreak = 0;
+	m_DepthSwitches = 0;
+}
+
+double FramePacer::BeginFrame(double nowMs)
+{
+	double deltaMs = 0.0;
+	if (m_FrameNumber > 0)
+	{
+		deltaMs = std::max<double>(nowMs - m_FrameStartMs, 0.0);
+		Accumulate(m_Frame, deltaMs);
+	}
+
+	m_FrameStartMs = nowMs;
+	for (double& pending : m_Pending)
+	{
+		pending = 0.0;
+	}
+	return deltaMs / 1000.0;
+}
+
+void FramePacer::AddStage(FrameStage stage, double ms)
+{
+	if (stage >= FrameStage::Count || ms < 0.0)
+	{
+		return;
+	}
+	m_Pending[(size_t)stage] += ms;
+}
+
+void FramePacer::EndFrame(double nowMs)
+{
+	for (size_t i = 0; i < (size_t)FrameStage::Count; ++i)
+	{
+		Accumulate(m_Stages[i], m_Pending[i]);
+	}
+	++m_FrameNumber;
+
+	UpdateQueueDepth();
+	UpdateNextStart(nowMs);
+}
+
+void FramePacer::Accumulate(StageStats& stats, double ms) const
+{
+	stats.lastMs = ms;
+	if (stats.samples++ == 0)
+	{
+		stats.avgMs = ms;
+		return;
+	}
+
+	const double w = m_Config.averageWeight;
+	stats.devMs += (std::fabs(ms - stats.avgMs) - stats.devMs) * w;
+	stats.avgMs += (ms - stats.avgMs) * w;
+}
+
+double FramePacer::GetBusyMs() const
+{
+	double busy = 0.0;
+	for (FrameStage stage : kBusyStages)
+	{
+		busy += m_Stages[(size_t)stage].avgMs;
+	}
+	return busy;
+}
+
+double FramePacer::GetJitterMs() const
+{
+	double jitter = 0.0;
+	for (FrameStage stage : kBusyStages)
+	{
+		jitter += m_Stages[(size_t)stage].devMs;
+	}
+	return jitter;
+}
+
+uint32_t FramePacer::GetNeededQueuedFrames() const
+{
+	// No cadence: throughput first, keep the GPU fed as far as allowed
+	if (m_Config.targetFrameMs <= 0.0)
+	{
+		return m_Config.maxQueuedFrames;
+	}
+
+	const double budget = m_Config.targetFrameMs * m_Config.headroom;
+	const double busy = GetBusyMs();
+	const double jitter = 2.0 * GetJitterMs();
+
+	// 1 queued frame: CPU and GPU take turns, lowest latency, both must fit one frame
+	// 2: CPU records frame N while the GPU runs N-1, each side must fit on its own
+	// 3+: only buys room for spikes
+	uint32_t needed = 3;
+	if (busy + m_GpuMs + jitter <= budget)
+	{
+		needed = 1;
+	}
+	else if (std::max<double>(busy, m_GpuMs) + jitter <= budget)
+	{
+		needed = 2;
+	}
+	return std::clamp<uint32_t>(needed, m_Config.minQueuedFrames, m_Config.maxQueuedFrames);
+}
+
+void FramePacer::UpdateQueueDepth()
+{
+	// Two frames of history before the averages mean anything
+	if (m_FrameNumber < 2)
+	{
+		return;
+	}
+
+	const uint32_t needed = GetNeededQueuedFrames();
+	if (needed > m_QueuedFrames)
+	{
+		// Missing the cadence costs more than a frame of latency: deepen right away
+		m_QueuedFrames = needed;
+		m_WantedFrames = needed;
+		m_WantedStreak = 0;
+		++m_DepthSwitches;
+		return;
+	}
+
+	if (needed == m_QueuedFrames)
+	{
+		m_WantedStreak = 0;
+		return;
+	}
+
+	// Shallower only once the timings have asked for it for a while
+	if (needed != m_WantedFrames)
+	{
+		m_WantedFrames = needed;
+		m_WantedStreak = 0;
+	}
+	if (++m_WantedStreak >= m_Config.switchFrames)
+	{
+		m_QueuedFrames = m_WantedFrames;
+		m_WantedStreak = 0;
+		++m_DepthSwitches;
+	}
+}
+
+void FramePacer::UpdateNextStart(double nowMs)
+{
+	const double target = m_Config.targetFrameMs;
+	if (target <= 0.0)
+	{
+		m_NextStartMs = nowMs;
+		return;
+	}
+
+	// Fixed cadence from the previous start; with vsync, Present is the one that lines up with vblank
+	m_NextStartMs = m_FrameStartMs + target;
+	if (m_Config.vsync)
+	{
+		m_NextStartMs -= std::min<double>(m_Config.startMarginMs, target);
+	}
+
+	// More than a frame late (hitch): restart the cadence instead of rushing to catch up
+	if (m_NextStartMs < nowMs - target)
+	{
+		m_NextStartMs = nowMs;
+	}
+}
+
+const char* FramePacer::GetStageName(FrameStage stage)
+{
+	switch (stage)
+	{
+	case FrameStage::Wait:			return "Wait";
+	case FrameStage::Render:		return "Render";
+	case FrameStage::Preprocess:	return "Preprocess";
+	case FrameStage::Inference:		return "Inference";
+	case FrameStage::Postprocess:	return "Postprocess";
+	case FrameStage::Present:		return "Present";
+	default:						return "?";
+	}
+}
+
+double FramePacer::NowMs()
+{
+	using namespace std::chrono;
+	return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+void FramePacer::SleepUntil(double targetMs)
+{
+	double remaining = targetMs - NowMs();
+	if (remaining > kSpinMs)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(remaining - kSpinMs));
+	}
+	while (NowMs() < targetMs)
+	{
+		std::this_thread::yield();
+	}
+}
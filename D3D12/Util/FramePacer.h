@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//===================================================================//
+// Frame pacing / latency policy (portable, std only)
+//  BeginFrame -> AddStage ... -> EndFrame -> [SleepUntil(GetNextStartMs())] -> BeginFrame
+// The policy never reads a clock itself: every call takes times in ms on one
+// monotonic clock (NowMs() in the app), so it can be driven by simulated timings.
+//
+// Each frame it decides
+//  - how many frames the CPU may queue ahead of the GPU (GetQueuedFrames)
+//  - when the next frame should start (GetNextStartMs), on a target cadence
+//===================================================================//
+enum class FrameStage : uint8_t
+{
+	Wait,			// blocked on the frame slot / queued-frame limit
+	Render,
+	Preprocess,
+	Inference,		// OnnxManager::Run (CPU side: DML recording + submission)
+	Postprocess,
+	Present,
+	Count
+};
+
+class FramePacer
+{
+public:
+	struct Config
+	{
+		double targetFrameMs = 1000.0 / 60.0;	// 0: no cadence, start frames as soon as possible
+		uint32_t minQueuedFrames = 1;
+		uint32_t maxQueuedFrames = 2;			// at most the number of frame contexts
+		bool vsync = true;						// Present sync interval 1, otherwise 0
+		double startMarginMs = 1.0;				// with vsync: start this much early so Present, not the sleep, meets vblank
+		double headroom = 0.9;					// share of the target a frame may be predicted to use
+		uint32_t switchFrames = 30;				// frames a new queue depth must be wanted before switching
+		double averageWeight = 0.1;				// EMA weight of the newest sample
+	};
+
+	struct StageStats
+	{
+		double lastMs = 0.0;
+		double avgMs = 0.0;		// exponential moving average
+		double devMs = 0.0;		// moving mean absolute deviation (jitter)
+		uint64_t samples = 0;
+	};
+
+	void Reset(const Config& config);
+
+	// Returns the time since the previous frame start in seconds (0 for the first frame)
+	double BeginFrame(double nowMs);
+	// Stages may be reported in any order, several times per frame (they add up)
+	void AddStage(FrameStage stage, double ms);
+	// GPU time per frame on its busiest queue (already averaged by the caller); 0 if unknown
+	void SetGpuFrameMs(double ms)					{ m_GpuMs = ms > 0.0 ? ms : 0.0; }
+	// Folds this frame's stage times into the averages and updates the policy
+	void EndFrame(double nowMs);
+
+	inline uint32_t GetQueuedFrames() const			{ return m_QueuedFrames; }
+	// Start time of the next frame on the same clock; at or before now means "start immediately"
+	inline double GetNextStartMs() const			{ return m_NextStartMs; }
+	inline uint32_t GetSyncInterval() const			{ return m_Config.vsync ? 1u : 0u; }
+	inline const Config& GetConfig() const			{ return m_Config; }
+	inline const StageStats& GetStage(FrameStage stage) const { return m_Stages[(size_t)stage]; }
+	inline const StageStats& GetFrame() const		{ return m_Frame; }		// start to start
+	inline uint64_t GetFrameNumber() const			{ return m_FrameNumber; }
+	inline uint64_t GetDepthSwitchCount() const		{ return m_DepthSwitches; }
+
+	// CPU time of Render..Postprocess (stalls excluded) and its jitter
+	double GetBusyMs() const;
+	double GetJitterMs() const;
+	// Queue depth the timings ask for, before hysteresis
+	uint32_t GetNeededQueuedFrames() const;
+
+	static const char* GetStageName(FrameStage stage);
+
+	// steady_clock in ms
+	static double NowMs();
+	// Sleeps most of the way, then yields until targetMs (sleep granularity is coarse on Windows)
+	static void SleepUntil(double targetMs);
+
+private:
+	void Accumulate(StageStats& stats, double ms) const;
+	void UpdateQueueDepth();
+	void UpdateNextStart(double nowMs);
+
+private:
+	Config m_Config{};
+
+	StageStats m_Stages[(size_t)FrameStage::Count]{};
+	StageStats m_Frame{};
+	double m_Pending[(size_t)FrameStage::Count]{};	// this frame, not folded in yet
+
+	double m_GpuMs = 0.0;
+
+	double m_FrameStartMs = 0.0;
+	double m_NextStartMs = 0.0;
+	uint64_t m_FrameNumber = 0;
+
+	uint32_t m_QueuedFrames = 1;
+	uint32_t m_WantedFrames = 1;
+	uint32_t m_WantedStreak = 0;
+	uint64_t m_DepthSwitches = 0;
+};
+
+// Adds the scope's duration to one stage
+class ScopedFrameStage
+{
+public:
+	ScopedFrameStage(FramePacer& pacer, FrameStage stage)
+		: m_Pacer(pacer), m_Stage(stage), m_BeginMs(FramePacer::NowMs()) {}
+	~ScopedFrameStage() { m_Pacer.AddStage(m_Stage, FramePacer::NowMs() - m_BeginMs); }
+
+	ScopedFrameStage(const ScopedFrameStage&) = delete;
+	ScopedFrameStage& operator=(const ScopedFrameStage&) = delete;
+
+private:
+	FramePacer& m_Pacer;
+	FrameStage m_Stage;
+	double m_BeginMs;
+};
@@ -0,0 +1,247 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	thread_local unsigned s_ThreadIndex = 0;
+}
+
+bool JobSystem::Init(unsigned workerCount)
+{
+	if (IsRunning())
+	{
+		return true;
+	}
+
+	if (workerCount == 0)
+	{
+		const unsigned hw = std::thread::hardware_concurrency();
+		workerCount = hw > 1 ? hw - 1 : 1;
+	}
+
+	// queue 0: non-worker threads, 1..N: workers
+	m_Queues.clear();
+	for (unsigned i = 0; i <= workerCount; ++i)
+	{
+		m_Queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	m_Running.store(true, std::memory_order_release);
+	for (unsigned i = 1; i <= workerCount; ++i)
+	{
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	return true;
+}
+
+void JobSystem::Shutdown()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	m_Running.store(false, std::memory_order_release);
+	m_SleepCV.notify_all();
+	for (std::thread& worker : m_Workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+	m_Workers.clear();
+
+	// Anything still queued runs here so no waiter is left hanging
+	while (TryRunOne(0)) {}
+
+	m_Queues.clear();
+	m_Pending.store(0);
+}
+
+unsigned JobSystem::GetThreadIndex()
+{
+	return s_ThreadIndex;
+}
+
+JobSystem::JobHandle JobSystem::CreateJob(std::function<void()> fn, const JobHandle& parent)
+{
+	JobHandle job = std::make_shared<Job>();
+	job->fn = std::move(fn);
+	job->parent = parent;
+	if (parent)
+	{
+		parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+void JobSystem::Run(const JobHandle& job)
+{
+	if (!job)
+	{
+		return;
+	}
+
+	// Not initialized (or shutting down): run inline
+	if (!IsRunning() || m_Queues.empty())
+	{
+		Execute(job);
+		return;
+	}
+
+	WorkQueue& queue = *m_Queues[std::min<size_t>(GetThreadIndex(), m_Queues.size() - 1)];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+	}
+	m_Pending.fetch_add(1, std::memory_order_release);
+	m_SleepCV.notify_one();
+}
+
+JobSystem::JobHandle JobSystem::Schedule(std::function<void()> fn, const JobHandle& parent)
+{
+	JobHandle job = CreateJob(std::move(fn), parent);
+	Run(job);
+	return job;
+}
+
+void JobSystem::Wait(const JobHandle& job)
+{
+	const unsigned index = GetThreadIndex();
+	while (!IsDone(job))
+	{
+		if (!TryRunOne(index))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::ParallelForRange(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+
+	grain = std::max<size_t>(grain, 1);
+	const size_t count = (end - begin + grain - 1) / grain;
+	if (count == 1 || !IsRunning())
+	{
+		fn(begin, end);
+		return;
+	}
+
+	JobHandle root = CreateJob(nullptr);
+	for (size_t b = begin; b < end; b += grain)
+	{
+		const size_t e = std::min(end, b + grain);
+		Run(CreateJob([&fn, b, e]() { fn(b, e); }, root));
+	}
+	Run(root);
+	Wait(root);
+}
+
+void JobSystem::WorkerLoop(unsigned index)
+{
+	s_ThreadIndex = index;
+
+	while (IsRunning())
+	{
+		if (TryRunOne(index))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_SleepMutex);
+		m_SleepCV.wait_for(lock, std::chrono::milliseconds(1), [this]()
+			{
+				return m_Pending.load(std::memory_order_acquire) > 0 || !IsRunning();
+			});
+	}
+}
+
+bool JobSystem::TryRunOne(unsigned index)
+{
+	if (m_Queues.empty())
+	{
+		return false;
+	}
+
+	JobHandle job = PopOwn(index);
+	if (!job)
+	{
+		job = Steal(index);
+	}
+	if (!job)
+	{
+		return false;
+	}
+
+	m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+	Execute(job);
+	return true;
+}
+
+JobSystem::JobHandle JobSystem::PopOwn(unsigned index)
+{
+	WorkQueue& queue = *m_Queues[std::min<size_t>(index, m_Queues.size() - 1)];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.jobs.empty())
+	{
+		return nullptr;
+	}
+
+	// LIFO for the owner: hot in cache, children before siblings
+	JobHandle job = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+	return job;
+}
+
+JobSystem::JobHandle JobSystem::Steal(unsigned thief)
+{
+	const size_t n = m_Queues.size();
+	for (size_t k = 1; k < n; ++k)
+	{
+		WorkQueue& queue = *m_Queues[(thief + k) % n];
+		std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+		if (!lock.owns_lock() || queue.jobs.empty())
+		{
+			continue;
+		}
+
+		// FIFO for thieves: oldest (usually largest) work first
+		JobHandle job = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+		return job;
+	}
+	return nullptr;
+}
+
+void JobSystem::Execute(const JobHandle& job)
+{
+	if (job->fn)
+	{
+		job->fn();
+	}
+	Finish(job);
+}
+
+void JobSystem::Finish(const JobHandle& job)
+{
+	if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+	{
+		return;
+	}
+
+	// Last piece of this job: release the parent's slot
+	JobHandle parent = std::move(job->parent);
+	if (parent)
+	{
+		Finish(parent);
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define DX_JOB JobSystem::Get()
+
+//===================================================================//
+// Work-stealing job system (portable, std only)
+//  - one deque per worker: owner pushes/pops at the back, thieves steal the front
+//  - parent/child: a job completes once its own function and every child has finished
+//  - Wait() helps run jobs instead of sleeping
+// Queue 0 belongs to the threads that are not workers (main thread); workers use 1..N.
+//===================================================================//
+class JobSystem
+{
+public:
+	struct Job
+	{
+		std::function<void()> fn;
+		std::shared_ptr<Job> parent;
+		std::atomic<int> unfinished{ 1 };	// self + children
+	};
+	using JobHandle = std::shared_ptr<Job>;
+
+public: // Singleton pattern to ensure only one instance exists
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	inline static JobSystem& Get()
+	{
+		static JobSystem instance;
+		return instance;
+	}
+
+private:
+	JobSystem() = default;
+
+public:
+	~JobSystem() { Shutdown(); }
+
+	// workerCount 0 -> hardware_concurrency - 1 (at least 1)
+	bool Init(unsigned workerCount = 0);
+	void Shutdown();
+
+	// Create does not schedule; children must be created before their parent can finish
+	JobHandle CreateJob(std::function<void()> fn, const JobHandle& parent = nullptr);
+	void Run(const JobHandle& job);
+	JobHandle Schedule(std::function<void()> fn, const JobHandle& parent = nullptr);
+
+	void Wait(const JobHandle& job);
+	static bool IsDone(const JobHandle& job) { return !job || job->unfinished.load(std::memory_order_acquire) <= 0; }
+
+	// fn(begin, end) on sub-ranges of [begin, end); blocks until all ranges are done
+	void ParallelForRange(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+	// fn(i) for every i in [begin, end)
+	template<typename Fn>
+	void ParallelFor(size_t begin, size_t end, size_t grain, Fn&& fn)
+	{
+		ParallelForRange(begin, end, grain, [&fn](size_t b, size_t e)
+			{
+				for (size_t i = b; i < e; ++i)
+				{
+					fn(i);
+				}
+			});
+	}
+
+	inline bool IsRunning() const			{ return m_Running.load(std::memory_order_acquire); }
+	inline unsigned GetWorkerCount() const	{ return (unsigned)m_Workers.size(); }
+	// 0 for non-worker threads, 1..N for workers (index into per-thread data)
+	static unsigned GetThreadIndex();
+
+private:
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<JobHandle> jobs;
+	};
+
+	void WorkerLoop(unsigned index);
+	bool TryRunOne(unsigned index);
+	JobHandle PopOwn(unsigned index);
+	JobHandle Steal(unsigned thief);
+	void Execute(const JobHandle& job);
+	void Finish(const JobHandle& job);
+
+private:
+	std::vector<std::thread> m_Workers;
+	std::vector<std::unique_ptr<WorkQueue>> m_Queues;
+
+	std::atomic<bool> m_Running{ false };
+	std::atomic<int> m_Pending{ 0 };
+
+	std::mutex m_SleepMutex;
+	std::condition_variable m_SleepCV;
+};
@@ -0,0 +1,237 @@
+#include "OnnxCpuSession.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+Ort::SessionOptions OnnxCpuSession::MakeOptions(const Config& config)
+{
+	// No EP appended: ORT runs every node on its CPU provider
+	Ort::SessionOptions options;
+	options.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
+	options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+	if (config.globalThreadPools)
+	{
+		options.DisablePerSessionThreads();
+		return options;
+	}
+	options.SetIntraOpNumThreads(std::max<int>(config.intraOpThreads, 0));
+	options.SetInterOpNumThreads(1);
+	options.AddConfigEntry("session.intra_op.allow_spinning", config.allowSpinning ? "1" : "0");
+	return options;
+}
+
+bool OnnxCpuSession::Init(Ort::Session* session)
+{
+	Release();
+	m_Binding.reset();
+	m_Inputs.clear();
+	m_Output = HostTensor{};
+	m_Session = session;
+	if (m_Session == nullptr)
+	{
+		return Fail("no session");
+	}
+
+	try
+	{
+		const size_t inputCount = m_Session->GetInputCount();
+		if (inputCount == 0 || inputCount > 2 || m_Session->GetOutputCount() == 0)
+		{
+			return Fail("expected a content (and style) input and an image output");
+		}
+
+		Ort::AllocatorWithDefaultOptions alloc;
+		m_Inputs.resize(inputCount);
+		for (size_t i = 0; i < inputCount; ++i)
+		{
+			m_Inputs[i].name = m_Session->GetInputNameAllocated(i, alloc).get();
+			m_Inputs[i].modelShape = m_Session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+		}
+		m_Output.name = m_Session->GetOutputNameAllocated(0, alloc).get();
+		m_Output.modelShape = m_Session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+
+		const ONNXTensorElementDataType inType = m_Session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType();
+		const ONNXTensorElementDataType outType = m_Session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType();
+		const bool supported = inType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || inType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+		if (supported == false || inType != outType)
+		{
+			return Fail("unsupported tensor types (input " + std::to_string((int)inType) + ", output " + std::to_string((int)outType) + ")");
+		}
+		m_ElemType = inType;
+
+		m_MemInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+		m_Binding = std::make_unique<Ort::IoBinding>(*m_Session);
+	}
+	catch (const Ort::Exception& e)
+	{
+		return Fail(e.what());
+	}
+
+	m_Error.clear();
+	return true;
+}
+
+bool OnnxCpuSession::Prepare(const std::vector<int64_t>& contentShape, const std::vector<int64_t>& styleShape,
+	const std::vector<int64_t>& outShape)
+{
+	if (!m_Binding)
+	{
+		return Fail("not initialized");
+	}
+
+	try
+	{
+		m_Binding->ClearBoundInputs();
+		m_Binding->ClearBoundOutputs();
+
+		for (size_t i = 0; i < m_Inputs.size(); ++i)
+		{
+			if (CreateHostTensor(m_Inputs[i], i == 0 ? contentShape : styleShape) == false)
+			{
+				return Fail("input " + m_Inputs[i].name + " has no complete shape");
+			}
+			m_Binding->BindInput(m_Inputs[i].name.c_str(), m_Inputs[i].tensor);
+		}
+
+		// A static output needs no prediction; otherwise ORT allocates on the first Run
+		const bool modelStatic = m_Output.modelShape.empty() == false &&
+			std::all_of(m_Output.modelShape.begin(), m_Output.modelShape.end(), [](int64_t d) { return d > 0; });
+		const std::vector<int64_t>& known = outShape.empty() && modelStatic ? m_Output.modelShape : outShape;
+
+		m_OutputBound = known.empty() == false && CreateHostTensor(m_Output, known);
+		m_OutputPredicted = m_OutputBound && modelStatic == false;
+		if (m_OutputBound)
+		{
+			m_Binding->BindOutput(m_Output.name.c_str(), m_Output.tensor);
+		}
+		else
+		{
+			m_Output.shape.clear();
+			m_Output.data.clear();
+			m_Output.tensor = Ort::Value{ nullptr };
+			m_Binding->BindOutput(m_Output.name.c_str(), m_MemInfo);
+		}
+	}
+	catch (const Ort::Exception& e)
+	{
+		return Fail(e.what());
+	}
+
+	m_Error.clear();
+	return true;
+}
+
+bool OnnxCpuSession::Run()
+{
+	if (!m_Binding || m_Inputs.empty() || m_Inputs[0].data.empty())
+	{
+		return Fail("not prepared");
+	}
+
+	try
+	{
+		const auto begin = std::chrono::steady_clock::now();
+		m_Session->Run(Ort::RunOptions{ nullptr }, *m_Binding);
+		m_LastSessionMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	}
+	catch (const Ort::Exception& e)
+	{
+		// A wrong prediction only costs one discovery Run
+		if (m_OutputPredicted == false)
+		{
+			return Fail(e.what());
+		}
+		m_OutputPredicted = false;
+		m_OutputBound = false;
+		m_Output.shape.clear();
+		m_Output.data.clear();
+		m_Output.tensor = Ort::Value{ nullptr };
+		m_Binding->ClearBoundOutputs();
+		m_Binding->BindOutput(m_Output.name.c_str(), m_MemInfo);
+		return Run();
+	}
+
+	m_OutputPredicted = false;
+	if (m_OutputBound)
+	{
+		m_Error.clear();
+		return true;
+	}
+
+	// Shape discovery: keep this Run's result and bind the host buffer for the next ones
+	try
+	{
+		std::vector<Ort::Value> outs = m_Binding->GetOutputValues();
+		const std::vector<int64_t> shape = outs[0].GetTensorTypeAndShapeInfo().GetShape();
+		if (CreateHostTensor(m_Output, shape) == false)
+		{
+			return Fail("output has no complete shape");
+		}
+		std::memcpy(m_Output.data.data(), outs[0].GetTensorRawData(), m_Output.data.size());
+
+		m_Binding->ClearBoundOutputs();
+		m_Binding->BindOutput(m_Output.name.c_str(), m_Output.tensor);
+		m_OutputBound = true;
+	}
+	catch (const Ort::Exception& e)
+	{
+		return Fail(e.what());
+	}
+
+	m_Error.clear();
+	return true;
+}
+
+void OnnxCpuSession::Release()
+{
+	if (m_Binding)
+	{
+		m_Binding->ClearBoundInputs();
+		m_Binding->ClearBoundOutputs();
+	}
+	for (HostTensor& input : m_Inputs)
+	{
+		input.tensor = Ort::Value{ nullptr };
+		input.shape.clear();
+		input.data.clear();
+	}
+	m_Output.tensor = Ort::Value{ nullptr };
+	m_Output.shape.clear();
+	m_Output.data.clear();
+	m_OutputBound = false;
+	m_OutputPredicted = false;
+}
+
+size_t OnnxCpuSession::GetElementBytes() const
+{
+	return m_ElemType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16 ? sizeof(uint16_t) : sizeof(float);
+}
+
+bool OnnxCpuSession::CreateHostTensor(HostTensor& host, const std::vector<int64_t>& shape)
+{
+	if (shape.empty() || std::any_of(shape.begin(), shape.end(), [](int64_t d) { return d <= 0; }))
+	{
+		return false;
+	}
+
+	size_t count = 1;
+	for (int64_t d : shape)
+	{
+		count *= (size_t)d;
+	}
+
+	// The old tensor points at the old storage, so drop it before reallocating
+	host.tensor = Ort::Value{ nullptr };
+	host.shape = shape;
+	host.data.assign(count * GetElementBytes(), 0);
+	host.tensor = Ort::Value::CreateTensor(m_MemInfo, host.data.data(), host.data.size(),
+		host.shape.data(), host.shape.size(), m_ElemType);
+	return true;
+}
+
+bool OnnxCpuSession::Fail(const std::string& error)
+{
+	m_Error = error;
+	return false;
+}
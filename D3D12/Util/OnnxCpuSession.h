@@ -0,0 +1,94 @@
+#pragma once
+
+#include <onnxruntime_cxx_api.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//===================================================================//
+// ORT session on the CPU execution provider over host-memory tensors
+// (portable, std + ORT only: also builds for headless Linux tools)
+//  Init(session) -> Prepare(shapes) once per size -> fill GetInputData()
+//  -> Run() -> read GetOutputData()
+// Inputs are the content image and, for two-input models, the style image.
+// The output is bound to a host buffer as soon as its shape is known
+// (static model, or the shape the caller predicts); otherwise the first
+// Run lets ORT allocate it and the buffer is bound from then on.
+//===================================================================//
+class OnnxCpuSession
+{
+public:
+	struct Config
+	{
+		int intraOpThreads = 0;			// 0: ORT default (one per physical core)
+		bool allowSpinning = true;		// false: idle pool threads sleep between Runs
+		bool globalThreadPools = false;	// run on the env's global pools (created with Ort::ThreadingOptions);
+										// the two settings above then come from the env
+	};
+
+	// CPU EP options; the caller creates the session from them (model cache, or directly)
+	static Ort::SessionOptions MakeOptions(const Config& config);
+
+	// session is owned by the caller and must outlive this object
+	bool Init(Ort::Session* session);
+
+	// Shapes are complete ([N,C,H,W], no dynamic axes). styleShape is ignored for one-input models.
+	// outShape: expected output shape, or empty to discover it on the first Run
+	bool Prepare(const std::vector<int64_t>& contentShape, const std::vector<int64_t>& styleShape,
+		const std::vector<int64_t>& outShape);
+	bool Run();
+	void Release();
+
+	//===========Getter=================//
+	size_t GetInputCount() const							{ return m_Inputs.size(); }
+	const std::string& GetInputName(size_t i) const			{ return m_Inputs[i].name; }
+	const std::vector<int64_t>& GetModelInputShape(size_t i) const	{ return m_Inputs[i].modelShape; }
+	const std::vector<int64_t>& GetInputShape(size_t i) const	{ return m_Inputs[i].shape; }
+	void* GetInputData(size_t i)							{ return m_Inputs[i].data.data(); }
+	size_t GetInputBytes(size_t i) const					{ return m_Inputs[i].data.size(); }
+
+	const std::string& GetOutputName() const				{ return m_Output.name; }
+	const std::vector<int64_t>& GetModelOutputShape() const	{ return m_Output.modelShape; }
+	const std::vector<int64_t>& GetOutputShape() const		{ return m_Output.shape; }
+	const void* GetOutputData() const						{ return m_Output.data.data(); }
+	size_t GetOutputBytes() const							{ return m_Output.data.size(); }
+	bool IsOutputBound() const								{ return m_OutputBound; }
+	// The output was bound from the caller's prediction and no Run has confirmed it yet
+	bool IsOutputPredicted() const							{ return m_OutputPredicted; }
+
+	ONNXTensorElementDataType GetElementType() const		{ return m_ElemType; }
+	size_t GetElementBytes() const;
+	double GetLastSessionMs() const							{ return m_LastSessionMs; }
+	// Reason of the last failed call
+	const std::string& GetError() const						{ return m_Error; }
+	//==================================//
+
+private:
+	struct HostTensor
+	{
+		std::string name;
+		std::vector<int64_t> modelShape;	// as declared (dynamic axes < 0)
+		std::vector<int64_t> shape;
+		std::vector<uint8_t> data;
+		Ort::Value tensor{ nullptr };
+	};
+
+	bool CreateHostTensor(HostTensor& host, const std::vector<int64_t>& shape);
+	bool Fail(const std::string& error);
+
+private:
+	Ort::Session* m_Session = nullptr;
+	Ort::MemoryInfo m_MemInfo{ nullptr };
+	std::unique_ptr<Ort::IoBinding> m_Binding;
+
+	std::vector<HostTensor> m_Inputs;
+	HostTensor m_Output;
+	bool m_OutputBound = false;
+	bool m_OutputPredicted = false;
+
+	ONNXTensorElementDataType m_ElemType = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+	double m_LastSessionMs = 0.0;
+	std::string m_Error;
+};
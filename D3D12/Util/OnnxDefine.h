@@ -6,6 +6,7 @@
 #include <d3dcompiler.h>
 #include <onnxruntime_cxx_api.h>
 #include <memory>
+#include <cstring>
 
 enum class OnnxType : short
 {
@@ -18,6 +19,26 @@ enum class OnnxType : short
 };
 
 
+// ߷   ִ  (  + 1). Ը /ORT    
+constexpr UINT ONNX_MAX_PIPELINE_SLOTS = 3;
+
+// ġ ִ ũ (Է ϳ [N,C,H,W]  / )
+constexpr UINT ONNX_MAX_BATCH = 8;
+
+// Ÿ ߷  (OnnxManager, ONNX_TILE_SIZE). TilesX == 0̸ Ÿ 
+// ʴ TileW x TileH  ũθ , ó/ó Ÿ ̾   [N][C][TileH][TileW] 
+// ึ Ÿ i  = i * (Img - Tile) / (Tiles - 1): ù/ Ÿ ڸ ٰ ̴  ħ
+struct OnnxTileGrid
+{
+    UINT TileW = 0, TileH = 0;
+    UINT ImgW = 0, ImgH = 0;
+    UINT TilesX = 0, TilesY = 0;
+
+    bool IsTiled() const { return TilesX > 0 && TilesY > 0; }
+    UINT Count() const { return TilesX * TilesY; }
+};
+
+
 class OnnxPassResources {
 public:
     //ComPointer<ID3D12Resource> SceneTex;
@@ -32,6 +53,10 @@ public:
     ComPointer<ID3D12RootSignature> m_PreRS;
     ComPointer<ID3D12PipelineState> m_PrePSO, m_PostPSO;
 
+    // ð  (OnnxService_Temporal): Ű  / 
+    ComPointer<ID3D12RootSignature> m_TemporalRS;
+    ComPointer<ID3D12PipelineState> m_HistoryPSO, m_ReprojectPSO;
+
     UINT m_Width = 0, m_Height = 0;
 };
 
@@ -74,8 +99,38 @@ struct OnnxGPUResources{
     D3D12_GPU_DESCRIPTOR_HANDLE m_InputStyleUAV_GPU_ForClear{};
     D3D12_CPU_DESCRIPTOR_HANDLE m_InputStyleUAV_CPU_ForClear{};
 
+    // Ժ ũ   (Ʈ).  s ڵ = ⺻ ڵ + s * m_SlotStride
+    UINT m_SlotStride = 0;
+
+    // ð :  Ű OnnxTex/ 纻   (OnnxService_Temporal )
+    ComPointer<ID3D12Resource2> m_HistoryTex;      // RGBA8
+    ComPointer<ID3D12Resource2> m_HistoryDepth;    // R32_FLOAT, ġ ̰
+    ComPointer<ID3D12DescriptorHeap> m_TemporalHeap;
+    D3D12_RESOURCE_STATES m_HistoryState = D3D12_RESOURCE_STATE_COMMON;
+
 public:
+    //  CB ¿  ( ε     fallback)
+    D3D12_GPU_VIRTUAL_ADDRESS WriteConstants(UINT offset, const void* data, UINT size) {
+        uint8_t* base = nullptr;
+        if (FAILED(m_CB->Map(0, nullptr, (void**)&base)) || base == nullptr) return 0;
+        std::memcpy(base + offset, data, size);
+        m_CB->Unmap(0, nullptr);
+        return m_CB->GetGPUVirtualAddress() + offset;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE SlotCPU(D3D12_CPU_DESCRIPTOR_HANDLE h, UINT slot) const {
+        h.ptr += (SIZE_T)slot * m_SlotStride;
+        return h;
+    }
+    D3D12_GPU_DESCRIPTOR_HANDLE SlotGPU(D3D12_GPU_DESCRIPTOR_HANDLE h, UINT slot) const {
+        h.ptr += (UINT64)slot * m_SlotStride;
+        return h;
+    }
+
     void Reset() {
+        m_HistoryTex.Release();
+        m_HistoryDepth.Release();
+        m_TemporalHeap.Release();
         m_OnnxTex.Release();
         m_CB.Release();
         m_Heap.Release();
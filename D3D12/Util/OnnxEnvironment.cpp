@@ -0,0 +1,138 @@
+#include "OnnxEnvironment.h"
+
+#include "Support/WinInclude.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+extern const bool ONNX_GLOBAL_THREAD_POOLS;
+extern const int ONNX_INTRA_OP_THREADS;
+extern const int ONNX_INTER_OP_THREADS;
+extern const bool ONNX_THREAD_SPIN;
+extern const char* ONNX_THREAD_AFFINITY;
+
+namespace
+{
+	constexpr double kUtilWeight = 0.1;
+
+	OnnxEnvironment::Utilization sUtilization;
+
+	int CountPhysicalCores()
+	{
+		DWORD bytes = 0;
+		GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &bytes);
+		if (bytes == 0)
+		{
+			return 1;
+		}
+
+		std::vector<uint8_t> buffer(bytes);
+		auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+		if (GetLogicalProcessorInformationEx(RelationProcessorCore, info, &bytes) == FALSE)
+		{
+			return 1;
+		}
+
+		int cores = 0;
+		for (DWORD offset = 0; offset < bytes; ++cores)
+		{
+			offset += reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset)->Size;
+		}
+		return std::max<int>(cores, 1);
+	}
+
+	double ProcessCpuMs()
+	{
+		FILETIME creation, exit, kernel, user;
+		if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user) == FALSE)
+		{
+			return 0.0;
+		}
+		auto ticks = [](const FILETIME& t) { return ((uint64_t)t.dwHighDateTime << 32) | t.dwLowDateTime; };
+		return (double)(ticks(kernel) + ticks(user)) / 10000.0;	// 100 ns units
+	}
+}
+
+Ort::Env& OnnxEnvironment::Get()
+{
+	// Leaked on purpose: sessions still alive at static destruction would otherwise outlive their env
+	static Ort::Env* env = []() {
+		if (ONNX_GLOBAL_THREAD_POOLS == false)
+		{
+			return new Ort::Env(ORT_LOGGING_LEVEL_WARNING, "app");
+		}
+
+		Ort::ThreadingOptions threading;
+		threading.SetGlobalIntraOpNumThreads(std::max<int>(ONNX_INTRA_OP_THREADS, 0));
+		threading.SetGlobalInterOpNumThreads(std::max<int>(ONNX_INTER_OP_THREADS, 0));
+		threading.SetGlobalSpinControl(ONNX_THREAD_SPIN ? 1 : 0);
+		if (ONNX_THREAD_AFFINITY != nullptr && ONNX_THREAD_AFFINITY[0] != '\0')
+		{
+			threading.SetGlobalIntraOpThreadAffinity(ONNX_THREAD_AFFINITY);
+		}
+
+		char buf[256];
+		sprintf_s(buf, "[OnnxEnvironment] global pools: intra-op %d threads, inter-op %d, spin %s, affinity %s\n",
+			GetIntraOpThreads(), GetInterOpThreads(), ONNX_THREAD_SPIN ? "on" : "off",
+			ONNX_THREAD_AFFINITY != nullptr && ONNX_THREAD_AFFINITY[0] != '\0' ? ONNX_THREAD_AFFINITY : "OS");
+		OutputDebugStringA(buf);
+		return new Ort::Env(threading, ORT_LOGGING_LEVEL_WARNING, "app");
+		}();
+	return *env;
+}
+
+void OnnxEnvironment::ApplySessionThreading(Ort::SessionOptions& options, int intraOpThreads)
+{
+	if (ONNX_GLOBAL_THREAD_POOLS)
+	{
+		options.DisablePerSessionThreads();
+		return;
+	}
+	options.SetIntraOpNumThreads(std::max<int>(intraOpThreads, 0));
+}
+
+bool OnnxEnvironment::UsesGlobalPools()
+{
+	return ONNX_GLOBAL_THREAD_POOLS;
+}
+
+int OnnxEnvironment::GetIntraOpThreads()
+{
+	static const int physicalCores = CountPhysicalCores();
+	return ONNX_INTRA_OP_THREADS > 0 ? ONNX_INTRA_OP_THREADS : physicalCores;
+}
+
+int OnnxEnvironment::GetInterOpThreads()
+{
+	static const int physicalCores = CountPhysicalCores();
+	return ONNX_INTER_OP_THREADS > 0 ? ONNX_INTER_OP_THREADS : physicalCores;
+}
+
+OnnxEnvironment::Utilization OnnxEnvironment::GetUtilization()
+{
+	return sUtilization;
+}
+
+OnnxEnvironment::RunScope::RunScope()
+	: m_Begin(std::chrono::steady_clock::now())
+	, m_CpuBeginMs(ProcessCpuMs())
+{
+}
+
+OnnxEnvironment::RunScope::~RunScope()
+{
+	const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Begin).count();
+	const double cpuMs = std::max<double>(ProcessCpuMs() - m_CpuBeginMs, 0.0);
+	if (wallMs <= 0.0)
+	{
+		return;
+	}
+
+	// GetProcessTimes ticks at the scheduler quantum, so single short Runs are noisy; the average is not
+	const double util = std::min<double>(cpuMs / (wallMs * GetIntraOpThreads()), 1.0);
+	sUtilization.lastUtil = util;
+	sUtilization.avgUtil = sUtilization.runs++ == 0 ? util : sUtilization.avgUtil + (util - sUtilization.avgUtil) * kUtilWeight;
+	sUtilization.wallMs += wallMs;
+	sUtilization.cpuMs += cpuMs;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <onnxruntime_cxx_api.h>
+
+#include <chrono>
+#include <cstdint>
+
+//===================================================================//
+// Process-wide ORT environment shared by every runner and session
+//  ONNX_GLOBAL_THREAD_POOLS: one intra-op and one inter-op pool owned by the
+//  env (ONNX_INTRA_OP_THREADS / ONNX_INTER_OP_THREADS, ONNX_THREAD_SPIN,
+//  ONNX_THREAD_AFFINITY) instead of a pool per session, so pooled runners and
+//  the CPU fallback do not oversubscribe the cores or duplicate thread stacks.
+// RunScope around Session::Run measures how busy the intra-op pool was:
+// process CPU time over wall time x pool threads (the calling thread is one
+// of them). Other threads of the process count too, so it is an upper bound.
+//===================================================================//
+class OnnxEnvironment
+{
+public:
+	// Created on first use from the config globals; never destroyed, so it outlives every session
+	static Ort::Env& Get();
+
+	// Sessions use the global pools when they exist, otherwise their own pool of intraOpThreads
+	static void ApplySessionThreading(Ort::SessionOptions& options, int intraOpThreads);
+
+	static bool UsesGlobalPools();
+	// Effective pool sizes (0 in the config resolves to ORT's default: one per physical core)
+	static int GetIntraOpThreads();
+	static int GetInterOpThreads();
+
+	struct Utilization
+	{
+		uint64_t runs = 0;
+		double lastUtil = 0.0;		// 0..1 of the intra-op pool during the last Run
+		double avgUtil = 0.0;
+		double wallMs = 0.0;		// totals over all Runs
+		double cpuMs = 0.0;
+	};
+	static Utilization GetUtilization();
+
+	class RunScope
+	{
+	public:
+		RunScope();
+		~RunScope();
+
+		RunScope(const RunScope&) = delete;
+		RunScope& operator=(const RunScope&) = delete;
+
+	private:
+		std::chrono::steady_clock::time_point m_Begin;
+		double m_CpuBeginMs = 0.0;
+	};
+};
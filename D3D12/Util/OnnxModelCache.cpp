@@ -0,0 +1,193 @@
+#include "OnnxModelCache.h"
+
+#include "Support/WinInclude.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+extern const bool ONNX_MODEL_CACHE;
+
+namespace
+{
+	constexpr const wchar_t* kCacheDir = L"./Resources/Onnx/Cache";
+	constexpr const wchar_t* kShapeTable = L"./Resources/Onnx/Cache/shape_functions.txt";
+
+	// Model name + file size: cheap enough to check on every Init, and a re-exported model gets a new entry
+	std::string ShapeKey(const std::wstring& modelPath)
+	{
+		std::error_code ec;
+		const uint64_t size = (uint64_t)std::filesystem::file_size(modelPath, ec);
+		return std::filesystem::path(modelPath).stem().string() + "_" + std::to_string(ec ? 0 : size);
+	}
+
+	std::map<std::string, OnnxShapeFunction> ReadShapeTable()
+	{
+		std::map<std::string, OnnxShapeFunction> table;
+		std::ifstream file(std::filesystem::path(kShapeTable));
+		std::string key;
+		OnnxShapeFunction fn;
+		while (file >> key >> fn.fixed[0] >> fn.fixed[1] >> fn.align[0] >> fn.align[1])
+		{
+			table[key] = fn;
+		}
+		return table;
+	}
+
+	double ElapsedMs(std::chrono::steady_clock::time_point begin)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	}
+}
+
+std::unique_ptr<Ort::Session> OnnxModelCache::CreateSession(
+	Ort::Env& env,
+	const std::wstring& modelPath,
+	const Ort::SessionOptions& options,
+	const char* epName)
+{
+	const auto begin = std::chrono::steady_clock::now();
+
+	bool warm = false;
+	const std::wstring path = ONNX_MODEL_CACHE ? Resolve(env, modelPath, epName, warm) : modelPath;
+	const double resolveMs = ElapsedMs(begin);
+
+	auto session = std::make_unique<Ort::Session>(env, path.c_str(), options);
+	const double totalMs = ElapsedMs(begin);
+
+	// cold: cache built (or disabled) this launch, warm: graph loaded from the cache
+	char buf[512];
+	sprintf_s(buf, "[OnnxModelCache] %s session %ls: %.1f ms (cache %.1f ms, create %.1f ms)\n",
+		warm ? "warm" : "cold", std::filesystem::path(modelPath).filename().c_str(),
+		totalMs, resolveMs, totalMs - resolveMs);
+	OutputDebugStringA(buf);
+
+	return session;
+}
+
+std::wstring OnnxModelCache::Resolve(Ort::Env& env, const std::wstring& modelPath, const char* epName, bool& outWarm)
+{
+	outWarm = false;
+
+	uint64_t hash = 0;
+	if (HashFile(modelPath, hash) == false)
+	{
+		return modelPath;
+	}
+
+	// Key: model contents + ORT version + EP; a new runtime or a different EP never reads an old graph
+	wchar_t key[256];
+	swprintf_s(key, L"%ls_%016llx_ort%hs_%hs.onnx",
+		std::filesystem::path(modelPath).stem().c_str(), (unsigned long long)hash,
+		OrtGetApiBase()->GetVersionString(), epName != nullptr ? epName : "none");
+
+	std::error_code ec;
+	const std::filesystem::path cachePath = std::filesystem::path(kCacheDir) / key;
+	if (std::filesystem::exists(cachePath, ec))
+	{
+		outWarm = true;
+		return cachePath.wstring();
+	}
+
+	std::filesystem::create_directories(kCacheDir, ec);
+	if (ec)
+	{
+		return modelPath;
+	}
+
+	// Basic level only: those passes run before partitioning and are valid for every EP.
+	// Written to a temp file first so a crash never leaves a half-written graph under the real key
+	std::filesystem::path tmpPath = cachePath;
+	tmpPath += L".tmp";
+	try
+	{
+		Ort::SessionOptions so;
+		so.SetIntraOpNumThreads(1);
+		so.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_BASIC);
+		so.SetOptimizedModelFilePath(tmpPath.c_str());
+		Ort::Session writer(env, modelPath.c_str(), so);
+	}
+	catch (const Ort::Exception& e)
+	{
+		char buf[512];
+		sprintf_s(buf, "[OnnxModelCache] optimize failed, using source model: %s\n", e.what());
+		OutputDebugStringA(buf);
+		std::filesystem::remove(tmpPath, ec);
+		return modelPath;
+	}
+
+	std::filesystem::rename(tmpPath, cachePath, ec);
+	if (ec)
+	{
+		std::filesystem::remove(tmpPath, ec);
+		return modelPath;
+	}
+	return cachePath.wstring();
+}
+
+bool OnnxModelCache::HashFile(const std::wstring& path, uint64_t& outHash)
+{
+	std::ifstream file(std::filesystem::path(path), std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	// FNV-1a 64
+	uint64_t hash = 14695981039346656037ull;
+	std::vector<char> chunk(1 << 20);
+	while (file)
+	{
+		file.read(chunk.data(), (std::streamsize)chunk.size());
+		const std::streamsize count = file.gcount();
+		for (std::streamsize i = 0; i < count; ++i)
+		{
+			hash ^= (uint8_t)chunk[(size_t)i];
+			hash *= 1099511628211ull;
+		}
+	}
+
+	outHash = hash;
+	return true;
+}
+
+bool OnnxModelCache::LoadShapeFunction(const std::wstring& modelPath, OnnxShapeFunction& outFn)
+{
+	if (ONNX_MODEL_CACHE == false)
+	{
+		return false;
+	}
+
+	const auto table = ReadShapeTable();
+	auto it = table.find(ShapeKey(modelPath));
+	if (it == table.end())
+	{
+		return false;
+	}
+	outFn = it->second;
+	return true;
+}
+
+void OnnxModelCache::StoreShapeFunction(const std::wstring& modelPath, const OnnxShapeFunction& fn)
+{
+	if (ONNX_MODEL_CACHE == false)
+	{
+		return;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(kCacheDir, ec);
+
+	auto table = ReadShapeTable();
+	table[ShapeKey(modelPath)] = fn;
+
+	std::ofstream file(std::filesystem::path(kShapeTable), std::ios::trunc);
+	for (const auto& [key, entry] : table)
+	{
+		file << key << ' ' << entry.fixed[0] << ' ' << entry.fixed[1] << ' ' << entry.align[0] << ' ' << entry.align[1] << '\n';
+	}
+}
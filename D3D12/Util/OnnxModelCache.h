@@ -0,0 +1,50 @@
+#pragma once
+
+#include <onnxruntime_cxx_api.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Output H/W as a function of the content input H/W, per axis (0 = H, 1 = W):
+//  fixed > 0: constant, else align > 0: (in / align) * align, else unknown
+struct OnnxShapeFunction
+{
+	int64_t fixed[2] = { 0, 0 };
+	int64_t align[2] = { 0, 0 };
+
+	bool IsKnown(int axis) const	{ return fixed[axis] > 0 || align[axis] > 0; }
+	bool IsKnown() const			{ return IsKnown(0) && IsKnown(1); }
+	int64_t Apply(int axis, int64_t in) const
+	{
+		return fixed[axis] > 0 ? fixed[axis] : (in / align[axis]) * align[axis];
+	}
+};
+
+//===================================================================//
+// On-disk cache of pre-optimized ONNX models
+//  ./Resources/Onnx/Cache/<model>_<file hash>_ort<version>_<ep>.onnx
+// A miss runs the EP-independent (basic) graph optimizations once on the CPU
+// and serializes the result; later sessions load that graph instead of the
+// source model. EP-specific passes (DML fusion/compilation) produce compiled
+// nodes that ORT cannot serialize, so they still run per session.
+//===================================================================//
+class OnnxModelCache
+{
+public:
+	// Creates the session from the cached graph when possible; logs cold vs warm creation time
+	static std::unique_ptr<Ort::Session> CreateSession(
+		Ort::Env& env,
+		const std::wstring& modelPath,
+		const Ort::SessionOptions& options,
+		const char* epName);
+
+	// Cached model path for modelPath, building it on a miss. Returns modelPath if caching fails
+	static std::wstring Resolve(Ort::Env& env, const std::wstring& modelPath, const char* epName, bool& outWarm);
+
+	static bool HashFile(const std::wstring& path, uint64_t& outHash);
+
+	// Shape functions learned from earlier runs (./Resources/Onnx/Cache/shape_functions.txt)
+	static bool LoadShapeFunction(const std::wstring& modelPath, OnnxShapeFunction& outFn);
+	static void StoreShapeFunction(const std::wstring& modelPath, const OnnxShapeFunction& fn);
+};
@@ -0,0 +1,430 @@
+#include "OnnxProfileReport.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace
+{
+	constexpr const char* kKernelSuffix = "_kernel_time";
+
+	struct Event
+	{
+		std::string cat;
+		std::string name;
+		std::string opName;
+		std::string provider;
+		double ts = 0.0;
+		double dur = 0.0;
+	};
+
+	// Just enough JSON for ORT's trace: an array of flat event objects whose "args" may nest
+	class TraceReader
+	{
+	public:
+		explicit TraceReader(const std::string& text) : m_P(text.c_str()), m_End(text.c_str() + text.size()) {}
+
+		bool ReadEvents(std::vector<Event>& events)
+		{
+			SkipWs();
+			if (Eat('[') == false)
+			{
+				return false;
+			}
+			SkipWs();
+			if (Eat(']'))
+			{
+				return true;
+			}
+			do
+			{
+				Event e;
+				if (ReadEvent(e) == false)
+				{
+					return false;
+				}
+				events.push_back(std::move(e));
+				SkipWs();
+			} while (Eat(','));
+			// A trace cut short by a crash has no closing bracket; keep what was read
+			return true;
+		}
+
+	private:
+		bool ReadEvent(Event& e)
+		{
+			return ReadObject([&](const std::string& key) {
+				if (key == "cat")	return ReadString(e.cat);
+				if (key == "name")	return ReadString(e.name);
+				if (key == "ts")	return ReadNumber(e.ts);
+				if (key == "dur")	return ReadNumber(e.dur);
+				if (key == "args")
+				{
+					return ReadObject([&](const std::string& arg) {
+						if (arg == "op_name")	return ReadString(e.opName);
+						if (arg == "provider")	return ReadString(e.provider);
+						return SkipValue();
+						});
+				}
+				return SkipValue();
+				});
+		}
+
+		template <typename OnKey>
+		bool ReadObject(OnKey&& onKey)
+		{
+			SkipWs();
+			if (Eat('{') == false)
+			{
+				return false;
+			}
+			SkipWs();
+			if (Eat('}'))
+			{
+				return true;
+			}
+			do
+			{
+				std::string key;
+				SkipWs();
+				if (ReadString(key) == false)
+				{
+					return false;
+				}
+				SkipWs();
+				if (Eat(':') == false || onKey(key) == false)
+				{
+					return false;
+				}
+				SkipWs();
+			} while (Eat(','));
+			return Eat('}');
+		}
+
+		bool ReadString(std::string& out)
+		{
+			SkipWs();
+			if (Eat('"') == false)
+			{
+				return false;
+			}
+			out.clear();
+			while (m_P < m_End && *m_P != '"')
+			{
+				char c = *m_P++;
+				if (c == '\\' && m_P < m_End)
+				{
+					c = *m_P++;
+					switch (c)
+					{
+					case 'n': c = '\n'; break;
+					case 't': c = '\t'; break;
+					case 'r': c = '\r'; break;
+					case 'b': c = '\b'; break;
+					case 'f': c = '\f'; break;
+					case 'u': m_P = std::min<const char*>(m_P + 4, m_End); c = '?'; break;	// names are ASCII
+					default: break;
+					}
+				}
+				out += c;
+			}
+			return Eat('"');
+		}
+
+		bool ReadNumber(double& out)
+		{
+			SkipWs();
+			char* end = nullptr;
+			out = std::strtod(m_P, &end);
+			if (end == m_P)
+			{
+				return false;
+			}
+			m_P = end;
+			return true;
+		}
+
+		bool SkipValue()
+		{
+			SkipWs();
+			if (m_P >= m_End)
+			{
+				return false;
+			}
+			if (*m_P == '"')
+			{
+				std::string ignored;
+				return ReadString(ignored);
+			}
+			if (*m_P == '{')
+			{
+				return ReadObject([this](const std::string&) { return SkipValue(); });
+			}
+			if (*m_P == '[')
+			{
+				++m_P;
+				SkipWs();
+				if (Eat(']'))
+				{
+					return true;
+				}
+				do
+				{
+					if (SkipValue() == false)
+					{
+						return false;
+					}
+					SkipWs();
+				} while (Eat(','));
+				return Eat(']');
+			}
+			// Number, true, false, null
+			while (m_P < m_End && *m_P != ',' && *m_P != '}' && *m_P != ']' && !IsWs(*m_P))
+			{
+				++m_P;
+			}
+			return true;
+		}
+
+		static bool IsWs(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+		void SkipWs() { while (m_P < m_End && IsWs(*m_P)) ++m_P; }
+		bool Eat(char c)
+		{
+			if (m_P < m_End && *m_P == c)
+			{
+				++m_P;
+				return true;
+			}
+			return false;
+		}
+
+	private:
+		const char* m_P;
+		const char* m_End;
+	};
+
+	void Accumulate(OnnxProfileReport::Entry& entry, double us)
+	{
+		entry.minUs = entry.calls == 0 ? us : std::min<double>(entry.minUs, us);
+		entry.maxUs = std::max<double>(entry.maxUs, us);
+		entry.totalUs += us;
+		++entry.calls;
+	}
+
+	std::vector<OnnxProfileReport::Entry> SortedByTotal(std::unordered_map<std::string, OnnxProfileReport::Entry>& map)
+	{
+		std::vector<OnnxProfileReport::Entry> entries;
+		entries.reserve(map.size());
+		for (auto& it : map)
+		{
+			entries.push_back(std::move(it.second));
+		}
+		std::sort(entries.begin(), entries.end(), [](const OnnxProfileReport::Entry& a, const OnnxProfileReport::Entry& b) {
+			return a.totalUs != b.totalUs ? a.totalUs > b.totalUs : a.name < b.name;
+			});
+		return entries;
+	}
+
+	std::string CsvField(const std::string& s)
+	{
+		if (s.find_first_of(",\"\n") == std::string::npos)
+		{
+			return s;
+		}
+		std::string quoted = "\"";
+		for (char c : s)
+		{
+			quoted += c == '"' ? "\"\"" : std::string(1, c);
+		}
+		return quoted + "\"";
+	}
+
+	std::string JsonString(const std::string& s)
+	{
+		std::string out = "\"";
+		for (char c : s)
+		{
+			if (c == '"' || c == '\\')		out += '\\', out += c;
+			else if (c == '\n')				out += "\\n";
+			else if ((unsigned char)c < 0x20)	out += ' ';
+			else							out += c;
+		}
+		return out + "\"";
+	}
+
+	std::string ShapeText(const std::vector<int64_t>& shape, const char* separator)
+	{
+		std::string text;
+		for (size_t i = 0; i < shape.size(); ++i)
+		{
+			text += (i ? separator : "") + std::to_string(shape[i]);
+		}
+		return text;
+	}
+}
+
+bool OnnxProfileReport::Load(const std::string& tracePath, int runs)
+{
+	m_OpTypes.clear();
+	m_Nodes.clear();
+	m_Runs = 0;
+	m_RunTotalUs = 0.0;
+	m_KernelTotalUs = 0.0;
+	m_Error.clear();
+
+	std::ifstream file(tracePath, std::ios::binary);
+	if (!file)
+	{
+		m_Error = "cannot open " + tracePath;
+		return false;
+	}
+	const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	std::vector<Event> events;
+	if (TraceReader(text).ReadEvents(events) == false && events.empty())
+	{
+		m_Error = "not an ORT trace: " + tracePath;
+		return false;
+	}
+
+	// The window is the last `runs` Session::Run calls
+	std::vector<std::pair<double, double>> window;
+	for (const Event& e : events)
+	{
+		if (e.cat == "Session" && e.name == "model_run")
+		{
+			window.emplace_back(e.ts, e.ts + e.dur);
+		}
+	}
+	std::sort(window.begin(), window.end());
+	if (runs > 0 && window.size() > (size_t)runs)
+	{
+		window.erase(window.begin(), window.end() - runs);
+	}
+	if (window.empty())
+	{
+		m_Error = "no model_run events in " + tracePath;
+		return false;
+	}
+	m_Runs = (int)window.size();
+	for (const auto& run : window)
+	{
+		m_RunTotalUs += run.second - run.first;
+	}
+
+	const size_t suffixLen = std::char_traits<char>::length(kKernelSuffix);
+	std::unordered_map<std::string, Entry> opTypes;
+	std::unordered_map<std::string, Entry> nodes;
+	for (const Event& e : events)
+	{
+		if (e.cat != "Node" || e.name.size() <= suffixLen || e.name.compare(e.name.size() - suffixLen, suffixLen, kKernelSuffix) != 0)
+		{
+			continue;
+		}
+		auto run = std::upper_bound(window.begin(), window.end(), e.ts,
+			[](double ts, const std::pair<double, double>& r) { return ts < r.first; });
+		if (run == window.begin() || e.ts > std::prev(run)->second)
+		{
+			continue;
+		}
+
+		const std::string node = e.name.substr(0, e.name.size() - suffixLen);
+		const std::string opType = e.opName.empty() ? "?" : e.opName;
+
+		Entry& byNode = nodes[node];
+		if (byNode.calls == 0)
+		{
+			byNode.name = node;
+			byNode.opType = opType;
+			byNode.provider = e.provider;
+		}
+		Accumulate(byNode, e.dur);
+
+		Entry& byType = opTypes[opType + "|" + e.provider];
+		if (byType.calls == 0)
+		{
+			byType.name = opType;
+			byType.opType = opType;
+			byType.provider = e.provider;
+		}
+		Accumulate(byType, e.dur);
+		m_KernelTotalUs += e.dur;
+	}
+
+	m_OpTypes = SortedByTotal(opTypes);
+	m_Nodes = SortedByTotal(nodes);
+	return true;
+}
+
+bool OnnxProfileReport::WriteCsv(const std::string& path, const Info& info) const
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+
+	char line[256];
+	file << "# model," << CsvField(info.model) << ",ep," << CsvField(info.ep) << ",precision," << CsvField(info.precision)
+		<< ",input," << ShapeText(info.inputShape, "x") << '\n';
+	std::snprintf(line, sizeof(line), "# runs,%d,run_avg_ms,%.4f,kernel_ms_per_run,%.4f\n",
+		m_Runs, GetRunAvgUs() / 1000.0, m_Runs ? m_KernelTotalUs / m_Runs / 1000.0 : 0.0);
+	file << line;
+	file << "kind,name,op_type,provider,calls_per_run,avg_us,min_us,max_us,ms_per_run,percent\n";
+
+	auto writeRows = [&](const char* kind, const std::vector<Entry>& entries) {
+		for (const Entry& e : entries)
+		{
+			std::snprintf(line, sizeof(line), "%.2f,%.2f,%.2f,%.2f,%.4f,%.2f\n",
+				m_Runs ? (double)e.calls / m_Runs : 0.0, e.AvgUs(), e.minUs, e.maxUs,
+				m_Runs ? e.totalUs / m_Runs / 1000.0 : 0.0,
+				m_KernelTotalUs > 0.0 ? e.totalUs * 100.0 / m_KernelTotalUs : 0.0);
+			file << kind << ',' << CsvField(e.name) << ',' << CsvField(e.opType) << ',' << CsvField(e.provider) << ',' << line;
+		}
+		};
+	writeRows("op_type", m_OpTypes);
+	writeRows("node", m_Nodes);
+	return file.good();
+}
+
+bool OnnxProfileReport::WriteJson(const std::string& path, const Info& info) const
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+
+	char number[256];
+	file << "{\n";
+	file << "  \"model\": " << JsonString(info.model) << ",\n";
+	file << "  \"ep\": " << JsonString(info.ep) << ",\n";
+	file << "  \"precision\": " << JsonString(info.precision) << ",\n";
+	file << "  \"input\": [" << ShapeText(info.inputShape, ", ") << "],\n";
+	std::snprintf(number, sizeof(number), "  \"runs\": %d,\n  \"run_avg_ms\": %.4f,\n  \"kernel_ms_per_run\": %.4f,\n",
+		m_Runs, GetRunAvgUs() / 1000.0, m_Runs ? m_KernelTotalUs / m_Runs / 1000.0 : 0.0);
+	file << number;
+
+	auto writeArray = [&](const char* key, const std::vector<Entry>& entries, bool last) {
+		file << "  \"" << key << "\": [";
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			const Entry& e = entries[i];
+			std::snprintf(number, sizeof(number),
+				"\"calls_per_run\": %.2f, \"avg_us\": %.2f, \"min_us\": %.2f, \"max_us\": %.2f, \"ms_per_run\": %.4f, \"percent\": %.2f",
+				m_Runs ? (double)e.calls / m_Runs : 0.0, e.AvgUs(), e.minUs, e.maxUs,
+				m_Runs ? e.totalUs / m_Runs / 1000.0 : 0.0,
+				m_KernelTotalUs > 0.0 ? e.totalUs * 100.0 / m_KernelTotalUs : 0.0);
+			file << (i ? ",\n" : "\n") << "    { \"name\": " << JsonString(e.name) << ", \"op_type\": " << JsonString(e.opType)
+				<< ", \"provider\": " << JsonString(e.provider) << ", " << number << " }";
+		}
+		file << (entries.empty() ? "]" : "\n  ]") << (last ? "\n" : ",\n");
+		};
+	writeArray("op_types", m_OpTypes, false);
+	writeArray("nodes", m_Nodes, true);
+	file << "}\n";
+	return file.good();
+}
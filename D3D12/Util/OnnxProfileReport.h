@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//===================================================================//
+// Per-operator summary of an ORT profiling trace
+// (SessionOptions::EnableProfiling + Session::EndProfilingAllocated;
+//  portable, std only: also used by the headless tools)
+// Only "<node>_kernel_time" events inside the last `runs` model_run
+// events are counted, so warm-up Runs (shape discovery, DML graph
+// compilation) before the window drop out. Times are what ORT records
+// on the calling thread: on the CPU EP the kernel itself, on DML the
+// CPU cost of recording the node (GPU execution is not in the trace).
+//===================================================================//
+class OnnxProfileReport
+{
+public:
+	struct Entry
+	{
+		std::string name;			// node name, or op type for the op-type table
+		std::string opType;
+		std::string provider;
+		uint64_t calls = 0;
+		double totalUs = 0.0;
+		double minUs = 0.0;
+		double maxUs = 0.0;
+
+		double AvgUs() const { return calls ? totalUs / (double)calls : 0.0; }
+	};
+
+	// Header fields written with the tables
+	struct Info
+	{
+		std::string model;
+		std::string ep;
+		std::string precision;
+		std::vector<int64_t> inputShape;
+	};
+
+	bool Load(const std::string& tracePath, int runs);
+	bool WriteCsv(const std::string& path, const Info& info) const;
+	bool WriteJson(const std::string& path, const Info& info) const;
+
+	//===========Getter=================//
+	const std::vector<Entry>& GetOpTypes() const	{ return m_OpTypes; }	// sorted by total time, descending
+	const std::vector<Entry>& GetNodes() const		{ return m_Nodes; }
+	int GetRuns() const								{ return m_Runs; }
+	double GetRunAvgUs() const						{ return m_Runs ? m_RunTotalUs / m_Runs : 0.0; }
+	double GetKernelTotalUs() const					{ return m_KernelTotalUs; }
+	const std::string& GetError() const				{ return m_Error; }
+	//==================================//
+
+private:
+	std::vector<Entry> m_OpTypes;
+	std::vector<Entry> m_Nodes;
+	int m_Runs = 0;
+	double m_RunTotalUs = 0.0;
+	double m_KernelTotalUs = 0.0;
+	std::string m_Error;
+};
@@ -0,0 +1,86 @@
+#include "ResolutionController.h"
+
+#include <algorithm>
+#include <cmath>
+
+void ResolutionController::Reset(const Config& config)
+{
+	m_Config = config;
+	m_Config.maxScale = std::clamp<double>(m_Config.maxScale, 0.01, 1.0);
+	m_Config.minScale = std::clamp<double>(m_Config.minScale, 0.01, m_Config.maxScale);
+	m_Config.upThreshold = std::min<double>(m_Config.upThreshold, m_Config.downThreshold);
+	m_Config.averageWeight = std::clamp<double>(m_Config.averageWeight, 0.001, 1.0);
+
+	m_Scale = m_Config.maxScale;
+	m_AvgMs = 0.0;
+	m_Samples = 0;
+	m_OverStreak = 0;
+	m_UnderStreak = 0;
+	m_Settle = m_Config.settleFrames;
+	m_Changes = 0;
+}
+
+bool ResolutionController::AddSample(double runMs)
+{
+	if (IsEnabled() == false || runMs <= 0.0)
+	{
+		return false;
+	}
+	if (m_Settle > 0)
+	{
+		--m_Settle;
+		return false;
+	}
+
+	m_AvgMs = m_Samples++ == 0 ? runMs : m_AvgMs + (runMs - m_AvgMs) * m_Config.averageWeight;
+
+	const double budget = m_Config.budgetMs;
+	m_OverStreak = m_AvgMs > budget * m_Config.downThreshold ? m_OverStreak + 1 : 0;
+	m_UnderStreak = m_AvgMs < budget * m_Config.upThreshold ? m_UnderStreak + 1 : 0;
+
+	// Over budget costs frames right away: shrink quickly. Growing can wait
+	if (m_OverStreak >= m_Config.downFrames && m_Scale > m_Config.minScale)
+	{
+		return ApplyScale(GetFitScale());
+	}
+	if (m_UnderStreak >= m_Config.upFrames && m_Scale < m_Config.maxScale)
+	{
+		return ApplyScale(GetFitScale());
+	}
+	return false;
+}
+
+double ResolutionController::Predict(double scale) const
+{
+	return m_Scale > 0.0 ? m_AvgMs * (scale * scale) / (m_Scale * m_Scale) : m_AvgMs;
+}
+
+double ResolutionController::GetFitScale() const
+{
+	if (m_AvgMs <= 0.0)
+	{
+		return m_Scale;
+	}
+	const double fit = m_Scale * std::sqrt(m_Config.budgetMs * m_Config.headroom / m_AvgMs);
+	return std::clamp<double>(fit, m_Config.minScale, m_Config.maxScale);
+}
+
+bool ResolutionController::ApplyScale(double scale)
+{
+	m_OverStreak = 0;
+	m_UnderStreak = 0;
+
+	// Small moves only reallocate; the clamped ends are always reachable
+	const bool atLimit = scale == m_Config.minScale || scale == m_Config.maxScale;
+	if (std::fabs(scale - m_Scale) < m_Config.minStep && (atLimit == false || scale == m_Scale))
+	{
+		return false;
+	}
+
+	// The prediction stands in for the average until the new size has been measured
+	m_AvgMs = Predict(scale);
+	m_Scale = scale;
+	m_Settle = m_Config.settleFrames;
+	++m_Changes;
+	return true;
+}
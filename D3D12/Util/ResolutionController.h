@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+
+//===================================================================//
+// Dynamic inference resolution (portable, std only)
+//  AddSample(run ms) once per frame -> true when GetScale() changed
+// The scale applies to both axes of the full (backbuffer) size; inference cost
+// is taken to follow the pixel count, so a measured time predicts the others.
+//
+// Hysteresis: shrink once the average stays over budget * downThreshold,
+// grow once it stays under budget * upThreshold; either way the new scale aims
+// at budget * headroom. Changes smaller than minStep are not worth a reallocation.
+//===================================================================//
+class ResolutionController
+{
+public:
+	struct Config
+	{
+		double budgetMs = 0.0;			// 0: disabled, scale stays at maxScale
+		double minScale = 0.5;
+		double maxScale = 1.0;
+		double headroom = 0.85;			// share of the budget a new scale is sized for
+		double downThreshold = 1.0;
+		double upThreshold = 0.7;
+		double minStep = 0.05;
+		uint32_t downFrames = 5;		// over budget this many samples in a row before shrinking
+		uint32_t upFrames = 60;			// under the up threshold this long before growing
+		uint32_t settleFrames = 10;		// samples skipped after a change (allocation, first runs)
+		double averageWeight = 0.1;		// EMA weight of the newest sample
+	};
+
+	void Reset(const Config& config);
+
+	// Returns true if the scale changed; the caller reallocates at the new size
+	bool AddSample(double runMs);
+
+	inline bool IsEnabled() const				{ return m_Config.budgetMs > 0.0; }
+	inline double GetScale() const				{ return m_Scale; }
+	inline double GetAverageMs() const			{ return m_AvgMs; }
+	inline uint64_t GetChangeCount() const		{ return m_Changes; }
+	inline const Config& GetConfig() const		{ return m_Config; }
+
+	// Predicted run time at scale, from the current average
+	double Predict(double scale) const;
+
+private:
+	// Scale whose predicted time is budget * headroom
+	double GetFitScale() const;
+	bool ApplyScale(double scale);
+
+private:
+	Config m_Config{};
+
+	double m_Scale = 1.0;
+	double m_AvgMs = 0.0;
+	uint64_t m_Samples = 0;
+
+	uint32_t m_OverStreak = 0;
+	uint32_t m_UnderStreak = 0;
+	uint32_t m_Settle = 0;
+	uint64_t m_Changes = 0;
+};
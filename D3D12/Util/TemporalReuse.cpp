@@ -0,0 +1,68 @@
+#include "TemporalReuse.h"
+
+#include <algorithm>
+#include <cmath>
+
+void TemporalReuse::Reset(const Config& config)
+{
+	m_Config = config;
+	m_Config.maxMove = std::max<double>(m_Config.maxMove, 0.0);
+	m_Config.maxTurnDeg = std::max<double>(m_Config.maxTurnDeg, 0.0);
+
+	m_HasKey = false;
+	m_Keyframe = true;
+	m_SinceKey = 0;
+	m_Inferred = 0;
+	m_Reused = 0;
+	m_MotionKeys = 0;
+}
+
+bool TemporalReuse::ShouldInfer(const float pos[3], const float dir[3])
+{
+	const bool motion = m_HasKey && IsMotionOver(pos, dir);
+	m_Keyframe = IsEnabled() == false || m_HasKey == false || m_SinceKey + 1 >= m_Config.interval || motion;
+
+	if (m_Keyframe == false)
+	{
+		++m_SinceKey;
+		++m_Reused;
+		return false;
+	}
+
+	if (motion && m_SinceKey + 1 < m_Config.interval)
+	{
+		++m_MotionKeys;
+	}
+	std::copy(pos, pos + 3, m_KeyPos);
+	std::copy(dir, dir + 3, m_KeyDir);
+	m_HasKey = true;
+	m_SinceKey = 0;
+	++m_Inferred;
+	return true;
+}
+
+bool TemporalReuse::IsMotionOver(const float pos[3], const float dir[3]) const
+{
+	if (m_Config.maxMove > 0.0)
+	{
+		const double dx = pos[0] - m_KeyPos[0];
+		const double dy = pos[1] - m_KeyPos[1];
+		const double dz = pos[2] - m_KeyPos[2];
+		if (dx * dx + dy * dy + dz * dz > m_Config.maxMove * m_Config.maxMove)
+		{
+			return true;
+		}
+	}
+
+	if (m_Config.maxTurnDeg > 0.0)
+	{
+		// Directions are unit length; compare cosines instead of taking acos
+		const double dot = (double)dir[0] * m_KeyDir[0] + (double)dir[1] * m_KeyDir[1] + (double)dir[2] * m_KeyDir[2];
+		const double limit = std::cos(m_Config.maxTurnDeg * 3.14159265358979323846 / 180.0);
+		if (dot < limit)
+		{
+			return true;
+		}
+	}
+	return false;
+}
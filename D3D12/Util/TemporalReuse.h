@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+//===================================================================//
+// Temporal reuse of the stylized output (portable, std only)
+//  ShouldInfer(camera) once per frame -> true: run the network (keyframe),
+//  false: reproject the last keyframe's output instead
+// A keyframe is forced every `interval` frames and whenever the camera has
+// moved or turned past the thresholds since the last keyframe, so both the
+// reprojection error and the style flicker between keyframes stay bounded.
+//===================================================================//
+class TemporalReuse
+{
+public:
+	struct Config
+	{
+		uint32_t interval = 1;			// <= 1: disabled, every frame is a keyframe
+		double maxMove = 0.5;			// world units since the keyframe (0: no limit)
+		double maxTurnDeg = 6.0;		// view direction change since the keyframe (0: no limit)
+	};
+
+	void Reset(const Config& config);
+
+	// History is gone (resize, runner switch): the next frame is a keyframe
+	void Invalidate()							{ m_HasKey = false; }
+
+	// pos/dir: camera position and view direction of this frame
+	bool ShouldInfer(const float pos[3], const float dir[3]);
+
+	inline bool IsEnabled() const				{ return m_Config.interval > 1; }
+	inline bool IsKeyframe() const				{ return m_Keyframe; }
+	inline uint32_t GetFramesSinceKey() const	{ return m_SinceKey; }
+	inline uint64_t GetInferredCount() const	{ return m_Inferred; }
+	inline uint64_t GetReusedCount() const		{ return m_Reused; }
+	inline uint64_t GetMotionKeyCount() const	{ return m_MotionKeys; }
+	inline const Config& GetConfig() const		{ return m_Config; }
+
+private:
+	bool IsMotionOver(const float pos[3], const float dir[3]) const;
+
+private:
+	Config m_Config{};
+
+	bool m_HasKey = false;
+	bool m_Keyframe = true;
+	float m_KeyPos[3] = { 0.0f, 0.0f, 0.0f };
+	float m_KeyDir[3] = { 0.0f, 0.0f, 1.0f };
+	uint32_t m_SinceKey = 0;
+
+	uint64_t m_Inferred = 0;
+	uint64_t m_Reused = 0;
+	uint64_t m_MotionKeys = 0;		// keyframes forced by the camera rather than the interval
+};
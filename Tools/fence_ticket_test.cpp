@@ -0,0 +1,149 @@
+// GPU-free test for FenceTicket / DeferredReleaseQueue (D3D/FenceTicket.h).
+//
+// Drives the queue with fake completed-fence values the way DXContext does per
+// frame: tickets are the values signaled after each submission, Retire gets
+// ID3D12Fence::GetCompletedValue. Exits non-zero if any check fails.
+//
+//     g++ -std=c++17 -O2 -I D3D12 Tools/fence_ticket_test.cpp -o fence_ticket_test && ./fence_ticket_test
+
+#include "D3D/FenceTicket.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	void TestTicket()
+	{
+		std::printf("ticket\n");
+		FenceTicket none;
+		CHECK(none.IsValid() == false);
+		CHECK(none.IsCompleteAt(0));			// an invalid ticket never blocks
+
+		FenceTicket t{ 5 };
+		CHECK(t.IsValid());
+		CHECK(t.IsCompleteAt(4) == false);
+		CHECK(t.IsCompleteAt(5));
+		CHECK(t.IsCompleteAt(6));
+	}
+
+	void TestRetireOrder()
+	{
+		std::printf("retire order\n");
+		DeferredReleaseQueue queue;
+		std::vector<int> ran;
+		for (int i = 1; i <= 5; ++i)
+		{
+			queue.Enqueue(FenceTicket{ (uint64_t)i * 10 }, [&ran, i]() { ran.push_back(i); });
+		}
+		CHECK(queue.GetPendingCount() == 5);
+
+		CHECK(queue.Retire(0) == 0);
+		CHECK(queue.Retire(9) == 0);
+		CHECK(ran.empty());
+
+		CHECK(queue.Retire(10) == 1);			// inclusive
+		CHECK(queue.Retire(35) == 2);
+		CHECK((ran == std::vector<int>{ 1, 2, 3 }));
+		CHECK(queue.Retire(35) == 0);			// same completed value twice
+		CHECK(queue.GetPendingCount() == 2);
+		CHECK(queue.GetRetiredCount() == 3);
+
+		CHECK(queue.RetireAll() == 2);
+		CHECK((ran == std::vector<int>{ 1, 2, 3, 4, 5 }));
+		CHECK(queue.GetPendingCount() == 0);
+		CHECK(queue.GetRetiredCount() == 5);
+	}
+
+	void TestOutOfOrder()
+	{
+		std::printf("out-of-order enqueue\n");
+		// An older ticket behind a newer one runs no earlier than the newer one
+		DeferredReleaseQueue queue;
+		std::string ran;
+		queue.Enqueue(FenceTicket{ 20 }, [&ran]() { ran += 'a'; });
+		queue.Enqueue(FenceTicket{ 10 }, [&ran]() { ran += 'b'; });
+		queue.Enqueue(FenceTicket{ 30 }, [&ran]() { ran += 'c'; });
+
+		CHECK(queue.Retire(15) == 0);
+		CHECK(ran.empty());
+		CHECK(queue.Retire(20) == 2);
+		CHECK(ran == "ab");
+		CHECK(queue.Retire(30) == 1);
+		CHECK(ran == "abc");
+	}
+
+	void TestReentrantEnqueue()
+	{
+		std::printf("enqueue from a callback\n");
+		// A callback may queue follow-up work; it runs in the same Retire if already complete
+		DeferredReleaseQueue queue;
+		std::string ran;
+		queue.Enqueue(FenceTicket{ 1 }, [&]() {
+			ran += '1';
+			queue.Enqueue(FenceTicket{ 2 }, [&ran]() { ran += '2'; });
+			queue.Enqueue(FenceTicket{ 9 }, [&ran]() { ran += '9'; });
+			});
+
+		CHECK(queue.Retire(5) == 2);
+		CHECK(ran == "12");
+		CHECK(queue.GetPendingCount() == 1);
+		CHECK(queue.Retire(9) == 1);
+		CHECK(ran == "129");
+	}
+
+	void TestEmptyCallbackAndClear()
+	{
+		std::printf("empty callback, clear\n");
+		DeferredReleaseQueue queue;
+		queue.Enqueue(FenceTicket{ 1 }, nullptr);
+		CHECK(queue.Retire(1) == 1);			// counted, nothing to call
+
+		int ran = 0;
+		queue.Enqueue(FenceTicket{ 2 }, [&ran]() { ++ran; });
+		queue.Clear();
+		CHECK(queue.GetPendingCount() == 0);
+		CHECK(queue.RetireAll() == 0);
+		CHECK(ran == 0);
+	}
+
+	void TestFramesInFlight()
+	{
+		std::printf("frames in flight\n");
+		// Three frames in flight: each frame's releases retire once the GPU is two frames behind
+		constexpr uint64_t kFramesInFlight = 3;
+		DeferredReleaseQueue queue;
+		uint64_t nextValue = 1;
+		std::vector<uint64_t> released;
+		for (uint64_t frame = 0; frame < 10; ++frame)
+		{
+			const FenceTicket ticket{ nextValue++ };
+			queue.Enqueue(ticket, [&released, frame]() { released.push_back(frame); });
+
+			const uint64_t completed = ticket.value > kFramesInFlight - 1 ? ticket.value - (kFramesInFlight - 1) : 0;
+			queue.Retire(completed);
+			CHECK(queue.GetPendingCount() <= kFramesInFlight - 1);
+		}
+		CHECK(released.size() == 8);
+		for (size_t i = 0; i < released.size(); ++i)
+		{
+			CHECK(released[i] == i);
+		}
+		queue.RetireAll();
+		CHECK(released.size() == 10);
+	}
+}
+
+int main()
+{
+	TestTicket();
+	TestRetireOrder();
+	TestOutOfOrder();
+	TestReentrantEnqueue();
+	TestEmptyCallbackAndClear();
+	TestFramesInFlight();
+
+	return TestCheck::Finish();
+}
@@ -0,0 +1,325 @@
+// Deterministic test for the frame pacing policy (D3D12/Util/FramePacer.{h,cpp}).
+//
+// FramePacer never reads a clock itself, so this drives it with synthetic CPU
+// stage times and GPU frame times on a simulated timeline and checks the
+// queued-frame decisions (hysteresis, immediate deepening, jitter, clamping)
+// and the next-start cadence. Exits non-zero on a failed check.
+//
+//     g++ -std=c++17 -O2 -I D3D12 Tools/frame_pacer_test.cpp D3D12/Util/FramePacer.cpp -o frame_pacer_test && ./frame_pacer_test
+
+#include "Util/FramePacer.h"
+#include "test_check.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+	bool Near(double a, double b, double eps = 1e-9)
+	{
+		return std::fabs(a - b) <= eps;
+	}
+
+	// Simulated frame loop: the CPU work is split over the busy stages,
+	// the frame ends busyMs after it starts and the next one starts on the pacer's cadence
+	struct Sim
+	{
+		FramePacer pacer;
+		double nowMs = 1000.0;
+
+		explicit Sim(const FramePacer::Config& config) { pacer.Reset(config); }
+
+		void Frame(double busyMs, double gpuMs)
+		{
+			pacer.BeginFrame(nowMs);
+			pacer.AddStage(FrameStage::Render, busyMs * 0.5);
+			pacer.AddStage(FrameStage::Preprocess, busyMs * 0.1);
+			pacer.AddStage(FrameStage::Inference, busyMs * 0.3);
+			pacer.AddStage(FrameStage::Postprocess, busyMs * 0.1);
+			pacer.SetGpuFrameMs(gpuMs);
+			nowMs += busyMs;
+			pacer.EndFrame(nowMs);
+			if (pacer.GetNextStartMs() > nowMs)
+			{
+				nowMs = pacer.GetNextStartMs();
+			}
+		}
+
+		// Frames until the queue depth changes (or limit frames)
+		int FramesUntilSwitch(double busyMs, double gpuMs, int limit)
+		{
+			const uint32_t depth = pacer.GetQueuedFrames();
+			for (int i = 1; i <= limit; ++i)
+			{
+				Frame(busyMs, gpuMs);
+				if (pacer.GetQueuedFrames() != depth)
+				{
+					return i;
+				}
+			}
+			return -1;
+		}
+	};
+
+	FramePacer::Config DefaultConfig()
+	{
+		FramePacer::Config config;
+		config.targetFrameMs = 16.0;	// budget = 16 * 0.9 = 14.4 ms
+		config.minQueuedFrames = 1;
+		config.maxQueuedFrames = 2;
+		config.vsync = true;
+		config.startMarginMs = 1.0;
+		config.headroom = 0.9;
+		config.switchFrames = 30;
+		config.averageWeight = 0.1;
+		return config;
+	}
+
+	void TestConfigSanitize()
+	{
+		std::printf("config sanitize\n");
+		FramePacer pacer;
+		FramePacer::Config config;
+		config.minQueuedFrames = 0;
+		config.maxQueuedFrames = 0;
+		config.targetFrameMs = -5.0;
+		config.averageWeight = 7.0;
+		pacer.Reset(config);
+		CHECK(pacer.GetConfig().minQueuedFrames == 1);
+		CHECK(pacer.GetConfig().maxQueuedFrames == 1);
+		CHECK(pacer.GetConfig().targetFrameMs == 0.0);
+		CHECK(pacer.GetConfig().averageWeight == 1.0);
+		CHECK(pacer.GetQueuedFrames() == 1);
+
+		config = DefaultConfig();
+		config.minQueuedFrames = 3;
+		config.maxQueuedFrames = 2;
+		pacer.Reset(config);
+		CHECK(pacer.GetConfig().maxQueuedFrames == 3);
+		CHECK(pacer.GetSyncInterval() == 1);
+	}
+
+	void TestStagesAndDelta()
+	{
+		std::printf("stage accumulation, frame delta\n");
+		FramePacer pacer;
+		pacer.Reset(DefaultConfig());
+
+		CHECK(pacer.BeginFrame(100.0) == 0.0);			// first frame has no delta
+		pacer.AddStage(FrameStage::Render, 2.0);
+		pacer.AddStage(FrameStage::Render, 1.5);		// reported twice: adds up
+		pacer.AddStage(FrameStage::Inference, -1.0);	// ignored
+		pacer.AddStage(FrameStage::Count, 9.0);			// ignored
+		pacer.EndFrame(104.0);
+		CHECK(Near(pacer.GetStage(FrameStage::Render).lastMs, 3.5));
+		CHECK(pacer.GetStage(FrameStage::Inference).lastMs == 0.0);
+		CHECK(pacer.GetFrameNumber() == 1);
+
+		CHECK(Near(pacer.BeginFrame(116.0), 0.016));
+		pacer.AddStage(FrameStage::Render, 5.5);
+		pacer.EndFrame(122.0);
+		// EMA with weight 0.1 from the first sample
+		CHECK(Near(pacer.GetStage(FrameStage::Render).avgMs, 3.5 + (5.5 - 3.5) * 0.1));
+		CHECK(Near(pacer.GetStage(FrameStage::Render).devMs, 2.0 * 0.1));
+		CHECK(Near(pacer.GetFrame().lastMs, 16.0));
+		CHECK(Near(pacer.GetBusyMs(), pacer.GetStage(FrameStage::Render).avgMs));
+	}
+
+	void TestStartsDeep()
+	{
+		std::printf("starts at max depth, no decision before two frames\n");
+		Sim sim(DefaultConfig());
+		CHECK(sim.pacer.GetQueuedFrames() == 2);
+		sim.Frame(1.0, 1.0);
+		CHECK(sim.pacer.GetQueuedFrames() == 2);
+		CHECK(sim.pacer.GetDepthSwitchCount() == 0);
+	}
+
+	void TestShallowAfterHysteresis()
+	{
+		std::printf("fast frames go to 1 queued frame after switchFrames\n");
+		Sim sim(DefaultConfig());
+		// busy 4 + gpu 4 = 8 <= 14.4
+		sim.Frame(4.0, 4.0);
+		CHECK(sim.pacer.GetNeededQueuedFrames() == 1);
+		const int frames = sim.FramesUntilSwitch(4.0, 4.0, 100);
+		// Decisions start at frame 2: 30 frames of asking, the first of which is frame 2
+		CHECK(frames == 30);
+		CHECK(sim.pacer.GetQueuedFrames() == 1);
+		CHECK(sim.pacer.GetDepthSwitchCount() == 1);
+
+		// Stays there
+		CHECK(sim.FramesUntilSwitch(4.0, 4.0, 100) == -1);
+	}
+
+	void TestDeepenImmediately()
+	{
+		std::printf("GPU-bound frame deepens at once\n");
+		Sim sim(DefaultConfig());
+		for (int i = 0; i < 40; ++i)
+		{
+			sim.Frame(4.0, 4.0);
+		}
+		CHECK(sim.pacer.GetQueuedFrames() == 1);
+
+		// busy 4 + gpu 12 = 16 > 14.4, max(4, 12) = 12 <= 14.4 -> 2, no hysteresis
+		CHECK(sim.FramesUntilSwitch(4.0, 12.0, 10) == 1);
+		CHECK(sim.pacer.GetQueuedFrames() == 2);
+	}
+
+	void TestInterruptedStreak()
+	{
+		std::printf("a frame that wants the current depth resets the streak\n");
+		Sim sim(DefaultConfig());
+		sim.Frame(4.0, 4.0);
+		for (int i = 0; i < 29; ++i)
+		{
+			sim.Frame(4.0, 4.0);
+		}
+		CHECK(sim.pacer.GetQueuedFrames() == 2);
+		sim.Frame(4.0, 12.0);	// wants 2 == current: streak restarts
+		CHECK(sim.pacer.GetQueuedFrames() == 2);
+		CHECK(sim.FramesUntilSwitch(4.0, 4.0, 100) == 30);
+	}
+
+	void TestClampToMax()
+	{
+		std::printf("over budget on both sides asks for 3, clamped to max\n");
+		Sim sim(DefaultConfig());
+		for (int i = 0; i < 5; ++i)
+		{
+			sim.Frame(15.0, 15.0);
+		}
+		CHECK(sim.pacer.GetNeededQueuedFrames() == 2);
+		CHECK(sim.pacer.GetQueuedFrames() == 2);
+
+		FramePacer::Config config = DefaultConfig();
+		config.maxQueuedFrames = 3;
+		Sim deep(config);
+		CHECK(deep.pacer.GetQueuedFrames() == 3);
+		for (int i = 0; i < 5; ++i)
+		{
+			deep.Frame(15.0, 15.0);
+		}
+		CHECK(deep.pacer.GetNeededQueuedFrames() == 3);
+		CHECK(deep.pacer.GetQueuedFrames() == 3);
+
+		config.minQueuedFrames = 2;
+		Sim floor(config);
+		for (int i = 0; i < 100; ++i)
+		{
+			floor.Frame(1.0, 1.0);
+		}
+		CHECK(floor.pacer.GetQueuedFrames() == 2);
+	}
+
+	void TestJitter()
+	{
+		std::printf("jittery CPU keeps the deeper queue\n");
+		// Same 6 ms average either way; only the alternating one carries jitter
+		Sim steady(DefaultConfig());
+		Sim jittery(DefaultConfig());
+		for (int i = 0; i < 200; ++i)
+		{
+			steady.Frame(6.0, 3.0);
+			jittery.Frame((i & 1) ? 10.0 : 2.0, 3.0);
+		}
+		CHECK(steady.pacer.GetQueuedFrames() == 1);
+		CHECK(jittery.pacer.GetJitterMs() > 3.0);
+		// 6 + 3 + 2 * jitter > 14.4, max(6, 3) + 2 * jitter <= 14.4
+		CHECK(jittery.pacer.GetNeededQueuedFrames() == 2);
+		CHECK(jittery.pacer.GetQueuedFrames() == 2);
+	}
+
+	void TestNoCadence()
+	{
+		std::printf("no target: max depth, start immediately\n");
+		FramePacer::Config config = DefaultConfig();
+		config.targetFrameMs = 0.0;
+		Sim sim(config);
+		for (int i = 0; i < 50; ++i)
+		{
+			sim.Frame(1.0, 1.0);
+			CHECK(Near(sim.pacer.GetNextStartMs(), sim.nowMs));
+		}
+		CHECK(sim.pacer.GetQueuedFrames() == 2);
+	}
+
+	void TestCadence()
+	{
+		std::printf("next start cadence\n");
+		FramePacer::Config config = DefaultConfig();
+		FramePacer pacer;
+		pacer.Reset(config);
+
+		// vsync: previous start + target - margin
+		pacer.BeginFrame(100.0);
+		pacer.EndFrame(105.0);
+		CHECK(Near(pacer.GetNextStartMs(), 115.0));
+
+		// Late but within a frame: keep the cadence (start at once, no sleep)
+		pacer.BeginFrame(115.0);
+		pacer.EndFrame(140.0);
+		CHECK(Near(pacer.GetNextStartMs(), 130.0));
+
+		// More than a frame late: restart from now
+		pacer.BeginFrame(140.0);
+		pacer.EndFrame(200.0);
+		CHECK(Near(pacer.GetNextStartMs(), 200.0));
+
+		config.vsync = false;
+		pacer.Reset(config);
+		CHECK(pacer.GetSyncInterval() == 0);
+		pacer.BeginFrame(100.0);
+		pacer.EndFrame(103.0);
+		CHECK(Near(pacer.GetNextStartMs(), 116.0));
+
+		// Margin larger than the target is capped at the target
+		config.vsync = true;
+		config.startMarginMs = 50.0;
+		pacer.Reset(config);
+		pacer.BeginFrame(100.0);
+		pacer.EndFrame(103.0);
+		CHECK(Near(pacer.GetNextStartMs(), 100.0));
+	}
+
+	void TestSimulatedRate()
+	{
+		std::printf("simulated timeline holds the target rate\n");
+		FramePacer::Config config = DefaultConfig();
+		config.vsync = false;
+		Sim sim(config);
+		for (int i = 0; i < 120; ++i)
+		{
+			sim.Frame(5.0, 5.0);
+		}
+		CHECK(Near(sim.pacer.GetFrame().lastMs, 16.0));
+		CHECK(Near(sim.pacer.GetFrame().avgMs, 16.0));
+
+		// With vsync the start runs margin early; in the app Present's vblank wait takes that back
+		config.vsync = true;
+		Sim vsync(config);
+		for (int i = 0; i < 120; ++i)
+		{
+			vsync.Frame(5.0, 5.0);
+		}
+		CHECK(Near(vsync.pacer.GetFrame().lastMs, 15.0));
+	}
+}
+
+int main()
+{
+	TestConfigSanitize();
+	TestStagesAndDelta();
+	TestStartsDeep();
+	TestShallowAfterHysteresis();
+	TestDeepenImmediately();
+	TestInterruptedStreak();
+	TestClampToMax();
+	TestJitter();
+	TestNoCadence();
+	TestCadence();
+	TestSimulatedRate();
+
+	return TestCheck::Finish();
+}
@@ -0,0 +1,216 @@
+// GPU-free test for FrameResourceRing / FrameLinearAllocator (D3D/FrameResourceRing.h).
+//
+// Drives the ring with a fake fence the way DXContext::BeginFrame/EndFrame do:
+// Acquire(fence) -> rewind the slot's upload cursor -> allocate constants ->
+// Retire(signaled value). The fake fence records every wait and completes up to
+// the waited value, like the GPU catching up. Exits non-zero if any check fails.
+//
+//     g++ -std=c++17 -O2 -I D3D12 Tools/frame_resource_ring_test.cpp -o frame_resource_ring_test && ./frame_resource_ring_test
+
+#include "D3D/FrameResourceRing.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	struct FakeFence
+	{
+		uint64_t completed = 0;
+		uint64_t signaled = 0;
+		std::vector<uint64_t> waits;
+
+		uint64_t Signal()							{ return ++signaled; }
+		uint64_t GetCompletedValue() const			{ return completed; }
+		void WaitForValue(uint64_t value)
+		{
+			waits.push_back(value);
+			if (completed < value)
+			{
+				completed = value;
+			}
+		}
+	};
+
+	struct FakeFrame
+	{
+		int id = -1;
+		FrameLinearAllocator uploadCursor;
+	};
+
+	constexpr uint64_t kAlign = 256;
+
+	void TestLinearAllocator()
+	{
+		std::printf("linear allocator\n");
+		FrameLinearAllocator alloc;
+		alloc.Reset(1024);
+		CHECK(alloc.GetCapacity() == 1024);
+
+		CHECK(alloc.Allocate(10, kAlign) == 0);
+		CHECK(alloc.GetUsed() == 10);
+		CHECK(alloc.Allocate(4, kAlign) == 256);		// aligned up
+		CHECK(alloc.Allocate(1, 1) == 260);			// align 1 packs
+		CHECK(alloc.Allocate(8, 16) == 272);
+
+		// Overflow fails and leaves the cursor where it was
+		CHECK(alloc.Allocate(1024, kAlign) == FrameLinearAllocator::InvalidOffset);
+		CHECK(alloc.GetUsed() == 280);
+		CHECK(alloc.Allocate(512, kAlign) == 512);	// exactly fills
+		CHECK(alloc.GetUsed() == 1024);
+		CHECK(alloc.Allocate(1, 1) == FrameLinearAllocator::InvalidOffset);
+		// Aligned begin past the end fails even for size 0
+		alloc.Reset(300);
+		alloc.Allocate(260, 1);
+		CHECK(alloc.Allocate(0, kAlign) == FrameLinearAllocator::InvalidOffset);
+
+		FrameLinearAllocator fresh;
+		fresh.Reset(1024);
+		fresh.Allocate(700, kAlign);
+		fresh.Rewind();
+		CHECK(fresh.GetUsed() == 0);
+		CHECK(fresh.Allocate(100, kAlign) == 0);
+		CHECK(fresh.GetHighWater() == 700);			// survives Rewind
+	}
+
+	void TestAcquireWaits()
+	{
+		std::printf("acquire waits for the slot's retire value\n");
+		FrameResourceRing<FakeFrame> ring;
+		ring.Resize(3);
+		FakeFence fence;
+
+		// First pass: no slot has been submitted, nothing to wait for
+		for (int i = 0; i < 3; ++i)
+		{
+			CHECK(ring.GetIndex() == (size_t)i);
+			ring.Acquire(fence).id = i;
+			ring.Retire(fence.Signal());
+		}
+		CHECK(fence.waits.empty());
+		CHECK(ring.GetIndex() == 0);					// wrapped
+		CHECK(ring.GetFrameNumber() == 3);
+
+		// GPU finished frame 0 (value 1): slot 0 is free without waiting
+		fence.completed = 1;
+		FakeFrame& slot0 = ring.Acquire(fence);
+		CHECK(slot0.id == 0);
+		CHECK(fence.waits.empty());
+		CHECK(ring.GetStallCount() == 0);
+		ring.Retire(fence.Signal());					// value 4
+
+		// GPU still on value 1: slot 1 (tagged 2) must wait for exactly 2
+		FakeFrame& slot1 = ring.Acquire(fence);
+		CHECK(slot1.id == 1);
+		CHECK((fence.waits == std::vector<uint64_t>{ 2 }));
+		CHECK(fence.completed >= 2);
+		CHECK(ring.GetStallCount() == 1);
+		ring.Retire(fence.Signal());					// value 5
+
+		// Completed past the tag: no wait
+		fence.completed = 3;
+		ring.Acquire(fence);
+		CHECK(fence.waits.size() == 1);
+		ring.Retire(fence.Signal());					// value 6
+		CHECK(ring.GetStallCount() == 1);
+	}
+
+	void TestRetireTagsAndWrap()
+	{
+		std::printf("retire tags the current slot, wraps across FrameCount\n");
+		constexpr size_t kFrames = 3;
+		FrameResourceRing<FakeFrame> ring;
+		ring.Resize(kFrames);
+		FakeFence fence;
+		std::vector<uint64_t> tags(kFrames, 0);
+
+		// Fake GPU a full ring behind the CPU: every acquire of a used slot waits on its own tag
+		for (int frame = 0; frame < 12; ++frame)
+		{
+			const size_t index = ring.GetIndex();
+			CHECK(index == (size_t)frame % kFrames);
+
+			const size_t waitsBefore = fence.waits.size();
+			FakeFrame& res = ring.Acquire(fence);
+			// Never hands out a slot before its tag has completed
+			CHECK(tags[index] == 0 || fence.completed >= tags[index]);
+			if (fence.waits.size() > waitsBefore)
+			{
+				CHECK(fence.waits.back() == tags[index]);
+			}
+			res.id = frame;
+
+			const uint64_t value = fence.Signal();
+			ring.Retire(value);
+			tags[index] = value;
+			fence.completed = value > kFrames ? value - kFrames : 0;
+		}
+		CHECK(fence.waits.size() == 12 - kFrames);
+		CHECK(ring.GetStallCount() == 12 - kFrames);
+		CHECK(ring.GetFrameNumber() == 12);
+		CHECK(ring.GetIndex() == 0);
+
+		// Each slot holds the last frame recorded into it
+		int slot = 0;
+		ring.ForEach([&slot](FakeFrame& res) { CHECK(res.id == 9 + slot); ++slot; });
+	}
+
+	void TestSlotReuseRewindsUploads()
+	{
+		std::printf("reused slot starts with an empty upload cursor\n");
+		FrameResourceRing<FakeFrame> ring;
+		ring.Resize(2);
+		ring.ForEach([](FakeFrame& res) { res.uploadCursor.Reset(4096); });
+		FakeFence fence;
+
+		for (int frame = 0; frame < 6; ++frame)
+		{
+			FakeFrame& res = ring.Acquire(fence);
+			// Still holds the previous frame's allocations until BeginFrame rewinds it
+			CHECK(res.uploadCursor.GetUsed() == (frame < 2 ? 0u : 356u));
+			res.uploadCursor.Rewind();						// as DXContext::BeginFrame
+
+			const uint64_t a = res.uploadCursor.Allocate(100, kAlign);
+			const uint64_t b = res.uploadCursor.Allocate(100, kAlign);
+			CHECK(a == 0);
+			CHECK(b == 256);
+			ring.Retire(fence.Signal());
+		}
+		CHECK(fence.waits.size() == 4);					// completed never advanced on its own
+		ring.ForEach([](FakeFrame& res) { CHECK(res.uploadCursor.GetHighWater() == 356); });
+	}
+
+	void TestResize()
+	{
+		std::printf("resize / clear\n");
+		FrameResourceRing<FakeFrame> ring;
+		ring.Resize(0);
+		CHECK(ring.GetCount() == 1);					// at least one slot
+
+		FakeFence fence;
+		ring.Resize(2);
+		ring.Acquire(fence);
+		ring.Retire(fence.Signal());
+		CHECK(ring.GetIndex() == 1);
+		ring.Resize(4);
+		CHECK(ring.GetCount() == 4);
+		CHECK(ring.GetIndex() == 0);
+		ring.Acquire(fence);							// fresh slots carry no tag
+		CHECK(fence.waits.empty());
+
+		ring.Clear();
+		CHECK(ring.GetCount() == 0);
+	}
+}
+
+int main()
+{
+	TestLinearAllocator();
+	TestAcquireWaits();
+	TestRetireTagsAndWrap();
+	TestSlotReuseRewindsUploads();
+	TestResize();
+
+	return TestCheck::Finish();
+}
@@ -0,0 +1,287 @@
+// Test + scaling bench for the work-stealing JobSystem (D3D12/Util/JobSystem.{h,cpp}).
+//
+// Checks stealing (jobs pushed from the main thread's queue end up on workers),
+// Wait, parent/child completion and ParallelFor coverage, then times a CPU-bound
+// ParallelFor at 1..N workers. Exits non-zero on a failed check; the timings are
+// only printed.
+//
+//     g++ -std=c++17 -O2 -pthread -I D3D12 Tools/job_system_test.cpp D3D12/Util/JobSystem.cpp -o job_system_test && ./job_system_test
+
+#include "Util/JobSystem.h"
+#include "test_check.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	double MsSince(Clock::time_point t0)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+	}
+
+	// Deterministic busy work, ~microseconds per call
+	double Burn(size_t seed, int iterations)
+	{
+		double x = (double)(seed % 97) + 1.0;
+		for (int i = 0; i < iterations; ++i)
+		{
+			x = std::sqrt(x * 1.0001 + (double)i);
+		}
+		return x;
+	}
+
+	void TestInline()
+	{
+		std::printf("not initialized: runs inline\n");
+		CHECK(DX_JOB.IsRunning() == false);
+		int ran = 0;
+		JobSystem::JobHandle job = DX_JOB.Schedule([&ran]() { ++ran; });
+		CHECK(ran == 1);
+		CHECK(JobSystem::IsDone(job));
+		CHECK(JobSystem::IsDone(nullptr));
+	}
+
+	void TestStealing(unsigned workers)
+	{
+		std::printf("stealing\n");
+		// Everything is pushed to queue 0 (main thread); workers only get it by stealing.
+		// The main thread never helps, so every job must run on a worker.
+		constexpr int kJobs = 256;
+		std::vector<unsigned> ranOn(kJobs, ~0u);
+		std::atomic<int> done{ 0 };
+		for (int i = 0; i < kJobs; ++i)
+		{
+			DX_JOB.Schedule([&ranOn, &done, i]()
+				{
+					Burn((size_t)i, 2000);
+					ranOn[i] = JobSystem::GetThreadIndex();
+					done.fetch_add(1, std::memory_order_release);
+				});
+		}
+		const Clock::time_point t0 = Clock::now();
+		while (done.load(std::memory_order_acquire) < kJobs && MsSince(t0) < 10000.0)
+		{
+			std::this_thread::yield();
+		}
+		CHECK(done.load() == kJobs);
+
+		std::vector<int> perWorker(workers + 1, 0);
+		for (unsigned index : ranOn)
+		{
+			CHECK(index >= 1 && index <= workers);
+			if (index <= workers)
+			{
+				++perWorker[index];
+			}
+		}
+		const int busy = (int)std::count_if(perWorker.begin(), perWorker.end(), [](int n) { return n > 0; });
+		std::printf("  %d jobs ran on %d of %u workers\n", kJobs, busy, workers);
+		CHECK(busy >= 1);
+	}
+
+	void TestNestedSteal(unsigned workers)
+	{
+		std::printf("nested spawn from a worker\n");
+		// A worker fans out into its own queue; the other workers have to steal from it
+		constexpr int kChildren = 128;
+		std::vector<unsigned> ranOn(kChildren, 0);
+		JobSystem::JobHandle root = DX_JOB.CreateJob(nullptr);
+		JobSystem::JobHandle spawner = DX_JOB.CreateJob([&ranOn, root]()
+			{
+				for (int i = 0; i < kChildren; ++i)
+				{
+					DX_JOB.Schedule([&ranOn, i]()
+						{
+							Burn((size_t)i, 4000);
+							ranOn[i] = JobSystem::GetThreadIndex();
+						}, root);
+				}
+			}, root);
+		DX_JOB.Run(spawner);
+		DX_JOB.Run(root);
+		DX_JOB.Wait(root);
+		CHECK(JobSystem::IsDone(root));
+
+		std::vector<bool> seen(workers + 1, false);
+		for (unsigned index : ranOn)
+		{
+			CHECK(index <= workers);
+			if (index <= workers)
+			{
+				seen[index] = true;
+			}
+		}
+		const int threads = (int)std::count(seen.begin(), seen.end(), true);
+		std::printf("  %d children ran on %d thread(s)\n", kChildren, threads);
+		if (workers > 1)
+		{
+			CHECK(threads > 1);
+		}
+	}
+
+	void TestDependency()
+	{
+		std::printf("parent waits for children\n");
+		std::atomic<bool> release{ false };
+		std::atomic<int> childrenDone{ 0 };
+		std::atomic<bool> parentRan{ false };
+
+		JobSystem::JobHandle parent = DX_JOB.CreateJob([&parentRan]() { parentRan = true; });
+		for (int i = 0; i < 4; ++i)
+		{
+			DX_JOB.Schedule([&release, &childrenDone]()
+				{
+					while (!release.load(std::memory_order_acquire))
+					{
+						std::this_thread::yield();
+					}
+					childrenDone.fetch_add(1, std::memory_order_release);
+				}, parent);
+		}
+		DX_JOB.Run(parent);
+
+		// Whether or not the parent's own function already ran, it is not done while children are blocked
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		CHECK(JobSystem::IsDone(parent) == false);
+		CHECK(childrenDone.load() == 0);
+
+		release.store(true, std::memory_order_release);
+		DX_JOB.Wait(parent);
+		CHECK(JobSystem::IsDone(parent));
+		CHECK(parentRan.load());
+		CHECK(childrenDone.load() == 4);
+	}
+
+	void TestChain()
+	{
+		std::printf("grandchildren complete before the root\n");
+		std::atomic<int> leaves{ 0 };
+		JobSystem::JobHandle root = DX_JOB.CreateJob(nullptr);
+		for (int i = 0; i < 8; ++i)
+		{
+			JobSystem::JobHandle mid = DX_JOB.CreateJob(nullptr, root);
+			for (int j = 0; j < 8; ++j)
+			{
+				DX_JOB.Schedule([&leaves, i, j]()
+					{
+						Burn((size_t)(i * 8 + j), 1000);
+						leaves.fetch_add(1, std::memory_order_relaxed);
+					}, mid);
+			}
+			DX_JOB.Run(mid);
+		}
+		DX_JOB.Run(root);
+		DX_JOB.Wait(root);
+		CHECK(leaves.load() == 64);
+	}
+
+	void TestParallelFor()
+	{
+		std::printf("ParallelFor covers every index once\n");
+		const size_t counts[] = { 0, 1, 7, 64, 1000, 4099 };
+		const size_t grains[] = { 1, 3, 64, 5000 };
+		for (size_t count : counts)
+		{
+			for (size_t grain : grains)
+			{
+				std::vector<std::atomic<int>> hits(count);
+				for (std::atomic<int>& h : hits)
+				{
+					h.store(0);
+				}
+				DX_JOB.ParallelFor(0, count, grain, [&hits](size_t i) { hits[i].fetch_add(1, std::memory_order_relaxed); });
+
+				bool once = true;
+				for (std::atomic<int>& h : hits)
+				{
+					once = once && h.load() == 1;
+				}
+				if (!once)
+				{
+					std::printf("  count %zu grain %zu\n", count, grain);
+				}
+				CHECK(once);
+			}
+		}
+	}
+
+	void BenchScaling(unsigned maxWorkers)
+	{
+		std::printf("scaling (ParallelFor, 4096 items x ~20k sqrt)\n");
+		constexpr size_t kItems = 4096;
+		constexpr int kIterations = 20000;
+		std::vector<double> out(kItems);
+
+		// Reference result on the calling thread
+		const Clock::time_point t0 = Clock::now();
+		double reference = 0.0;
+		for (size_t i = 0; i < kItems; ++i)
+		{
+			reference += Burn(i, kIterations);
+		}
+		const double serialMs = MsSince(t0);
+		std::printf("  serial      %8.2f ms\n", serialMs);
+
+		std::vector<unsigned> counts;
+		for (unsigned n = 1; n < maxWorkers; n *= 2)
+		{
+			counts.push_back(n);
+		}
+		counts.push_back(maxWorkers);
+
+		for (unsigned workers : counts)
+		{
+			DX_JOB.Shutdown();
+			DX_JOB.Init(workers);
+
+			double bestMs = 1e30;
+			for (int rep = 0; rep < 3; ++rep)
+			{
+				const Clock::time_point t1 = Clock::now();
+				DX_JOB.ParallelFor(0, kItems, 32, [&out](size_t i) { out[i] = Burn(i, kIterations); });
+				bestMs = std::min(bestMs, MsSince(t1));
+			}
+
+			double sum = 0.0;
+			for (double v : out)
+			{
+				sum += v;
+			}
+			CHECK(sum == reference);
+			std::printf("  %2u workers %8.2f ms  x%.2f\n", workers, bestMs, serialMs / bestMs);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+	const unsigned workers = argc > 1 ? (unsigned)std::max(1, std::atoi(argv[1])) : hw - 1;
+
+	TestInline();
+
+	DX_JOB.Init(workers);
+	CHECK(DX_JOB.IsRunning());
+	CHECK(DX_JOB.GetWorkerCount() == workers);
+	CHECK(JobSystem::GetThreadIndex() == 0);
+
+	TestStealing(workers);
+	TestNestedSteal(workers);
+	TestDependency();
+	TestChain();
+	TestParallelFor();
+	BenchScaling(workers);
+
+	DX_JOB.Shutdown();
+	CHECK(DX_JOB.IsRunning() == false);
+
+	return TestCheck::Finish();
+}
@@ -0,0 +1,372 @@
+// Headless CPU EP benchmark / regression check for the app's style models.
+//
+// Runs each model through OnnxCpuSession (the session behind OnnxRunner_Cpu) on a
+// deterministic synthetic frame, so no GPU, window or D3D12 is needed. Inputs are
+// laid out like the pre-process pass writes them: NCHW float, 0..1 (0..255 only
+// where the app sets PRE_MUL_255, see InputScale), zeros for the previous-frame
+// channels of 6-channel inputs; two-input models get the same pattern, mirrored,
+// as the style image.
+//
+// --save DIR writes each output as <model>.bin (raw float NCHW after a one-line
+// shape header); --ref DIR compares against such files and exits non-zero when
+// the max abs difference exceeds --tol times the reference range.
+// --profile DIR turns on ORT profiling and writes the trace plus a per-op-type /
+// per-node summary of the timed runs (<trace>_summary.csv/.json, OnnxProfileReport).
+//
+// Models default to the ones OnnxManager::GetModelPath loads; run from D3D12/.
+//
+//     g++ -std=c++17 -O2 -I D3D12 -I $ORT/include Tools/onnx_cpu_bench.cpp D3D12/Util/OnnxCpuSession.cpp D3D12/Util/OnnxProfileReport.cpp -L $ORT/lib -lonnxruntime -o onnx_cpu_bench
+//     cd D3D12 && ../onnx_cpu_bench --size 512 --runs 20 --threads 8
+//     ../onnx_cpu_bench --ref ../cpu_ref ./Resources/Onnx/FHD/FST_dyn_TheStarryNight.onnx
+
+#include "Util/OnnxCpuSession.h"
+#include "Util/OnnxProfileReport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const char* const kDefaultModels[] = {
+		"./Resources/Onnx/1x1_Conv.onnx",
+		"./Resources/Onnx/adain_end2end_2inputs_op17.onnx",
+		"./Resources/Onnx/FHD/FST_dyn_TheStarryNight.onnx",
+		"./Resources/Onnx/FHD/ReCoNet_TheStarryNight.onnx",
+		"./Resources/Onnx/sanet_end2end_2inputs_op17.onnx",
+	};
+
+	struct Options
+	{
+		int size = 512;
+		int runs = 10;
+		int threads = 0;
+		double tol = 1e-3;
+		std::string saveDir;
+		std::string refDir;
+		std::string profileDir;
+		std::vector<std::string> models;
+	};
+
+	struct Result
+	{
+		double firstMs = 0.0;		// includes output shape discovery
+		double meanMs = 0.0;
+		double minMs = 0.0;
+		std::vector<int64_t> outShape;
+	};
+
+	// Dynamic axes take N = 1, C = 3, H/W = size (multiple of 4 like the runners bind)
+	// Mirrors the app: OnnxManager::CreateOnnxRunner picks the type from the path (first match)
+	// and only OnnxType::FastNeuralStyle gets PRE_MUL_255 (RecordPreprocess_FastNeuralStyle; the
+	// AdaIN pass never scales). "FST_dyn_*" runs as ReCoNet, so it is fed 0..1 as well.
+	float InputScale(const std::string& path)
+	{
+		struct TypeKey { const char* key; bool mul255; };
+		const TypeKey kTypes[] = { { "sanet", false }, { "Conv", false }, { "ReCoNet", false }, { "dyn", false }, { "adain", false } };
+		for (const TypeKey& type : kTypes)
+		{
+			if (path.find(type.key) != std::string::npos)
+			{
+				return type.mul255 ? 255.0f : 1.0f;
+			}
+		}
+		return 1.0f;
+	}
+
+	std::vector<int64_t> FillShape(const std::vector<int64_t>& model, int size)
+	{
+		const int64_t hw = std::max<int>((size / 4) * 4, 4);
+		const int64_t fallback[4] = { 1, 3, hw, hw };
+		std::vector<int64_t> shape = model.size() == 4 ? model : std::vector<int64_t>{ -1, -1, -1, -1 };
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (shape[i] <= 0)
+			{
+				shape[i] = fallback[i];
+			}
+		}
+		return shape;
+	}
+
+	void FillFrame(float* data, const std::vector<int64_t>& shape, float scale, bool mirror)
+	{
+		const int64_t c = shape[1], h = shape[2], w = shape[3];
+		for (int64_t n = 0; n < shape[0]; ++n)
+		{
+			for (int64_t ch = 0; ch < c; ++ch)
+			{
+				float* plane = data + ((n * c) + ch) * h * w;
+				for (int64_t y = 0; y < h; ++y)
+				{
+					for (int64_t x = 0; x < w; ++x)
+					{
+						// Smooth gradients plus a checker so convolutions see edges; zeros past RGB
+						const int64_t xx = mirror ? w - 1 - x : x;
+						const float u = (float)xx / (float)w, v = (float)y / (float)h;
+						const float checker = ((xx / 16 + y / 16) & 1) ? 0.25f : 0.0f;
+						const float rgb[3] = { u, v, 0.5f + 0.5f * std::sin(6.2831853f * (u + v)) };
+						plane[y * w + x] = ch < 3 ? std::min<float>(rgb[ch] * 0.75f + checker, 1.0f) * scale : 0.0f;
+					}
+				}
+			}
+		}
+	}
+
+	// The first Run (shape discovery) falls outside the last `runs` model_run events
+	void WriteProfile(Ort::Session& session, const std::string& model, int runs, const std::vector<int64_t>& inputShape)
+	{
+		Ort::AllocatorWithDefaultOptions alloc;
+		const std::string trace = session.EndProfilingAllocated(alloc).get();
+		OnnxProfileReport report;
+		if (report.Load(trace, runs) == false)
+		{
+			std::fprintf(stderr, "  profile: %s\n", report.GetError().c_str());
+			return;
+		}
+
+		const OnnxProfileReport::Info info{ std::filesystem::path(model).stem().string(), "CPU", "fp32", inputShape };
+		const std::string base = (std::filesystem::path(trace).parent_path() / std::filesystem::path(trace).stem()).string() + "_summary";
+		const bool written = report.WriteCsv(base + ".csv", info) && report.WriteJson(base + ".json", info);
+		std::printf("  profile: kernels %.2f ms/run -> %s%s\n", report.GetKernelTotalUs() / report.GetRuns() / 1000.0,
+			base.c_str(), written ? ".csv/.json" : " (write failed)");
+		const std::vector<OnnxProfileReport::Entry>& ops = report.GetOpTypes();
+		for (size_t i = 0; i < ops.size() && i < 5; ++i)
+		{
+			std::printf("    %-24s %6.2f%%  %.3f ms/run\n", ops[i].name.c_str(),
+				report.GetKernelTotalUs() > 0.0 ? ops[i].totalUs * 100.0 / report.GetKernelTotalUs() : 0.0,
+				ops[i].totalUs / report.GetRuns() / 1000.0);
+		}
+	}
+
+	bool RunModel(const std::string& path, const Options& options, Ort::Env& env, Result& result, std::vector<float>& output)
+	{
+		OnnxCpuSession::Config config;
+		config.intraOpThreads = options.threads;
+		std::unique_ptr<Ort::Session> session;
+		try
+		{
+			Ort::SessionOptions so = OnnxCpuSession::MakeOptions(config);
+			if (options.profileDir.empty() == false)
+			{
+				std::error_code ec;
+				std::filesystem::create_directories(options.profileDir, ec);
+				so.EnableProfiling((std::filesystem::path(options.profileDir) / std::filesystem::path(path).stem()).c_str());
+			}
+			session = std::make_unique<Ort::Session>(env, std::filesystem::path(path).c_str(), so);
+		}
+		catch (const Ort::Exception& e)
+		{
+			std::fprintf(stderr, "  session: %s\n", e.what());
+			return false;
+		}
+
+		OnnxCpuSession cpu;
+		if (cpu.Init(session.get()) == false)
+		{
+			std::fprintf(stderr, "  init: %s\n", cpu.GetError().c_str());
+			return false;
+		}
+		if (cpu.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+		{
+			std::fprintf(stderr, "  skipped: only float IO models run on the CPU path\n");
+			return false;
+		}
+
+		const std::vector<int64_t> content = FillShape(cpu.GetModelInputShape(0), options.size);
+		const std::vector<int64_t> style = cpu.GetInputCount() > 1 ? FillShape(cpu.GetModelInputShape(1), options.size) : std::vector<int64_t>{};
+		if (cpu.Prepare(content, style, {}) == false)
+		{
+			std::fprintf(stderr, "  prepare: %s\n", cpu.GetError().c_str());
+			return false;
+		}
+
+		const float scale = InputScale(path);
+		FillFrame(static_cast<float*>(cpu.GetInputData(0)), content, scale, false);
+		if (cpu.GetInputCount() > 1)
+		{
+			FillFrame(static_cast<float*>(cpu.GetInputData(1)), style, scale, true);
+		}
+
+		const int runs = std::max<int>(options.runs, 1);
+		double total = 0.0;
+		for (int i = 0; i <= runs; ++i)
+		{
+			const auto begin = std::chrono::steady_clock::now();
+			if (cpu.Run() == false)
+			{
+				std::fprintf(stderr, "  run: %s\n", cpu.GetError().c_str());
+				return false;
+			}
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+			if (i == 0)
+			{
+				result.firstMs = ms;
+				continue;
+			}
+			total += ms;
+			result.minMs = i == 1 ? ms : std::min<double>(result.minMs, ms);
+		}
+		result.meanMs = total / runs;
+		result.outShape = cpu.GetOutputShape();
+		if (options.profileDir.empty() == false)
+		{
+			WriteProfile(*session, path, runs, content);
+		}
+
+		output.resize(cpu.GetOutputBytes() / sizeof(float));
+		std::memcpy(output.data(), cpu.GetOutputData(), output.size() * sizeof(float));
+		return true;
+	}
+
+	std::string ShapeText(const std::vector<int64_t>& shape)
+	{
+		std::string text;
+		for (size_t i = 0; i < shape.size(); ++i)
+		{
+			text += (i ? "x" : "") + std::to_string(shape[i]);
+		}
+		return text;
+	}
+
+	std::filesystem::path DumpPath(const std::string& dir, const std::string& model)
+	{
+		return std::filesystem::path(dir) / (std::filesystem::path(model).stem().string() + ".bin");
+	}
+
+	bool SaveOutput(const std::filesystem::path& path, const std::vector<int64_t>& shape, const std::vector<float>& data)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+		std::ofstream file(path, std::ios::binary);
+		file << ShapeText(shape) << '\n';
+		file.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)(data.size() * sizeof(float)));
+		return file.good();
+	}
+
+	// Returns false when the reference is missing or differs in shape or beyond tol
+	bool CompareOutput(const std::filesystem::path& path, const std::vector<int64_t>& shape, const std::vector<float>& data, double tol)
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::string refShape;
+		if (!file || !std::getline(file, refShape))
+		{
+			std::printf("  ref: missing %s\n", path.string().c_str());
+			return false;
+		}
+		if (refShape != ShapeText(shape))
+		{
+			std::printf("  ref: shape %s, got %s\n", refShape.c_str(), ShapeText(shape).c_str());
+			return false;
+		}
+
+		std::vector<float> ref(data.size());
+		file.read(reinterpret_cast<char*>(ref.data()), (std::streamsize)(ref.size() * sizeof(float)));
+		if ((size_t)file.gcount() != ref.size() * sizeof(float))
+		{
+			std::printf("  ref: truncated %s\n", path.string().c_str());
+			return false;
+		}
+
+		double maxDiff = 0.0, sqSum = 0.0;
+		float lo = ref.empty() ? 0.0f : ref[0], hi = lo;
+		for (size_t i = 0; i < ref.size(); ++i)
+		{
+			const double d = std::fabs((double)data[i] - (double)ref[i]);
+			maxDiff = std::max<double>(maxDiff, d);
+			sqSum += d * d;
+			lo = std::min<float>(lo, ref[i]);
+			hi = std::max<float>(hi, ref[i]);
+		}
+		const double range = std::max<double>((double)hi - (double)lo, 1e-6);
+		const double mse = ref.empty() ? 0.0 : sqSum / (double)ref.size();
+		const double psnr = mse > 0.0 ? 10.0 * std::log10(range * range / mse) : INFINITY;
+		const bool pass = maxDiff <= tol * range;
+		std::printf("  ref: max |diff| %.4g (%.2e of range), PSNR %.1f dB -> %s\n",
+			maxDiff, maxDiff / range, psnr, pass ? "ok" : "FAIL");
+		return pass;
+	}
+
+	bool ParseArgs(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if (arg == "--size" && hasValue)			options.size = std::atoi(argv[++i]);
+			else if (arg == "--runs" && hasValue)		options.runs = std::atoi(argv[++i]);
+			else if (arg == "--threads" && hasValue)	options.threads = std::atoi(argv[++i]);
+			else if (arg == "--tol" && hasValue)		options.tol = std::atof(argv[++i]);
+			else if (arg == "--save" && hasValue)		options.saveDir = argv[++i];
+			else if (arg == "--ref" && hasValue)		options.refDir = argv[++i];
+			else if (arg == "--profile" && hasValue)	options.profileDir = argv[++i];
+			else if (arg.rfind("--", 0) == 0)
+			{
+				std::fprintf(stderr, "usage: %s [--size N] [--runs N] [--threads N] [--save DIR] [--ref DIR] [--tol T] [--profile DIR] [model.onnx ...]\n", argv[0]);
+				return false;
+			}
+			else										options.models.push_back(arg);
+		}
+		if (options.models.empty())
+		{
+			options.models.assign(std::begin(kDefaultModels), std::end(kDefaultModels));
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (ParseArgs(argc, argv, options) == false)
+	{
+		return 2;
+	}
+
+	Ort::Env env{ ORT_LOGGING_LEVEL_WARNING, "onnx_cpu_bench" };
+	std::printf("CPU EP, ORT %s, %d intra-op threads (0 = default), %dx%d, %d runs\n",
+		Ort::GetVersionString().c_str(), options.threads, options.size, options.size, options.runs);
+
+	int failures = 0;
+	for (const std::string& model : options.models)
+	{
+		std::printf("%s\n", model.c_str());
+		std::error_code ec;
+		if (std::filesystem::exists(model, ec) == false)
+		{
+			std::printf("  missing\n");
+			++failures;
+			continue;
+		}
+
+		Result result;
+		std::vector<float> output;
+		if (RunModel(model, options, env, result, output) == false)
+		{
+			++failures;
+			continue;
+		}
+		std::printf("  out %s: first %.1f ms, mean %.1f ms, min %.1f ms\n",
+			ShapeText(result.outShape).c_str(), result.firstMs, result.meanMs, result.minMs);
+
+		if (options.saveDir.empty() == false && SaveOutput(DumpPath(options.saveDir, model), result.outShape, output) == false)
+		{
+			std::printf("  save failed\n");
+			++failures;
+		}
+		if (options.refDir.empty() == false && CompareOutput(DumpPath(options.refDir, model), result.outShape, output, options.tol) == false)
+		{
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+"""Offline FP16 conversion for the style models under D3D12/Resources/Onnx.
+
+Writes <model>_fp16.onnx next to every fp32 model. Inputs and outputs become
+float16 too (keep_io_types=False): with ONNX_FP16 the app's pre-process writes
+half and the post-process reads half, so no Cast runs at the graph edges.
+
+--check runs the fp32 and fp16 graphs on the CPU EP with the same input and
+reports max abs error and PSNR against the fp32 output; it exits with 1 when
+any model falls below --min-psnr.
+
+    pip install onnx onnxconverter-common onnxruntime numpy
+    python Tools/onnx_fp16.py                       # convert everything
+    python Tools/onnx_fp16.py --check               # convert, then compare
+    python Tools/onnx_fp16.py --check --no-convert  # compare existing pairs
+"""
+
+import argparse
+import math
+import sys
+from pathlib import Path
+
+import numpy as np
+import onnx
+from onnxconverter_common import float16
+
+DEFAULT_ROOT = Path(__file__).resolve().parent.parent / "D3D12" / "Resources" / "Onnx"
+SUFFIX = "_fp16"
+SKIP_SUFFIXES = (SUFFIX, "_int8")  # converted variants are never sources (QDQ graphs do not convert)
+
+
+def find_models(root):
+    for path in sorted(root.rglob("*.onnx")):
+        if "Cache" in path.parts or path.stem.endswith(SKIP_SUFFIXES):
+            continue
+        yield path
+
+
+def fp16_path(path):
+    return path.with_name(path.stem + SUFFIX + path.suffix)
+
+
+def convert(path, force):
+    out = fp16_path(path)
+    if out.exists() and not force:
+        print(f"skip   {path.name} ({out.name} exists)")
+        return out
+    model = onnx.load(str(path))
+    model16 = float16.convert_float_to_float16(model, keep_io_types=False)
+    onnx.save(model16, str(out))
+    print(f"wrote  {out.name} ({path.stat().st_size / 2**20:.1f} MB -> {out.stat().st_size / 2**20:.1f} MB)")
+    return out
+
+
+def image_inputs(session, size):
+    """Seeded [0, 1] inputs for NCHW image inputs; None if the graph takes anything else."""
+    rng = np.random.default_rng(0)
+    feeds = {}
+    for arg in session.get_inputs():
+        shape = list(arg.shape)
+        if len(shape) != 4:
+            return None
+        n, c, h, w = [d if isinstance(d, int) and d > 0 else None for d in shape]
+        c = c or 3
+        if c not in (3, 6):
+            return None
+        feeds[arg.name] = rng.random((n or 1, c, h or size, w or size), dtype=np.float32)
+    return feeds
+
+
+def psnr(ref, test):
+    # Range taken from the reference output, so tanh, 0..1 and 0..255 models compare alike
+    peak = float(ref.max() - ref.min()) or 1.0
+    mse = float(np.mean((ref - test) ** 2))
+    return math.inf if mse == 0.0 else 10.0 * math.log10(peak * peak / mse)
+
+
+def check(path, path16, size):
+    import onnxruntime as ort
+
+    so = ort.SessionOptions()
+    so.log_severity_level = 3
+    s32 = ort.InferenceSession(str(path), so, providers=["CPUExecutionProvider"])
+    s16 = ort.InferenceSession(str(path16), so, providers=["CPUExecutionProvider"])
+
+    feeds = image_inputs(s32, size)
+    if feeds is None:
+        print(f"check  {path.name}: skipped (inputs are not NCHW images)")
+        return None
+
+    ref = s32.run(None, feeds)[0].astype(np.float32)
+    test = s16.run(None, {k: v.astype(np.float16) for k, v in feeds.items()})[0].astype(np.float32)
+    if ref.shape != test.shape:
+        print(f"check  {path.name}: shape mismatch {ref.shape} vs {test.shape}")
+        return 0.0
+
+    value = psnr(ref, test)
+    print(f"check  {path.name}: max abs err {float(np.abs(ref - test).max()):.4g}, PSNR {value:.2f} dB")
+    return value
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--root", type=Path, default=DEFAULT_ROOT)
+    parser.add_argument("--force", action="store_true", help="overwrite existing *_fp16.onnx")
+    parser.add_argument("--no-convert", action="store_true")
+    parser.add_argument("--check", action="store_true", help="CPU parity check fp32 vs fp16")
+    parser.add_argument("--size", type=int, default=256, help="H and W for dynamic input dims")
+    parser.add_argument("--min-psnr", type=float, default=35.0)
+    args = parser.parse_args()
+
+    models = list(find_models(args.root))
+    if not models:
+        print(f"no models under {args.root}")
+        return 1
+
+    failed = False
+    for path in models:
+        path16 = fp16_path(path) if args.no_convert else convert(path, args.force)
+        if args.check and path16.exists():
+            value = check(path, path16, args.size)
+            if value is not None and value < args.min_psnr:
+                failed = True
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
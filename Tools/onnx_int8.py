@@ -0,0 +1,256 @@
+"""INT8 (QDQ) quantization for the FastNeuralStyle / ReCoNet models.
+
+Calibration feeds representative frames through the fp32 model to collect
+activation ranges and writes <model>_int8.onnx next to it. Frames come from
+D3D12/Resources/*.png plus any --frames directory (e.g. a recorded camera walk
+saved as PNG/JPG). They are preprocessed like the app's pre-process pass,
+with the same flags: the model type comes from the file name the way
+OnnxManager::CreateOnnxRunner picks it ("FST_dyn_*" runs as ReCoNet, so 0..1),
+PRE_MUL_255 only for the FastNeuralStyle type, PRE_BGR_SWAP / LINEAR_TO_SRGB
+from the scene color format, and zeros for the previous frame channels of
+6-channel inputs.
+
+Inputs and outputs stay float: the app runs the QDQ model through the fp32
+tensor path and loads it when ONNX_INT8 is set.
+
+--report prints fp32 / fp16 / int8 side by side: mean Session::Run time on the
+chosen EP and PSNR against the fp32 output on the same frames. --csv also
+writes the table to a file.
+
+    pip install onnx onnxruntime numpy pillow   (onnxruntime-directml for --ep dml)
+    python Tools/onnx_int8.py                                  # calibrate + quantize
+    python Tools/onnx_int8.py --frames Export/Walk --report    # more frames, then compare
+    python Tools/onnx_int8.py --no-quantize --report --ep dml --csv int8_report.csv
+"""
+
+import argparse
+import csv
+import math
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+import numpy as np
+import onnx
+import onnxruntime as ort
+from PIL import Image
+from onnxruntime.quantization import (CalibrationDataReader, CalibrationMethod, QuantFormat, QuantType,
+                                      quantize_static)
+from onnxruntime.quantization.shape_inference import quant_pre_process
+
+D3D12_DIR = Path(__file__).resolve().parent.parent / "D3D12"
+DEFAULT_ROOT = D3D12_DIR / "Resources" / "Onnx"
+DEFAULT_FRAMES = D3D12_DIR / "Resources"
+INT8_TYPES = ("FastNeuralStyle", "ReCoNet")  # OnnxManager: int8 variants load for these only
+VARIANTS = ("", "_fp16", "_int8")
+IMAGE_SUFFIXES = (".png", ".jpg", ".jpeg")
+
+
+def find_models(root):
+    for path in sorted(root.rglob("*.onnx")):
+        if "Cache" in path.parts or path.stem.endswith(VARIANTS[1:]):
+            continue
+        if app_type(path) in INT8_TYPES:
+            yield path
+
+
+def variant_path(path, suffix):
+    return path.with_name(path.stem + suffix + path.suffix)
+
+
+def find_frames(dirs, limit):
+    frames = []
+    for directory in dirs:
+        frames += sorted(p for p in directory.iterdir() if p.suffix.lower() in IMAGE_SUFFIXES)
+    return frames[:limit] if limit > 0 else frames
+
+
+def input_layout(session, size):
+    """(name, C, H, W) of the image input; dynamic H/W become size rounded down to a multiple of 4."""
+    arg = session.get_inputs()[0]
+    n, c, h, w = [d if isinstance(d, int) and d > 0 else None for d in arg.shape]
+    return arg.name, c or 3, h or (size // 4) * 4, w or (size // 4) * 4
+
+
+# --- Mirrors of the app's tables; keep in sync ---------------------------------
+# OnnxManager::CreateOnnxRunner: first substring of the model path that matches
+APP_TYPE_BY_NAME = (("sanet", "Sanet"), ("Conv", "WCT2"), ("ReCoNet", "ReCoNet"), ("dyn", "ReCoNet"),
+                    ("adain", "AdaIN"))
+# DirectXManager scene color (what the pre-process pass samples)
+SCENE_COLOR_FORMAT = "R16G16B16A16_FLOAT"
+# Util/OnnxDefine.h
+LINEAR_TO_SRGB = 0x0001
+PRE_BGR_SWAP = 0x0010
+PRE_MUL_255 = 0x0100
+
+
+def app_type(model_path):
+    text = str(model_path)
+    return next((t for key, t in APP_TYPE_BY_NAME if key in text), None)
+
+
+def preprocess_flags(model_path):
+    """Same rules as OnnxService_FastNeuralStyle::RecordPreprocess_FastNeuralStyle."""
+    flags = PRE_MUL_255 if app_type(model_path) == "FastNeuralStyle" else 0
+    if SCENE_COLOR_FORMAT.startswith("B8G8R8A8_UNORM"):
+        flags |= PRE_BGR_SWAP
+    if SCENE_COLOR_FORMAT.endswith("_UNORM_SRGB"):
+        flags |= LINEAR_TO_SRGB
+    return flags
+
+
+def linear_to_srgb(x):
+    x = np.clip(x, 0.0, 1.0)
+    return np.where(x < 0.0031308, 12.92 * x, 1.055 * np.power(x, 1.0 / 2.4) - 0.055).astype(np.float32)
+
+
+def srgb_to_linear(c):
+    return np.where(c < 0.04045, c / 12.92, np.power((c + 0.055) / 1.055, 2.4)).astype(np.float32)
+
+
+def preprocess(frame, model_path, c, h, w):
+    rgb = np.asarray(Image.open(frame).convert("RGB").resize((w, h), Image.BILINEAR), dtype=np.float32) / 255.0
+    if SCENE_COLOR_FORMAT.endswith("_SRGB"):
+        rgb = srgb_to_linear(rgb)  # what sampling an sRGB scene color returns
+    flags = preprocess_flags(model_path)
+    if flags & PRE_BGR_SWAP:
+        rgb = rgb[..., ::-1]
+    if flags & LINEAR_TO_SRGB:
+        rgb = linear_to_srgb(rgb)
+    if flags & PRE_MUL_255:
+        rgb = rgb * 255.0
+    chw = np.ascontiguousarray(rgb.transpose(2, 0, 1))
+    if c >= 6:
+        # Previous frame channels: the app passes zeros while PRE_PT_VALID is unset
+        chw = np.concatenate([chw, np.zeros((c - 3, h, w), np.float32)])
+    return chw[None, ...]
+
+
+class FrameReader(CalibrationDataReader):
+    def __init__(self, model_path, frames, size):
+        session = ort.InferenceSession(str(model_path), providers=["CPUExecutionProvider"])
+        self.name, c, h, w = input_layout(session, size)
+        self.inputs = (preprocess(f, model_path, c, h, w) for f in frames)  # lazy: FHD frames add up
+
+    def get_next(self):
+        tensor = next(self.inputs, None)
+        return None if tensor is None else {self.name: tensor}
+
+
+def quantize(path, frames, args):
+    out = variant_path(path, "_int8")
+    if out.exists() and not args.force:
+        print(f"skip   {path.name} ({out.name} exists)")
+        return
+
+    with tempfile.TemporaryDirectory() as tmp:
+        # Shape inference + basic graph cleanup first, as the quantizer expects
+        prepped = Path(tmp) / "prepped.onnx"
+        quant_pre_process(str(path), str(prepped))
+        quantize_static(
+            str(prepped), str(out), FrameReader(path, frames, args.size),
+            quant_format=QuantFormat.QDQ,
+            activation_type=QuantType.QUInt8,
+            weight_type=QuantType.QInt8,
+            per_channel=True,
+            calibrate_method=CalibrationMethod.Percentile if args.percentile else CalibrationMethod.MinMax)
+
+    # Runners report this name; QDQ models keep float IO, so nothing else tells them apart
+    model = onnx.load(str(out))
+    entry = model.metadata_props.add()
+    entry.key, entry.value = "precision", "int8_qdq"
+    onnx.save(model, str(out))
+    print(f"wrote  {out.name} from {len(frames)} frames "
+          f"({path.stat().st_size / 2**20:.1f} MB -> {out.stat().st_size / 2**20:.1f} MB)")
+
+
+def providers_for(ep):
+    if ep == "dml":
+        return [("DmlExecutionProvider", {}), "CPUExecutionProvider"]
+    return ["CPUExecutionProvider"]
+
+
+def psnr(ref, test):
+    # Range taken from the reference output, so tanh, 0..1 and 0..255 models compare alike
+    peak = float(ref.max() - ref.min()) or 1.0
+    mse = float(np.mean((ref - test) ** 2))
+    return math.inf if mse == 0.0 else 10.0 * math.log10(peak * peak / mse)
+
+
+def report(path, frames, args):
+    rows = []
+    reference = None
+    for suffix in VARIANTS:
+        model_path = variant_path(path, suffix)
+        if not model_path.exists():
+            continue
+        session = ort.InferenceSession(str(model_path), providers=providers_for(args.ep))
+        name, c, h, w = input_layout(session, args.size)
+        dtype = np.float16 if session.get_inputs()[0].type == "tensor(float16)" else np.float32
+        inputs = [preprocess(f, path, c, h, w).astype(dtype) for f in frames]
+
+        outputs = [session.run(None, {name: x})[0].astype(np.float32) for x in inputs]
+        if reference is None:
+            reference = outputs
+
+        # Warm-up above; timing cycles through the frames
+        begin = time.perf_counter()
+        for i in range(args.runs):
+            session.run(None, {name: inputs[i % len(inputs)]})
+        ms = (time.perf_counter() - begin) * 1000.0 / args.runs
+
+        value = min(psnr(r, o) for r, o in zip(reference, outputs))
+        rows.append({"model": path.stem, "precision": suffix.lstrip("_") or "fp32", "ep": args.ep,
+                     "size": f"{w}x{h}", "run_ms": round(ms, 3), "min_psnr_db": round(value, 2),
+                     "file_mb": round(model_path.stat().st_size / 2**20, 1)})
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("models", nargs="*", type=Path,
+                        help="fp32 models (default: those under --root the app runs as FastNeuralStyle/ReCoNet)")
+    parser.add_argument("--root", type=Path, default=DEFAULT_ROOT)
+    parser.add_argument("--frames", type=Path, action="append", default=[],
+                        help="extra calibration frame directory (repeatable)")
+    parser.add_argument("--max-frames", type=int, default=64)
+    parser.add_argument("--size", type=int, default=512, help="H and W for dynamic input dims")
+    parser.add_argument("--percentile", action="store_true", help="percentile calibration instead of min/max")
+    parser.add_argument("--force", action="store_true", help="overwrite existing *_int8.onnx")
+    parser.add_argument("--no-quantize", action="store_true")
+    parser.add_argument("--report", action="store_true", help="fp32/fp16/int8 PSNR and speed side by side")
+    parser.add_argument("--ep", choices=("cpu", "dml"), default="cpu")
+    parser.add_argument("--runs", type=int, default=20)
+    parser.add_argument("--report-frames", type=int, default=8)
+    parser.add_argument("--csv", type=Path)
+    args = parser.parse_args()
+
+    models = args.models or list(find_models(args.root))
+    frames = find_frames([DEFAULT_FRAMES] + args.frames, args.max_frames)
+    if not models or not frames:
+        print(f"need models ({len(models)}) and calibration frames ({len(frames)})")
+        return 1
+
+    rows = []
+    for path in models:
+        if not args.no_quantize:
+            quantize(path, frames, args)
+        if args.report:
+            rows += report(path, frames[:args.report_frames], args)
+
+    if rows:
+        columns = list(rows[0].keys())
+        print("  ".join(f"{c:>14}" for c in columns))
+        for row in rows:
+            print("  ".join(f"{str(row[c]):>14}" for c in columns))
+        if args.csv:
+            with open(args.csv, "w", newline="") as file:
+                writer = csv.DictWriter(file, fieldnames=columns)
+                writer.writeheader()
+                writer.writerows(rows)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
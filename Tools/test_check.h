@@ -0,0 +1,38 @@
+#pragma once
+
+// Minimal check helpers shared by the std-only test drivers under Tools/.
+// CHECK records a failure and keeps going; main ends with
+//     return TestCheck::Finish();
+// which prints the summary and turns it into the exit code.
+
+#include <cstdio>
+
+namespace TestCheck
+{
+	inline int& Failures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	inline void Fail(const char* file, int line, const char* expr)
+	{
+		std::printf("  FAIL %s:%d: %s\n", file, line, expr);
+		++Failures();
+	}
+
+	inline int Finish()
+	{
+		const int failures = Failures();
+		if (failures == 0)
+		{
+			std::printf("ok\n");
+			return 0;
+		}
+		std::printf("%d check(s) failed\n", failures);
+		return 1;
+	}
+}
+
+#define CHECK(cond) \
+	do { if (!(cond)) { TestCheck::Fail(__FILE__, __LINE__, #cond); } } while (0)
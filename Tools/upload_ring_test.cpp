@@ -0,0 +1,249 @@
+// GPU-free test for UploadRingAllocator (D3D/UploadRing.h).
+//
+// Drives the ring with fake copy-fence values the way DXContext's upload path
+// does: Allocate while recording, Close(signaled value) on submission,
+// Retire(GetCompletedValue) before the next allocation, and on a full ring wait
+// for GetOldestFence and retry. Requests larger than the ring must fail so the
+// caller takes the one-off upload buffer path. Exits non-zero if any check fails.
+//
+//     g++ -std=c++17 -O2 -I D3D12 Tools/upload_ring_test.cpp -o upload_ring_test && ./upload_ring_test
+
+#include "D3D/UploadRing.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	constexpr uint64_t kInvalid = UploadRingAllocator::InvalidOffset;
+
+	void TestBasicAlign()
+	{
+		std::printf("allocate, align, close, retire\n");
+		UploadRingAllocator ring;
+		ring.Reset(1024);
+		CHECK(ring.GetCapacity() == 1024);
+		CHECK(ring.GetOldestFence() == 0);
+
+		CHECK(ring.Allocate(10, 1) == 0);
+		CHECK(ring.Allocate(10, 256) == 256);		// padding counts as used
+		CHECK(ring.GetUsed() == 266);
+		CHECK(ring.GetOpenBytes() == 266);
+
+		ring.Close(7);
+		CHECK(ring.GetOpenBytes() == 0);
+		CHECK(ring.GetOldestFence() == 7);
+		ring.Close(8);									// nothing open: no empty batch
+		CHECK(ring.Retire(6) == 0);
+		CHECK(ring.Retire(7) == 266);
+		CHECK(ring.GetUsed() == 0);
+		CHECK(ring.GetOldestFence() == 0);
+		CHECK(ring.GetHighWater() == 266);
+	}
+
+	void TestWrapTail()
+	{
+		std::printf("wrap burns the unusable tail\n");
+		UploadRingAllocator ring;
+		ring.Reset(1024);
+
+		CHECK(ring.Allocate(600, 1) == 0);
+		ring.Close(1);
+		CHECK(ring.Allocate(300, 1) == 600);
+		ring.Close(2);
+		CHECK(ring.Retire(1) == 600);
+		CHECK(ring.GetUsed() == 300);
+
+		// 124 bytes left before the end: too small for 200, so wrap to 0 and count the tail
+		CHECK(ring.Allocate(200, 1) == 0);
+		CHECK(ring.GetUsed() == 300 + 124 + 200);
+		CHECK(ring.GetOpenBytes() == 124 + 200);
+		ring.Close(3);
+
+		// Live range is [600, 1024) + [0, 200): the gap 200..600 is free, 450 is not
+		CHECK(ring.Allocate(450, 1) == kInvalid);
+		CHECK(ring.Allocate(400, 1) == 200);
+		ring.Close(4);
+		CHECK(ring.GetUsed() == 1024);
+
+		CHECK(ring.Retire(4) == 1024);
+		CHECK(ring.GetUsed() == 0);
+
+		// Empty again: restarts at 0 so the whole ring is usable
+		CHECK(ring.Allocate(1024, 1) == 0);
+		ring.Close(5);
+		ring.Retire(5);
+
+		// Alignment pushing past the end also wraps
+		ring.Allocate(1000, 1);
+		ring.Close(6);
+		ring.Retire(6);
+		CHECK(ring.Allocate(16, 256) == 0);
+	}
+
+	void TestExactEnd()
+	{
+		std::printf("allocation ending exactly at capacity\n");
+		UploadRingAllocator ring;
+		ring.Reset(512);
+		CHECK(ring.Allocate(256, 1) == 0);
+		ring.Close(1);
+		CHECK(ring.Allocate(256, 1) == 256);		// head lands on capacity -> 0, no tail burned
+		ring.Close(2);
+		CHECK(ring.GetUsed() == 512);
+		ring.Retire(1);
+		CHECK(ring.Allocate(256, 1) == 0);
+		CHECK(ring.GetUsed() == 512);
+	}
+
+	void TestOutOfOrderBatches()
+	{
+		std::printf("batches retire in close order\n");
+		UploadRingAllocator ring;
+		ring.Reset(1024);
+
+		// A dropped submission closes with the previous fence value; a later batch may
+		// therefore carry a smaller value than the one before it
+		ring.Allocate(100, 1);
+		ring.Close(5);
+		ring.Allocate(200, 1);
+		ring.Close(3);
+		ring.Allocate(300, 1);
+		ring.Close(6);
+
+		// 3 has passed but the batch in front (5) has not: nothing comes back yet,
+		// otherwise the live range would get a hole
+		CHECK(ring.Retire(3) == 0);
+		CHECK(ring.GetUsed() == 600);
+		CHECK(ring.GetOldestFence() == 5);
+
+		CHECK(ring.Retire(5) == 300);				// 5 and the 3 behind it
+		CHECK(ring.GetOldestFence() == 6);
+		CHECK(ring.Retire(6) == 300);
+		CHECK(ring.GetUsed() == 0);
+
+		// Equal values retire together
+		ring.Allocate(10, 1);
+		ring.Close(9);
+		ring.Allocate(10, 1);
+		ring.Close(9);
+		CHECK(ring.Retire(9) == 20);
+	}
+
+	void TestRingFull()
+	{
+		std::printf("full ring reports the oldest fence\n");
+		UploadRingAllocator ring;
+		ring.Reset(1024);
+		uint64_t copyFence = 0;
+		uint64_t completed = 0;
+		std::vector<uint64_t> waits;
+
+		// Four in-flight batches fill the ring; the GPU has finished none of them
+		for (int i = 0; i < 4; ++i)
+		{
+			CHECK(ring.Allocate(256, 256) == (uint64_t)i * 256);
+			ring.Close(++copyFence);
+		}
+		CHECK(ring.Allocate(1, 1) == kInvalid);
+		CHECK(ring.GetOldestFence() == 1);
+
+		// DXContext::AllocateUploadSpace: wait for the oldest batch, retire, retry
+		uint64_t offset = kInvalid;
+		while ((offset = ring.Allocate(512, 256)) == kInvalid)
+		{
+			const uint64_t oldest = ring.GetOldestFence();
+			CHECK(oldest != 0);
+			if (oldest == 0)
+			{
+				break;
+			}
+			waits.push_back(oldest);
+			completed = oldest;
+			ring.Retire(completed);
+		}
+		CHECK(offset == 0);
+		CHECK((waits == std::vector<uint64_t>{ 1, 2 }));
+
+		// An open batch has no fence yet: with nothing closed there is nothing to wait for
+		UploadRingAllocator open;
+		open.Reset(256);
+		CHECK(open.Allocate(200, 1) == 0);
+		CHECK(open.Allocate(100, 1) == kInvalid);
+		CHECK(open.GetOldestFence() == 0);
+		CHECK(open.GetOpenBytes() == 200);
+	}
+
+	void TestOversized()
+	{
+		std::printf("oversized request is rejected\n");
+		UploadRingAllocator ring;
+		ring.Reset(1024);
+		CHECK(ring.Allocate(1025, 1) == kInvalid);
+		CHECK(ring.GetUsed() == 0);
+		CHECK(ring.GetOpenBytes() == 0);
+		// The caller tells "retire and retry" from "one-off buffer" by the capacity
+		CHECK(1025 > ring.GetCapacity());
+
+		// A ring that never got a buffer rejects everything
+		UploadRingAllocator none;
+		CHECK(none.Allocate(1, 1) == kInvalid);
+	}
+
+	void TestSteadyStream()
+	{
+		std::printf("steady stream with the GPU two batches behind\n");
+		UploadRingAllocator ring;
+		ring.Reset(4096);
+		uint64_t copyFence = 0;
+		uint64_t completed = 0;
+		int stalls = 0;
+		const uint64_t sizes[] = { 700, 300, 1200, 64, 900, 256, 2000 };
+		for (int i = 0; i < 200; ++i)
+		{
+			if (copyFence > 2 && completed < copyFence - 2)
+			{
+				completed = copyFence - 2;
+			}
+			ring.Retire(completed);
+
+			const uint64_t size = sizes[i % 7];
+			uint64_t offset = kInvalid;
+			while ((offset = ring.Allocate(size, 256)) == kInvalid)
+			{
+				const uint64_t oldest = ring.GetOldestFence();
+				CHECK(oldest > completed);			// never asked to wait on something already done
+				if (oldest == 0)
+				{
+					break;
+				}
+				completed = oldest;
+				ring.Retire(completed);
+				++stalls;
+			}
+			CHECK(offset != kInvalid);
+			CHECK(offset % 256 == 0);
+			CHECK(offset + size <= ring.GetCapacity());
+			ring.Close(++copyFence);
+			CHECK(ring.GetUsed() <= ring.GetCapacity());
+		}
+		CHECK(stalls > 0);							// the 2000-byte batches do not fit behind two others
+		ring.Retire(copyFence);
+		CHECK(ring.GetUsed() == 0);
+		CHECK(ring.GetHighWater() <= ring.GetCapacity());
+	}
+}
+
+int main()
+{
+	TestBasicAlign();
+	TestWrapTail();
+	TestExactEnd();
+	TestOutOfOrderBatches();
+	TestRingFull();
+	TestOversized();
+	TestSteadyStream();
+
+	return TestCheck::Finish();
+}